@@ -0,0 +1,192 @@
+#include "BenchCompare.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <random>
+#include <sstream>
+
+namespace {
+
+// Larger samples (or any ties) use the normal approximation
+constexpr std::size_t kExactLimit = 30;
+
+double median(std::vector<double> values) {
+    const std::size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    if (values.size() % 2 == 1) {
+        return values[mid];
+    }
+    const double upper = values[mid];
+    return (*std::max_element(values.begin(), values.begin() + mid) + upper) / 2.0;
+}
+
+// Number of orderings of n1 + n2 distinct values for each U (pairs a > b), n1 = na, n2 = nb
+std::vector<double> exactCounts(std::size_t na, std::size_t nb) {
+    // counts[j][u] for i samples of a and j of b; the largest of the i + j values either
+    // comes from a (and beats all j values of b) or from b
+    std::vector<std::vector<double>> prev(nb + 1, std::vector<double>(1, 1.0));
+    for (std::size_t i = 1; i <= na; ++i) {
+        std::vector<std::vector<double>> cur(nb + 1);
+        cur[0].assign(1, 1.0);
+        for (std::size_t j = 1; j <= nb; ++j) {
+            cur[j].assign(i * j + 1, 0.0);
+            for (std::size_t u = 0; u <= i * j; ++u) {
+                double ways = 0.0;
+                if (u >= j && u - j < prev[j].size()) {
+                    ways += prev[j][u - j];
+                }
+                if (u < cur[j - 1].size()) {
+                    ways += cur[j - 1][u];
+                }
+                cur[j][u] = ways;
+            }
+        }
+        prev.swap(cur);
+    }
+    return prev[nb];
+}
+
+} // namespace
+
+double BenchCompare::mannWhitneyGreater(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.empty() || b.empty()) {
+        return 1.0;
+    }
+    double u = 0.0;
+    bool ties = false;
+    for (double x : a) {
+        for (double y : b) {
+            if (x > y) {
+                u += 1.0;
+            } else if (x == y) {
+                u += 0.5;
+                ties = true;
+            }
+        }
+    }
+
+    const std::size_t na = a.size();
+    const std::size_t nb = b.size();
+    if (!ties && na <= kExactLimit && nb <= kExactLimit) {
+        const std::vector<double> counts = exactCounts(na, nb);
+        double total = 0.0;
+        double tail = 0.0;
+        for (std::size_t k = 0; k < counts.size(); ++k) {
+            total += counts[k];
+            if (static_cast<double>(k) >= u) {
+                tail += counts[k];
+            }
+        }
+        return tail / total;
+    }
+
+    // Normal approximation with tie and continuity corrections
+    std::vector<double> pooled(a);
+    pooled.insert(pooled.end(), b.begin(), b.end());
+    std::sort(pooled.begin(), pooled.end());
+    double tieTerm = 0.0;
+    for (std::size_t i = 0; i < pooled.size();) {
+        std::size_t j = i;
+        while (j < pooled.size() && pooled[j] == pooled[i]) {
+            ++j;
+        }
+        const double t = static_cast<double>(j - i);
+        tieTerm += t * t * t - t;
+        i = j;
+    }
+    const double n = static_cast<double>(na + nb);
+    const double mean = na * nb / 2.0;
+    const double variance = na * nb / 12.0 * ((n + 1.0) - tieTerm / (n * (n - 1.0)));
+    if (variance <= 0.0) {
+        return u > mean ? 0.0 : 1.0;
+    }
+    const double z = (u - mean - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+void BenchCompare::bootstrapRatio(const std::vector<double>& baseline, const std::vector<double>& current,
+                                  double confidence, int resamples, double& low, double& high) {
+    low = high = 1.0;
+    if (baseline.empty() || current.empty() || resamples < 1) {
+        return;
+    }
+    std::mt19937_64 rng(0x5eedull);
+    std::uniform_int_distribution<std::size_t> pickBase(0, baseline.size() - 1);
+    std::uniform_int_distribution<std::size_t> pickCur(0, current.size() - 1);
+    std::vector<double> ratios;
+    ratios.reserve(resamples);
+    std::vector<double> base(baseline.size());
+    std::vector<double> cur(current.size());
+    for (int r = 0; r < resamples; ++r) {
+        for (double& v : base) {
+            v = baseline[pickBase(rng)];
+        }
+        for (double& v : cur) {
+            v = current[pickCur(rng)];
+        }
+        const double denominator = median(base);
+        ratios.push_back(denominator > 0.0 ? median(cur) / denominator : 1.0);
+    }
+    std::sort(ratios.begin(), ratios.end());
+    const double tail = std::clamp((1.0 - confidence) / 2.0, 0.0, 0.5);
+    low = ratios[static_cast<std::size_t>(std::floor(tail * (resamples - 1)))];
+    high = ratios[static_cast<std::size_t>(std::ceil((1.0 - tail) * (resamples - 1)))];
+}
+
+std::vector<BenchComparison> BenchCompare::compare(const std::vector<BenchResult>& baseline,
+                                                   const std::vector<BenchResult>& current, double alpha,
+                                                   double threshold) {
+    std::map<std::string, const BenchResult*> byKey;
+    for (const BenchResult& r : baseline) {
+        byKey[r.key()] = &r;
+    }
+
+    std::vector<BenchComparison> comparisons;
+    for (const BenchResult& r : current) {
+        const auto found = byKey.find(r.key());
+        if (found == byKey.end() || found->second->seconds.empty() || r.seconds.empty()) {
+            continue;
+        }
+        const BenchResult& base = *found->second;
+        BenchComparison c;
+        c.key = r.key();
+        c.baselineRuns = base.seconds.size();
+        c.currentRuns = r.seconds.size();
+        c.baselineMedian = median(base.seconds);
+        c.currentMedian = median(r.seconds);
+        c.ratio = c.baselineMedian > 0.0 ? c.currentMedian / c.baselineMedian : 1.0;
+        bootstrapRatio(base.seconds, r.seconds, 1.0 - alpha, 2000, c.ratioLow, c.ratioHigh);
+        c.pSlower = mannWhitneyGreater(r.seconds, base.seconds);
+        c.pFaster = mannWhitneyGreater(base.seconds, r.seconds);
+        if (c.pSlower < alpha && c.ratio > 1.0 + threshold) {
+            c.verdict = BenchComparison::Verdict::Slower;
+        } else if (c.pFaster < alpha && c.ratio < 1.0 / (1.0 + threshold)) {
+            c.verdict = BenchComparison::Verdict::Faster;
+        }
+        comparisons.push_back(c);
+    }
+    return comparisons;
+}
+
+void BenchCompare::printTable(const std::vector<BenchComparison>& comparisons, std::ostream& out) {
+    out << std::left << std::setw(64) << "case" << std::right << std::setw(11) << "base ms" << std::setw(11)
+        << "new ms" << std::setw(8) << "ratio" << std::setw(17) << "interval" << std::setw(10) << "p" << "  verdict\n";
+    out << std::fixed;
+    for (const BenchComparison& c : comparisons) {
+        const bool slower = c.ratio >= 1.0;
+        std::ostringstream interval;
+        interval << std::fixed << std::setprecision(2) << "[" << c.ratioLow << ", " << c.ratioHigh << "]";
+        out << std::left << std::setw(64) << c.key << std::right << std::setprecision(3) << std::setw(11)
+            << c.baselineMedian * 1e3 << std::setw(11) << c.currentMedian * 1e3 << std::setprecision(2)
+            << std::setw(8) << c.ratio << std::setw(17) << interval.str() << std::setprecision(4) << std::setw(10)
+            << (slower ? c.pSlower : c.pFaster) << "  "
+            << (c.verdict == BenchComparison::Verdict::Slower   ? "SLOWER"
+                : c.verdict == BenchComparison::Verdict::Faster ? "faster"
+                                                                : "ok")
+            << "\n";
+    }
+    out << std::defaultfloat;
+}
@@ -0,0 +1,76 @@
+#ifndef BENCH_COMPARE_H
+#define BENCH_COMPARE_H
+
+#include "BenchRunner.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One kernel's run times in a baseline and in the current run, and the verdict.
+ *
+ * ratio is the current median over the baseline median (above 1 = slower);
+ * [ratioLow, ratioHigh] is its bootstrap confidence interval.
+ */
+struct BenchComparison {
+    enum class Verdict { Unchanged, Slower, Faster };
+
+    std::string key;
+    std::size_t baselineRuns = 0;
+    std::size_t currentRuns = 0;
+    double baselineMedian = 0.0;
+    double currentMedian = 0.0;
+    double ratio = 1.0;
+    double ratioLow = 1.0;
+    double ratioHigh = 1.0;
+    double pSlower = 1.0;   ///< One-sided Mann-Whitney p-value for "current runs take longer"
+    double pFaster = 1.0;   ///< One-sided Mann-Whitney p-value for "current runs take less time"
+    Verdict verdict = Verdict::Unchanged;
+};
+
+/**
+ * @brief Statistical comparison of two benchmark runs, kernel by kernel.
+ *
+ * A kernel is reported Slower when the Mann-Whitney U test says its current run times
+ * are larger than the baseline's (p < alpha) and its median grew by more than the
+ * threshold fraction, so noise-level differences are not flagged even when they are
+ * statistically detectable. Faster is the mirror case. The test needs no assumption
+ * about the shape of the timing distribution; its p-value is exact when there are no
+ * ties and both samples are small, and uses the tie-corrected normal approximation
+ * otherwise.
+ */
+class BenchCompare {
+public:
+    /**
+     * @brief P(U >= observed U) under the null hypothesis, where U counts the pairs in
+     *        which a sample of `a` is larger than one of `b` (ties count half).
+     *
+     * Small p-values mean `a` tends to be larger than `b`. Returns 1 if either is empty.
+     */
+    static double mannWhitneyGreater(const std::vector<double>& a, const std::vector<double>& b);
+
+    /**
+     * @brief Percentile bootstrap interval of median(current) / median(baseline).
+     *
+     * Both samples are resampled with replacement `resamples` times with a fixed seed,
+     * so the interval is reproducible for given inputs.
+     */
+    static void bootstrapRatio(const std::vector<double>& baseline, const std::vector<double>& current,
+                               double confidence, int resamples, double& low, double& high);
+
+    /**
+     * @brief Compares the kernels present in both runs (matched by BenchResult::key()).
+     *
+     * @param alpha Significance level of the one-sided tests (the interval has
+     *              confidence 1 - alpha).
+     * @param threshold Smallest relative change in the median worth reporting, e.g. 0.1.
+     */
+    static std::vector<BenchComparison> compare(const std::vector<BenchResult>& baseline,
+                                                const std::vector<BenchResult>& current, double alpha,
+                                                double threshold);
+
+    static void printTable(const std::vector<BenchComparison>& comparisons, std::ostream& out);
+};
+
+#endif // BENCH_COMPARE_H
@@ -0,0 +1,316 @@
+#include "BenchRunner.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Just enough JSON to read back writeJson() documents (and hand-edited copies)
+struct JsonValue {
+    enum class Kind { Null, Bool, Number, String, Array, Object } kind = Kind::Null;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> fields;
+
+    const JsonValue& at(const std::string& name) const {
+        for (const auto& field : fields) {
+            if (field.first == name) {
+                return field.second;
+            }
+        }
+        throw std::runtime_error("missing field \"" + name + "\"");
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string source) : text(std::move(source)) {}
+
+    JsonValue document() {
+        JsonValue value = parseValue();
+        skipSpace();
+        if (pos != text.size()) {
+            fail("trailing characters");
+        }
+        return value;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("invalid JSON at offset " + std::to_string(pos) + ": " + what);
+    }
+
+    void skipSpace() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+        }
+    }
+
+    bool consume(char ch) {
+        skipSpace();
+        if (pos < text.size() && text[pos] == ch) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char ch) {
+        if (!consume(ch)) {
+            fail(std::string("expected '") + ch + "'");
+        }
+    }
+
+    std::string parseString() {
+        expect('"');
+        std::string out;
+        while (pos < text.size() && text[pos] != '"') {
+            char ch = text[pos++];
+            if (ch == '\\') {
+                if (pos >= text.size()) {
+                    break;
+                }
+                const char esc = text[pos++];
+                switch (esc) {
+                    case 'n': ch = '\n'; break;
+                    case 't': ch = '\t'; break;
+                    case 'r': ch = '\r'; break;
+                    case 'b': ch = '\b'; break;
+                    case 'f': ch = '\f'; break;
+                    case 'u':
+                        // Kernel names are ASCII; keep the low byte of \uXXXX escapes
+                        if (pos + 4 > text.size()) {
+                            fail("short \\u escape");
+                        }
+                        ch = static_cast<char>(std::stoi(text.substr(pos, 4), nullptr, 16) & 0xFF);
+                        pos += 4;
+                        break;
+                    default: ch = esc; break;
+                }
+            }
+            out += ch;
+        }
+        if (pos >= text.size()) {
+            fail("unterminated string");
+        }
+        ++pos;
+        return out;
+    }
+
+    JsonValue parseValue() {
+        skipSpace();
+        if (pos >= text.size()) {
+            fail("unexpected end");
+        }
+        JsonValue value;
+        const char ch = text[pos];
+        if (ch == '{') {
+            ++pos;
+            value.kind = JsonValue::Kind::Object;
+            if (!consume('}')) {
+                do {
+                    skipSpace();
+                    std::string name = parseString();
+                    expect(':');
+                    value.fields.emplace_back(std::move(name), parseValue());
+                } while (consume(','));
+                expect('}');
+            }
+        } else if (ch == '[') {
+            ++pos;
+            value.kind = JsonValue::Kind::Array;
+            if (!consume(']')) {
+                do {
+                    value.items.push_back(parseValue());
+                } while (consume(','));
+                expect(']');
+            }
+        } else if (ch == '"') {
+            value.kind = JsonValue::Kind::String;
+            value.text = parseString();
+        } else if (text.compare(pos, 4, "true") == 0 || text.compare(pos, 5, "false") == 0) {
+            value.kind = JsonValue::Kind::Bool;
+            value.number = (ch == 't') ? 1.0 : 0.0;
+            pos += (ch == 't') ? 4 : 5;
+        } else if (text.compare(pos, 4, "null") == 0) {
+            pos += 4;
+        } else {
+            const char* start = text.c_str() + pos;
+            char* end = nullptr;
+            value.kind = JsonValue::Kind::Number;
+            value.number = std::strtod(start, &end);
+            if (end == start) {
+                fail("unexpected character");
+            }
+            pos += static_cast<size_t>(end - start);
+        }
+        return value;
+    }
+
+    std::string text;
+    size_t pos = 0;
+};
+
+const JsonValue& expectKind(const JsonValue& value, JsonValue::Kind kind, const std::string& name) {
+    if (value.kind != kind) {
+        throw std::runtime_error("field \"" + name + "\" has the wrong type");
+    }
+    return value;
+}
+
+} // namespace
+
+/**
+ * @brief Linearly interpolated percentile (p in [0, 100]) of the run times.
+ */
+double BenchResult::percentile(double p) const {
+    if (seconds.empty()) {
+        return 0.0;
+    }
+    std::vector<double> sorted(seconds);
+    std::sort(sorted.begin(), sorted.end());
+    const double pos = std::clamp(p, 0.0, 100.0) / 100.0 * (sorted.size() - 1);
+    const size_t lo = static_cast<size_t>(std::floor(pos));
+    const size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - lo);
+}
+
+double BenchResult::mean() const {
+    if (seconds.empty()) {
+        return 0.0;
+    }
+    return std::accumulate(seconds.begin(), seconds.end(), 0.0) / seconds.size();
+}
+
+double BenchResult::megaItemsPerSecond() const {
+    const double t = percentile(50);
+    return t > 0.0 ? items / t / 1e6 : 0.0;
+}
+
+double BenchResult::gigaBytesPerSecond() const {
+    const double t = percentile(50);
+    return t > 0.0 ? bytes / t / 1e9 : 0.0;
+}
+
+BenchRunner::BenchRunner(int warmup, int runs, std::string filter)
+    : warmupRuns(std::max(0, warmup)), timedRuns(std::max(1, runs)), kernelFilter(std::move(filter)) {}
+
+bool BenchRunner::wants(const std::string& kernel) const {
+    return kernelFilter.empty() || kernel.find(kernelFilter) != std::string::npos;
+}
+
+void BenchRunner::run(const std::string& kernel, const std::string& variant, const std::string& shape,
+                      std::size_t items, std::size_t bytes, const std::function<void()>& setup,
+                      const std::function<void()>& body) {
+    if (!wants(kernel)) {
+        return;
+    }
+    BenchResult result;
+    result.kernel = kernel;
+    result.variant = variant;
+    result.shape = shape;
+    result.items = items;
+    result.bytes = bytes;
+
+    for (int i = 0; i < warmupRuns + timedRuns; ++i) {
+        if (setup) {
+            setup();
+        }
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        const auto stop = std::chrono::steady_clock::now();
+        if (i >= warmupRuns) {
+            result.seconds.push_back(std::chrono::duration<double>(stop - start).count());
+        }
+    }
+    std::cerr << "[Bench] " << result.key() << ": " << std::fixed << std::setprecision(3)
+              << result.percentile(50) * 1e3 << " ms" << std::defaultfloat << "\n";
+    measured.push_back(std::move(result));
+}
+
+void BenchRunner::printTable(const std::vector<BenchResult>& results, std::ostream& out) {
+    out << std::left << std::setw(42) << "kernel" << std::setw(14) << "variant" << std::setw(22) << "shape"
+        << std::right << std::setw(11) << "p50 ms" << std::setw(11) << "p90 ms" << std::setw(11) << "MP/s"
+        << std::setw(9) << "GB/s" << "\n";
+    out << std::fixed;
+    for (const BenchResult& r : results) {
+        out << std::left << std::setw(42) << r.kernel << std::setw(14) << r.variant << std::setw(22) << r.shape
+            << std::right << std::setprecision(3) << std::setw(11) << r.percentile(50) * 1e3 << std::setw(11)
+            << r.percentile(90) * 1e3 << std::setprecision(1) << std::setw(11) << r.megaItemsPerSecond()
+            << std::setprecision(2) << std::setw(9) << r.gigaBytesPerSecond() << "\n";
+    }
+    out << std::defaultfloat;
+}
+
+void BenchRunner::writeCsv(const std::vector<BenchResult>& results, std::ostream& out) {
+    out << "kernel,variant,shape,items,bytes,runs,min_s,p50_s,p90_s,p99_s,max_s,mean_s,mp_per_s,gb_per_s\n";
+    out << std::setprecision(9);
+    for (const BenchResult& r : results) {
+        out << r.kernel << ',' << r.variant << ',' << r.shape << ',' << r.items << ',' << r.bytes << ','
+            << r.seconds.size() << ',' << r.percentile(0) << ',' << r.percentile(50) << ',' << r.percentile(90) << ','
+            << r.percentile(99) << ',' << r.percentile(100) << ',' << r.mean() << ',' << r.megaItemsPerSecond() << ','
+            << r.gigaBytesPerSecond() << "\n";
+    }
+}
+
+/**
+ * @brief JSON document with the machine, the summary statistics and the raw run
+ *        times of every case (kernel names never need escaping).
+ */
+void BenchRunner::writeJson(const std::vector<BenchResult>& results, std::ostream& out) {
+    out << std::setprecision(9);
+    out << "{\n  \"threads\": " << std::thread::hardware_concurrency() << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"kernel\": \"" << r.kernel << "\", \"variant\": \"" << r.variant << "\", \"shape\": \""
+            << r.shape << "\", \"items\": " << r.items << ", \"bytes\": " << r.bytes
+            << ", \"p50_s\": " << r.percentile(50) << ", \"p90_s\": " << r.percentile(90)
+            << ", \"p99_s\": " << r.percentile(99) << ", \"mean_s\": " << r.mean()
+            << ", \"mp_per_s\": " << r.megaItemsPerSecond() << ", \"gb_per_s\": " << r.gigaBytesPerSecond()
+            << ", \"samples\": [";
+        for (size_t k = 0; k < r.seconds.size(); ++k) {
+            out << (k ? ", " : "") << r.seconds[k];
+        }
+        out << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+std::vector<BenchResult> BenchRunner::readJson(std::istream& in) {
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const JsonValue root = JsonParser(text).document();
+    if (root.kind != JsonValue::Kind::Object) {
+        throw std::runtime_error("benchmark results must be a JSON object");
+    }
+
+    std::vector<BenchResult> results;
+    for (const JsonValue& entry : expectKind(root.at("results"), JsonValue::Kind::Array, "results").items) {
+        if (entry.kind != JsonValue::Kind::Object) {
+            throw std::runtime_error("each result must be a JSON object");
+        }
+        BenchResult r;
+        r.kernel = expectKind(entry.at("kernel"), JsonValue::Kind::String, "kernel").text;
+        r.variant = expectKind(entry.at("variant"), JsonValue::Kind::String, "variant").text;
+        r.shape = expectKind(entry.at("shape"), JsonValue::Kind::String, "shape").text;
+        r.items = static_cast<std::size_t>(expectKind(entry.at("items"), JsonValue::Kind::Number, "items").number);
+        r.bytes = static_cast<std::size_t>(expectKind(entry.at("bytes"), JsonValue::Kind::Number, "bytes").number);
+        for (const JsonValue& sample : expectKind(entry.at("samples"), JsonValue::Kind::Array, "samples").items) {
+            r.seconds.push_back(expectKind(sample, JsonValue::Kind::Number, "samples").number);
+        }
+        results.push_back(std::move(r));
+    }
+    return results;
+}
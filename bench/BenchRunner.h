@@ -0,0 +1,66 @@
+#ifndef BENCH_RUNNER_H
+#define BENCH_RUNNER_H
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Timings of one kernel on one input.
+ *
+ * items is the number of pixels (2D) or voxels (3D) of the input, bytes the bytes the
+ * kernel reads plus writes once; throughput figures use the median run.
+ */
+struct BenchResult {
+    std::string kernel;    ///< e.g. "Filters2D::gaussianBlur"
+    std::string variant;   ///< parameters, e.g. "k5"
+    std::string shape;     ///< input size, e.g. "2048x2048x3" or "256^3 u8"
+    std::size_t items = 0;
+    std::size_t bytes = 0;
+    std::vector<double> seconds;  ///< one entry per measured run, in run order
+
+    std::string key() const { return kernel + " " + variant + " " + shape; }
+    double percentile(double p) const;
+    double mean() const;
+    double megaItemsPerSecond() const;
+    double gigaBytesPerSecond() const;
+};
+
+/**
+ * @brief Runs each benchmark case with warmup and repeated timed runs.
+ *
+ * setup() runs before every run, untimed (e.g. to restore an input the kernel
+ * modifies in place); only body() is timed, with a steady clock.
+ */
+class BenchRunner {
+public:
+    BenchRunner(int warmup, int runs, std::string filter);
+
+    void run(const std::string& kernel, const std::string& variant, const std::string& shape, std::size_t items,
+             std::size_t bytes, const std::function<void()>& setup, const std::function<void()>& body);
+
+    const std::vector<BenchResult>& results() const { return measured; }
+
+    static void printTable(const std::vector<BenchResult>& results, std::ostream& out);
+    static void writeCsv(const std::vector<BenchResult>& results, std::ostream& out);
+    static void writeJson(const std::vector<BenchResult>& results, std::ostream& out);
+
+    /**
+     * @brief Reads results written by writeJson() (the summary fields are recomputed
+     *        from the samples).
+     * @throws std::runtime_error If the document is not valid JSON or lacks a field.
+     */
+    static std::vector<BenchResult> readJson(std::istream& in);
+
+private:
+    bool wants(const std::string& kernel) const;
+
+    int warmupRuns;
+    int timedRuns;
+    std::string kernelFilter;
+    std::vector<BenchResult> measured;
+};
+
+#endif // BENCH_RUNNER_H
@@ -0,0 +1,345 @@
+/**
+ * @file main.cpp
+ * @brief APImageBench: throughput benchmarks of the Filters2D, Filters3D,
+ *        Projections3D and Slicing3D kernels on synthetic data.
+ *
+ * Usage: ./APImageBench [--quick | --full] [options]
+ *   --image-sizes <n,...>   image sizes in megapixels (1 MP = 1024x1024; default 1, --full 1,4,16,64)
+ *   --channels <n,...>      image channels (default 1,3,4)
+ *   --volume-sizes <n,...>  cube edge lengths (default 64, --full 64,128,256,512,1024)
+ *   --voxel-types <t,...>   u8, u16, f32 (default u8)
+ *   --warmup <n>            untimed runs per case (default 1)
+ *   --runs <n>              timed runs per case (default 5)
+ *   --filter <text>         only kernels whose name contains text, e.g. "Projections3D"
+ *   --csv <file>            write the results as CSV
+ *   --json <file>           write the results, with every run time, as JSON
+ *   --baseline <file>       compare with the results in a --json file and exit with 1 if a
+ *                           kernel got slower (the file is created if it does not exist)
+ *   --alpha <p>             significance level of the comparison (default 0.01)
+ *   --threshold <percent>   smallest slowdown of the median worth flagging (default 10)
+ *   --update-baseline       overwrite the baseline with this run after comparing
+ *
+ * Kernels run on in-memory buffers (no file I/O is timed); a summary table goes to
+ * stdout and progress to stderr.
+ */
+
+#include "BenchCompare.h"
+#include "BenchRunner.h"
+#include "Filters2D.h"
+#include "Filters3D.h"
+#include "Image.h"
+#include "Projections3D.h"
+#include "Slicing3D.h"
+#include "Volume.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+struct BenchOptions {
+    std::vector<int> imageSizes{ 1 };
+    std::vector<int> channels{ 1, 3, 4 };
+    std::vector<int> volumeSizes{ 64 };
+    std::vector<std::string> voxelTypes{ "u8" };
+    int warmup = 1;
+    int runs = 5;
+    std::string filter;
+    std::string csvPath;
+    std::string jsonPath;
+    std::string baselinePath;
+    double alpha = 0.01;
+    double threshold = 0.10;
+    bool updateBaseline = false;
+};
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> parts;
+    std::stringstream in(text);
+    std::string part;
+    while (std::getline(in, part, ',')) {
+        if (!part.empty()) {
+            parts.push_back(part);
+        }
+    }
+    return parts;
+}
+
+std::vector<int> intList(const std::string& text) {
+    std::vector<int> values;
+    for (const std::string& part : splitList(text)) {
+        values.push_back(std::max(1, std::atoi(part.c_str())));
+    }
+    return values;
+}
+
+BenchOptions parseOptions(int argc, char** argv) {
+    BenchOptions opts;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "ERROR: " << arg << " requires a value\n";
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "--quick") {
+            opts.imageSizes = { 1 };
+            opts.volumeSizes = { 64 };
+        } else if (arg == "--full") {
+            opts.imageSizes = { 1, 4, 16, 64 };
+            opts.volumeSizes = { 64, 128, 256, 512, 1024 };
+        } else if (arg == "--image-sizes") {
+            opts.imageSizes = intList(value());
+        } else if (arg == "--channels") {
+            opts.channels = intList(value());
+        } else if (arg == "--volume-sizes") {
+            opts.volumeSizes = intList(value());
+        } else if (arg == "--voxel-types") {
+            opts.voxelTypes = splitList(value());
+        } else if (arg == "--warmup") {
+            opts.warmup = std::atoi(value().c_str());
+        } else if (arg == "--runs") {
+            opts.runs = std::atoi(value().c_str());
+        } else if (arg == "--filter") {
+            opts.filter = value();
+        } else if (arg == "--csv") {
+            opts.csvPath = value();
+        } else if (arg == "--json") {
+            opts.jsonPath = value();
+        } else if (arg == "--baseline") {
+            opts.baselinePath = value();
+        } else if (arg == "--alpha") {
+            opts.alpha = std::atof(value().c_str());
+        } else if (arg == "--threshold") {
+            opts.threshold = std::max(0.0, std::atof(value().c_str()) / 100.0);
+        } else if (arg == "--update-baseline") {
+            opts.updateBaseline = true;
+        } else {
+            std::cerr << "ERROR: Unknown option " << arg << "\n";
+            std::exit(1);
+        }
+    }
+    return opts;
+}
+
+// Smooth gradients plus hashed noise, so sorting/histogram kernels see realistic data
+unsigned char patternValue(size_t i, int x, int y, int z) {
+    const unsigned hash = static_cast<unsigned>(i * 2654435761u) >> 27;
+    return static_cast<unsigned char>((x * 3 + y * 5 + z * 7 + hash) & 0xFF);
+}
+
+std::vector<unsigned char> syntheticImage(int w, int h, int c) {
+    std::vector<unsigned char> pixels(static_cast<size_t>(w) * h * c);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            for (int ch = 0; ch < c; ++ch) {
+                const size_t i = (static_cast<size_t>(y) * w + x) * c + ch;
+                pixels[i] = patternValue(i, x + ch * 17, y, 0);
+            }
+        }
+    }
+    return pixels;
+}
+
+template <typename T>
+BasicVolume<T> syntheticVolume(int n) {
+    BasicVolume<T> vol(n, n, n, 1);
+    size_t i = 0;
+    for (int z = 0; z < n; ++z) {
+        for (int y = 0; y < n; ++y) {
+            for (int x = 0; x < n; ++x, ++i) {
+                const unsigned char v = patternValue(i, x, y, z);
+                if constexpr (std::is_floating_point_v<T>) {
+                    vol.data[i] = v / 255.0f;
+                } else {
+                    vol.data[i] = static_cast<T>(v * (sizeof(T) == 1 ? 1 : 257));
+                }
+            }
+        }
+    }
+    return vol;
+}
+
+void benchImages(BenchRunner& bench, const BenchOptions& opts) {
+    for (int mp : opts.imageSizes) {
+        const int side = static_cast<int>(std::lround(1024.0 * std::sqrt(static_cast<double>(mp))));
+        for (int c : opts.channels) {
+            const std::vector<unsigned char> source = syntheticImage(side, side, c);
+            Image img(const_cast<unsigned char*>(source.data()), side, side, c);
+            Filters2D filters;
+            const std::string shape = std::to_string(side) + "x" + std::to_string(side) + "x" + std::to_string(c);
+            const size_t items = static_cast<size_t>(side) * side;
+            const size_t bytes = 2 * source.size();
+            auto reset = [&]() { img.setData(source.data(), side, side, c); };
+            auto add = [&](const std::string& kernel, const std::string& variant, auto body) {
+                bench.run(kernel, variant, shape, items, bytes, reset, body);
+            };
+
+            add("Filters2D::apply_Greyscale", "-", [&] { filters.apply_Greyscale(img); });
+            add("Filters2D::apply_Brightness", "+40", [&] { filters.apply_Brightness(img, 40); });
+            add("Filters2D::apply_Histogram_Equalisation", "HSV", [&] { filters.apply_Histogram_Equalisation(img, "HSV"); });
+            add("Filters2D::Threshold", "HSL128", [&] { filters.Threshold(img, 128, "HSL"); });
+            add("Filters2D::apply_Salt_and_Pepper_Noise", "10%", [&] { filters.apply_Salt_and_Pepper_Noise(img, 10.0f, 42); });
+            add("Filters2D::boxBlur", "k5", [&] { filters.boxBlur(img, 5); });
+            add("Filters2D::gaussianBlur", "k5", [&] { filters.gaussianBlur(img, 5, 2.0f); });
+            add("Filters2D::medianBlur", "k5", [&] { filters.medianBlur(img, 5); });
+            add("Filters2D::Sharpen", "1.0", [&] { filters.Sharpen(img, 1.0f); });
+            add("Filters2D::unsharpMask", "1.0r2", [&] { filters.unsharpMask(img, 1.0f, 2.0f, 0); });
+            for (const char* edge : { "Sobel", "Prewitt", "Scharr", "RobertsCross" }) {
+                add("Filters2D::DetectEdges", edge, [&] { filters.DetectEdges(img, filters.GetEdgeDetectorType(edge)); });
+            }
+            add("Filters2D::CannyEdges", "20/50", [&] { filters.CannyEdges(img, 20.0f, 50.0f); });
+        }
+    }
+}
+
+template <typename T>
+void benchVolume(BenchRunner& bench, int n, const std::string& typeName) {
+    const BasicVolume<T> source = syntheticVolume<T>(n);
+    BasicVolume<T> vol = source;
+    Filters3D filters;
+    const std::string shape = std::to_string(n) + "^3 " + typeName;
+    const size_t items = source.data.size();
+    const size_t volumeBytes = items * sizeof(T);
+    const size_t planeBytes = static_cast<size_t>(n) * n * sizeof(T);
+    auto reset = [&]() { vol.data = source.data; };
+    std::vector<T> out;
+    int w = 0;
+    int h = 0;
+
+    bench.run("Filters3D::apply3DGaussianBlur", "k3", shape, items, 2 * volumeBytes, reset,
+              [&] { filters.apply3DGaussianBlur(vol, 3, 1.0); });
+    bench.run("Filters3D::apply3DMedianBlur", "k3", shape, items, 2 * volumeBytes, reset,
+              [&] { filters.apply3DMedianBlur(vol, 3); });
+
+    for (const char* type : { "MIP", "MinIP", "AIP", "AIPMedian" }) {
+        for (ProjectionAxis axis : { ProjectionAxis::Z, ProjectionAxis::Y, ProjectionAxis::X }) {
+            const std::string variant = std::string(type) +
+                                        (axis == ProjectionAxis::Z ? "-z" : axis == ProjectionAxis::Y ? "-y" : "-x");
+            bench.run("Projections3D::project", variant, shape, items, volumeBytes + planeBytes, nullptr,
+                      [&] { Projections3D::project(source, type, -1, -1, out, w, h, axis); });
+        }
+    }
+
+    for (const char* plane : { "XY", "XZ", "YZ" }) {
+        bench.run("Slicing3D::extractSlice", plane, shape, static_cast<size_t>(n) * n, 2 * planeBytes, nullptr,
+                  [&] { Slicing3D::extractSlice(source, plane, n / 2, out, w, h); });
+    }
+
+    const double c = (n - 1) / 2.0;
+    const ObliquePlane plane = ObliquePlane::fromNormal({ c, c, c }, { 1.0, 1.0, 2.0 });
+    bench.run("Slicing3D::resliceOblique", "n112", shape, static_cast<size_t>(n) * n, 9 * planeBytes, nullptr,
+              [&] { Slicing3D::resliceOblique(source, plane, n, n, 1.0, out); });
+
+    const std::vector<Vec3> path = { { 0.1 * n, 0.2 * n, 0.1 * n }, { 0.5 * n, 0.6 * n, 0.5 * n },
+                                     { 0.8 * n, 0.4 * n, 0.9 * n } };
+    bench.run("Slicing3D::reformatCurved", "spline", shape, static_cast<size_t>(n) * n, 9 * planeBytes, nullptr,
+              [&] { Slicing3D::reformatCurved(source, path, n, 1.0, true, out); });
+}
+
+void benchVolumes(BenchRunner& bench, const BenchOptions& opts) {
+    for (int n : opts.volumeSizes) {
+        for (const std::string& type : opts.voxelTypes) {
+            if (type == "u16") {
+                benchVolume<std::uint16_t>(bench, n, type);
+            } else if (type == "f32") {
+                benchVolume<float>(bench, n, type);
+            } else {
+                benchVolume<unsigned char>(bench, n, "u8");
+            }
+        }
+    }
+}
+
+bool writeJsonFile(const std::vector<BenchResult>& results, const std::string& path) {
+    std::ofstream json(path);
+    BenchRunner::writeJson(results, json);
+    if (!json) {
+        std::cerr << "ERROR: Cannot write " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Exit code of --baseline: 1 if any kernel is significantly slower than in the baseline
+int compareWithBaseline(const std::vector<BenchResult>& results, const BenchOptions& opts) {
+    std::ifstream in(opts.baselinePath);
+    if (!in) {
+        std::cout << "[Perf] No baseline at " << opts.baselinePath << "; recording this run\n";
+        return writeJsonFile(results, opts.baselinePath) ? 0 : 1;
+    }
+    std::vector<BenchResult> baseline;
+    try {
+        baseline = BenchRunner::readJson(in);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "ERROR: " << opts.baselinePath << ": " << e.what() << "\n";
+        return 1;
+    }
+
+    const std::vector<BenchComparison> comparisons =
+        BenchCompare::compare(baseline, results, opts.alpha, opts.threshold);
+    std::cout << "\n";
+    BenchCompare::printTable(comparisons, std::cout);
+
+    int slower = 0;
+    bool underpowered = false;
+    for (const BenchComparison& c : comparisons) {
+        slower += (c.verdict == BenchComparison::Verdict::Slower) ? 1 : 0;
+        // Even fully separated samples cannot reach alpha: 1 / C(n1 + n2, n1) is the smallest p
+        double orderings = 1.0;
+        for (std::size_t k = 1; k <= c.currentRuns; ++k) {
+            orderings = orderings * (c.baselineRuns + k) / k;
+        }
+        underpowered = underpowered || 1.0 / orderings >= opts.alpha;
+    }
+    if (comparisons.empty()) {
+        std::cerr << "[WARN] No case of this run is in the baseline " << opts.baselinePath << "\n";
+    }
+    if (underpowered) {
+        std::cerr << "[WARN] Too few runs to reach alpha = " << opts.alpha << "; use more --runs\n";
+    }
+    std::cout << "[Perf] " << slower << " of " << comparisons.size() << " cases slower than the baseline (alpha "
+              << opts.alpha << ", threshold " << opts.threshold * 100.0 << "%)\n";
+
+    if (opts.updateBaseline && !writeJsonFile(results, opts.baselinePath)) {
+        return 1;
+    }
+    return slower > 0 ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const BenchOptions opts = parseOptions(argc, argv);
+    BenchRunner bench(opts.warmup, opts.runs, opts.filter);
+
+    benchImages(bench, opts);
+    benchVolumes(bench, opts);
+
+    BenchRunner::printTable(bench.results(), std::cout);
+    if (!opts.csvPath.empty()) {
+        std::ofstream csv(opts.csvPath);
+        BenchRunner::writeCsv(bench.results(), csv);
+        if (!csv) {
+            std::cerr << "ERROR: Cannot write " << opts.csvPath << "\n";
+            return 1;
+        }
+    }
+    if (!opts.jsonPath.empty() && !writeJsonFile(bench.results(), opts.jsonPath)) {
+        return 1;
+    }
+    if (!opts.baselinePath.empty()) {
+        return compareWithBaseline(bench.results(), opts);
+    }
+    return 0;
+}
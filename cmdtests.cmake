@@ -20,12 +20,21 @@ add_test(NAME EdgeSobel COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png
 add_test(NAME EdgePrewitt COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png --edge Prewitt ${OUTPUT_DIR}/edge2.png)
 add_test(NAME EdgeScharr COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png -e Scharr ${OUTPUT_DIR}/edge3.png)
 add_test(NAME EdgeRobertsCross COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png -e RobertsCross ${OUTPUT_DIR}/edge4.png)
+add_test(NAME EdgeCanny COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png -e Canny 20 50 ${OUTPUT_DIR}/edge5.png)
 add_test(NAME Sharpen1 COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png -p ${OUTPUT_DIR}/sharpen1.png)
 add_test(NAME Sharpen2 COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png --sharpen ${OUTPUT_DIR}/sharpen2.png)
+add_test(NAME Sharpen3 COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png -p 1.5 ${OUTPUT_DIR}/sharpen3.png)
+add_test(NAME Unsharp1 COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png -u 1.5 2 4 ${OUTPUT_DIR}/unsharp1.png)
 add_test(NAME SaltPepper5 COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png --saltpepper 5 ${OUTPUT_DIR}/saltpepper1.png)
 add_test(NAME SaltPepper75 COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png -n 75 ${OUTPUT_DIR}/saltpepper2.png)
+add_test(NAME SaltPepperSeed COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png --seed 42 -n 20 ${OUTPUT_DIR}/saltpepper3.png)
 add_test(NAME ThresholdHSV128 COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png --threshold 128 HSV ${OUTPUT_DIR}/threshold1.png)
 add_test(NAME ThresholdHSL64 COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png -t 64 HSL ${OUTPUT_DIR}/threshold2.png)
+add_test(NAME ResizeLanczos COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png --resize 33 17 Lanczos3 ${OUTPUT_DIR}/resize1.png)
+add_test(NAME ScaleHalf COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png --scale 0.5 -r Median 3 ${OUTPUT_DIR}/resize2.png)
+add_test(NAME PyramidLevel COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png --level 2 -e Sobel ${OUTPUT_DIR}/level1.png)
+add_test(NAME WriteJpeg COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png -g --quality 80 ${OUTPUT_DIR}/output1.jpg)
+add_test(NAME WritePngLevel COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png --png-level 9 --png-filter Paeth -g ${OUTPUT_DIR}/output2.png)
 add_test(NAME MultiFilter COMMAND APImageFilters
          -i ${SOURCE_DIR}/Images/small.png -b 100 -g -r gaussian 5 1.0 -e Sobel -s 75 -t 128 HSV ${OUTPUT_DIR}/multifilter.png)
 
@@ -43,12 +52,25 @@ set_tests_properties(EdgeSobel PROPERTIES TIMEOUT 10)
 set_tests_properties(EdgePrewitt PROPERTIES TIMEOUT 10)
 set_tests_properties(EdgeScharr PROPERTIES TIMEOUT 10)
 set_tests_properties(EdgeRobertsCross PROPERTIES TIMEOUT 10)
+set_tests_properties(EdgeCanny PROPERTIES TIMEOUT 10)
+# Thresholds belong to Canny; after another detector they are reported, not taken
+add_test(NAME EdgeSobelThresholdsIgnored COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png -e Sobel 20 50 ${OUTPUT_DIR}/edge6.png)
+set_tests_properties(EdgeSobelThresholdsIgnored PROPERTIES TIMEOUT 10
+                     PASS_REGULAR_EXPRESSION "Unrecognized token \"20\"")
 set_tests_properties(Sharpen1 PROPERTIES TIMEOUT 10)
 set_tests_properties(Sharpen2 PROPERTIES TIMEOUT 10)
+set_tests_properties(Sharpen3 PROPERTIES TIMEOUT 10)
+set_tests_properties(Unsharp1 PROPERTIES TIMEOUT 10)
 set_tests_properties(SaltPepper5 PROPERTIES TIMEOUT 10)
 set_tests_properties(SaltPepper75 PROPERTIES TIMEOUT 10)
+set_tests_properties(SaltPepperSeed PROPERTIES TIMEOUT 10)
 set_tests_properties(ThresholdHSV128 PROPERTIES TIMEOUT 10)
 set_tests_properties(ThresholdHSL64 PROPERTIES TIMEOUT 10)
+set_tests_properties(ResizeLanczos PROPERTIES TIMEOUT 10)
+set_tests_properties(ScaleHalf PROPERTIES TIMEOUT 10)
+set_tests_properties(PyramidLevel PROPERTIES TIMEOUT 10)
+set_tests_properties(WriteJpeg PROPERTIES TIMEOUT 10)
+set_tests_properties(WritePngLevel PROPERTIES TIMEOUT 10)
 set_tests_properties(MultiFilter PROPERTIES TIMEOUT 60)
 
 ### TEST CORE VOLUME PROCESSING FUNCTIONALITY ###
@@ -82,7 +104,68 @@ add_test(NAME ThinSlabSliceXZGaussian COMMAND APImageFilters
          -d ${SOURCE_DIR}/Scans/TestVolume/vol -f 4 -l 28 -r Gaussian 3 2.0-s XZ 16 ${OUTPUT_DIR}/sliceXZGaussianthinslab.png)
 add_test(NAME ThinSlabProjectMIPMedian COMMAND APImageFilters
          -d ${SOURCE_DIR}/Scans/TestVolume/vol --first 4 --last 28 -r Median 3 -p MIP ${OUTPUT_DIR}/projectionMIPMedianthinslab.png)
+add_test(NAME ProjectionMIPScaled COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume --scale 0.5 Bilinear -p MIP ${OUTPUT_DIR}/projectionMIPscaled.png)
+add_test(NAME ProjectionAIP16 COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume -p AIP --bit-depth 16 ${OUTPUT_DIR}/projectionAIP16.png)
+add_test(NAME ProjectionAIPFloat COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume --voxel-type float -r Median 3 -p AIP ${OUTPUT_DIR}/projectionAIPfloat.png)
+add_test(NAME ProjectionMIPAlongY COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume -p MIP y ${OUTPUT_DIR}/projectionMIPy.png)
+add_test(NAME SlidingSlabMIP COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume --slab MIP 8 4 ${OUTPUT_DIR}/slabMIP.png)
+add_test(NAME SliceBatchYZ COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume --slices YZ 0 47 4 ${OUTPUT_DIR}/sliceBatchYZ.png)
+add_test(NAME SliceCurved COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume --cpr ${SOURCE_DIR}/tests/cprPath.txt 40 0.5 ${OUTPUT_DIR}/sliceCurved.png)
+add_test(NAME SliceOblique COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume --oblique 24 20 16 1 0 1 64 64 0.75 ${OUTPUT_DIR}/sliceOblique.png)
+add_test(NAME RenderTurntableMIP COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume --frames 4 --render MIP 0 20 ${OUTPUT_DIR}/renderMIP.png)
+add_test(NAME RenderComposite COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume --transfer ${SOURCE_DIR}/tests/transfer.txt
+         --render Composite 35 25 96 80 0.5 ${OUTPUT_DIR}/renderComposite.png)
+add_test(NAME ProjectionMIPBrickCache COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume/vol --brick-cache -p MIP ${OUTPUT_DIR}/projectionMIPBrickCache.png)
+add_test(NAME VolumeCacheStore COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume --volume-cache ${OUTPUT_DIR}/volumeCache
+         -r Gaussian 5 1.5 -p MIP ${OUTPUT_DIR}/volumeCacheStore.png)
+add_test(NAME VolumeCacheReuse COMMAND APImageFilters
+         -d ${SOURCE_DIR}/Scans/TestVolume --volume-cache ${OUTPUT_DIR}/volumeCache
+         -r Gaussian 5 1.5 -s XZ 20 ${OUTPUT_DIR}/volumeCacheReuse.png)
 
+# "-" streams through stdin/stdout; a shell does the piping
+add_test(NAME TraceSummary COMMAND APImageFilters -i ${SOURCE_DIR}/Images/small.png --trace -g -r Box 3 ${OUTPUT_DIR}/traceSummary.png)
+set_tests_properties(TraceSummary PROPERTIES TIMEOUT 60
+                     PASS_REGULAR_EXPRESSION "\\[Trace\\] +blur Box.*\\[Trace\\] +total")
+
+if(UNIX)
+    add_test(NAME GreyscaleStdio COMMAND sh -c
+             "$<TARGET_FILE:APImageFilters> -i - -g - < ${SOURCE_DIR}/Images/small.png > ${OUTPUT_DIR}/greyscaleStdio.png && head -c 8 ${OUTPUT_DIR}/greyscaleStdio.png | grep -q PNG")
+    add_test(NAME ProjectionMIPStdout COMMAND sh -c
+             "$<TARGET_FILE:APImageFilters> -d ${SOURCE_DIR}/Scans/TestVolume -p MIP --format bmp - | head -c 2 | grep -q BM")
+    add_test(NAME TraceChromeJson COMMAND sh -c
+             "$<TARGET_FILE:APImageFilters> -d ${SOURCE_DIR}/Scans/TestVolume --trace ${OUTPUT_DIR}/trace.json -p MIP ${OUTPUT_DIR}/traceMIP.png && grep -q '\"name\":\"projection MIP\"' ${OUTPUT_DIR}/trace.json")
+    set_tests_properties(GreyscaleStdio ProjectionMIPStdout TraceChromeJson PROPERTIES TIMEOUT 60)
+
+    # Invalid requests must end with exit code 1 and an error, not an abort
+    add_test(NAME ResizeZeroRejected COMMAND sh -c
+             "$<TARGET_FILE:APImageFilters> -i ${SOURCE_DIR}/Images/small.png --resize 0 5 ${OUTPUT_DIR}/resizeZero.png; test $? -eq 1")
+    add_test(NAME ScaleZeroRejected COMMAND sh -c
+             "$<TARGET_FILE:APImageFilters> -d ${SOURCE_DIR}/Scans/TestVolume --scale 0 -p MIP ${OUTPUT_DIR}/scaleZero.png; test $? -eq 1")
+    add_test(NAME ObliqueUnwritableRejected COMMAND sh -c
+             "$<TARGET_FILE:APImageFilters> -d ${SOURCE_DIR}/Scans/TestVolume --oblique 24 20 16 0 0 1 32 32 ${OUTPUT_DIR}/no/such/dir/oblique.png; test $? -eq 1")
+    add_test(NAME CurvedZeroWidthRejected COMMAND sh -c
+             "$<TARGET_FILE:APImageFilters> -d ${SOURCE_DIR}/Scans/TestVolume --cpr ${SOURCE_DIR}/tests/cprPath.txt 0 ${OUTPUT_DIR}/curvedZero.png; test $? -eq 1")
+    add_test(NAME SeedInvalidRejected COMMAND sh -c
+             "$<TARGET_FILE:APImageFilters> -i ${SOURCE_DIR}/Images/small.png --seed 12abc -n 5 ${OUTPUT_DIR}/seedInvalid.png; test $? -eq 1")
+    add_test(NAME SeedNegativeRejected COMMAND sh -c
+             "$<TARGET_FILE:APImageFilters> -i ${SOURCE_DIR}/Images/small.png --seed -1 -n 5 ${OUTPUT_DIR}/seedNegative.png; test $? -eq 1")
+    add_test(NAME ImageUnwritableRejected COMMAND sh -c
+             "$<TARGET_FILE:APImageFilters> -i ${SOURCE_DIR}/Images/small.png -g ${OUTPUT_DIR}/no/such/dir/grey.png; test $? -eq 1")
+    set_tests_properties(ResizeZeroRejected ScaleZeroRejected ObliqueUnwritableRejected CurvedZeroWidthRejected
+                         ImageUnwritableRejected SeedInvalidRejected SeedNegativeRejected PROPERTIES TIMEOUT 10)
+endif()
 # Give these short timeouts, since the test volume is small
 set_tests_properties(SliceXZ PROPERTIES TIMEOUT 60)
 set_tests_properties(SliceYZ PROPERTIES TIMEOUT 60)
@@ -102,4 +185,17 @@ set_tests_properties(ThinSlabProjectionMIP PROPERTIES TIMEOUT 60)
 set_tests_properties(ThinSlabProjectionMinIP PROPERTIES TIMEOUT 60)
 set_tests_properties(ThinSlabSliceXZGaussian PROPERTIES TIMEOUT 120)
 set_tests_properties(ThinSlabProjectMIPMedian PROPERTIES TIMEOUT 120)
-
+set_tests_properties(ProjectionMIPScaled PROPERTIES TIMEOUT 60)
+set_tests_properties(ProjectionAIP16 PROPERTIES TIMEOUT 60)
+set_tests_properties(ProjectionAIPFloat PROPERTIES TIMEOUT 60)
+set_tests_properties(SliceOblique PROPERTIES TIMEOUT 60)
+set_tests_properties(SliceBatchYZ PROPERTIES TIMEOUT 60)
+set_tests_properties(SliceCurved PROPERTIES TIMEOUT 60)
+set_tests_properties(ProjectionMIPAlongY PROPERTIES TIMEOUT 60)
+set_tests_properties(SlidingSlabMIP PROPERTIES TIMEOUT 60)
+set_tests_properties(RenderTurntableMIP PROPERTIES TIMEOUT 60)
+set_tests_properties(RenderComposite PROPERTIES TIMEOUT 60)
+set_tests_properties(ProjectionMIPBrickCache PROPERTIES TIMEOUT 60)
+set_tests_properties(VolumeCacheStore PROPERTIES TIMEOUT 60)
+set_tests_properties(VolumeCacheReuse PROPERTIES TIMEOUT 60 DEPENDS VolumeCacheStore
+                     PASS_REGULAR_EXPRESSION "\\[Cache\\] hit")
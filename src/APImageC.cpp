@@ -0,0 +1,412 @@
+/*
+ * @file APImageC.cpp
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#include "APImageC.h"
+#include "Filters2D.h"
+#include "Filters3D.h"
+#include "Image.h"
+#include "Projections3D.h"
+#include "Slicing3D.h"
+#include "Volume.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+struct apimage_volume {
+    std::variant<Volume, Volume16, VolumeF> volume;
+};
+
+namespace {
+
+thread_local std::string lastError;
+
+apimage_status fail(apimage_status status, const std::string& message) {
+    lastError = message;
+    return status;
+}
+
+/**
+ * @brief Runs fn, turning the exceptions the kernels throw into status codes so none
+ *        crosses the C boundary.
+ */
+template <typename Fn>
+apimage_status guarded(Fn&& fn) {
+    try {
+        const apimage_status status = fn();
+        if (status == APIMAGE_OK) {
+            lastError.clear();
+        }
+        return status;
+    } catch (const std::invalid_argument& e) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, e.what());
+    } catch (const std::bad_alloc&) {
+        return fail(APIMAGE_ERROR_OUT_OF_MEMORY, "out of memory");
+    } catch (const std::exception& e) {
+        return fail(APIMAGE_ERROR_INTERNAL, e.what());
+    } catch (...) {
+        return fail(APIMAGE_ERROR_INTERNAL, "unknown error");
+    }
+}
+
+bool validImage(const apimage_image* image) {
+    return image && image->data && image->width > 0 && image->height > 0 && image->channels >= 1 &&
+           image->channels <= 4;
+}
+
+// Histogram equalisation and thresholding handle grey, RGB and RGBA images only
+bool colourKernelChannels(const apimage_image* image) {
+    return !image || image->channels != 2;
+}
+
+bool isOneOf(const char* value, std::initializer_list<const char*> names) {
+    if (!value) {
+        return false;
+    }
+    for (const char* name : names) {
+        if (std::strcmp(value, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Runs a Filters2D filter on the caller's pixels and copies the result back,
+ *        updating the channel count (never larger than before).
+ */
+template <typename Fn>
+apimage_status filterImage(apimage_image* image, Fn&& filter) {
+    if (!validImage(image)) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "image needs data, a positive size and 1-4 channels");
+    }
+    return guarded([&] {
+        Image img(image->data, image->width, image->height, image->channels);
+        Filters2D filters;
+        filter(filters, img);
+        const size_t bytes = static_cast<size_t>(img.getWidth()) * img.getHeight() * img.getChannels();
+        std::memcpy(image->data, img.getData(), bytes);
+        image->channels = img.getChannels();
+        return APIMAGE_OK;
+    });
+}
+
+/**
+ * @brief Copies a computed plane into the caller's buffer, or reports the size needed.
+ */
+template <typename T>
+apimage_status copyOut(const std::vector<T>& plane, void* out, size_t capacity) {
+    const size_t bytes = plane.size() * sizeof(T);
+    if (!out || capacity < bytes) {
+        return fail(APIMAGE_ERROR_BUFFER_TOO_SMALL, "output buffer needs " + std::to_string(bytes) + " bytes");
+    }
+    std::memcpy(out, plane.data(), bytes);
+    return APIMAGE_OK;
+}
+
+VoxelType toVoxelType(apimage_voxel_type type) {
+    switch (type) {
+        case APIMAGE_VOXEL_UINT8:   return VoxelType::UInt8;
+        case APIMAGE_VOXEL_UINT16:  return VoxelType::UInt16;
+        case APIMAGE_VOXEL_FLOAT32: return VoxelType::Float32;
+        default:                    return VoxelType::Auto;
+    }
+}
+
+template <typename T>
+apimage_voxel_type voxelTypeOf() {
+    if constexpr (std::is_same_v<T, unsigned char>) {
+        return APIMAGE_VOXEL_UINT8;
+    } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+        return APIMAGE_VOXEL_UINT16;
+    } else {
+        return APIMAGE_VOXEL_FLOAT32;
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+int apimage_abi_version(void) {
+    return APIMAGE_ABI_VERSION;
+}
+
+const char* apimage_last_error(void) {
+    return lastError.c_str();
+}
+
+apimage_status apimage_greyscale(apimage_image* image) {
+    return filterImage(image, [](Filters2D& f, Image& img) { f.apply_Greyscale(img); });
+}
+
+apimage_status apimage_brightness(apimage_image* image, int value) {
+    return filterImage(image, [&](Filters2D& f, Image& img) { f.apply_Brightness(img, value); });
+}
+
+apimage_status apimage_histogram_equalise(apimage_image* image, const char* space) {
+    if (!isOneOf(space, { "HSV", "HSL" })) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "colour space must be HSV or HSL");
+    }
+    if (!colourKernelChannels(image)) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "histogram equalisation needs 1, 3 or 4 channels");
+    }
+    return filterImage(image, [&](Filters2D& f, Image& img) { f.apply_Histogram_Equalisation(img, space); });
+}
+
+apimage_status apimage_threshold(apimage_image* image, int threshold, const char* space) {
+    if (!isOneOf(space, { "HSV", "HSL" })) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "colour space must be HSV or HSL");
+    }
+    if (!colourKernelChannels(image)) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "threshold needs 1, 3 or 4 channels");
+    }
+    return filterImage(image, [&](Filters2D& f, Image& img) { f.Threshold(img, threshold, space); });
+}
+
+apimage_status apimage_salt_and_pepper(apimage_image* image, float percent, unsigned long long seed) {
+    if (!(percent >= 0.0f && percent <= 100.0f)) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "noise percentage must be between 0 and 100");
+    }
+    return filterImage(image, [&](Filters2D& f, Image& img) {
+        f.apply_Salt_and_Pepper_Noise(img, percent, static_cast<std::uint64_t>(seed));
+    });
+}
+
+apimage_status apimage_blur(apimage_image* image, const char* type, int kernel_size, float sigma) {
+    if (!isOneOf(type, { "Box", "Gaussian", "Median" }) || kernel_size < 1) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "blur needs type Box, Gaussian or Median and a positive size");
+    }
+    const std::string name = type;
+    return filterImage(image, [&](Filters2D& f, Image& img) {
+        if (name == "Box") {
+            f.boxBlur(img, kernel_size);
+        } else if (name == "Gaussian") {
+            f.gaussianBlur(img, kernel_size, sigma);
+        } else {
+            f.medianBlur(img, kernel_size);
+        }
+    });
+}
+
+apimage_status apimage_sharpen(apimage_image* image, float strength) {
+    return filterImage(image, [&](Filters2D& f, Image& img) { f.Sharpen(img, strength); });
+}
+
+apimage_status apimage_unsharp_mask(apimage_image* image, float amount, float radius, int threshold) {
+    if (!(radius > 0.0f)) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "unsharp mask radius must be positive");
+    }
+    return filterImage(image, [&](Filters2D& f, Image& img) { f.unsharpMask(img, amount, radius, threshold); });
+}
+
+apimage_status apimage_detect_edges(apimage_image* image, const char* type, int l1_magnitude, float* orientation) {
+    if (!isOneOf(type, { "Sobel", "Prewitt", "Scharr", "RobertsCross", "Canny" })) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "unknown edge detector");
+    }
+    return filterImage(image, [&](Filters2D& f, Image& img) {
+        std::vector<float> angles;
+        f.DetectEdges(img, f.GetEdgeDetectorType(type), l1_magnitude ? EdgeMagnitude::L1 : EdgeMagnitude::Euclidean,
+                      orientation ? &angles : nullptr);
+        if (orientation && !angles.empty()) {
+            std::memcpy(orientation, angles.data(), angles.size() * sizeof(float));
+        }
+    });
+}
+
+apimage_status apimage_canny_edges(apimage_image* image, float low_threshold, float high_threshold) {
+    if (low_threshold > high_threshold) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "Canny low threshold is above the high threshold");
+    }
+    return filterImage(image, [&](Filters2D& f, Image& img) { f.CannyEdges(img, low_threshold, high_threshold); });
+}
+
+apimage_status apimage_volume_create(apimage_voxel_type type, int width, int height, int depth, int channels,
+                                     apimage_volume** volume) {
+    if (!volume || width <= 0 || height <= 0 || depth <= 0 || channels <= 0) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "volume needs an output pointer and a positive size");
+    }
+    *volume = nullptr;
+    if (type != APIMAGE_VOXEL_UINT8 && type != APIMAGE_VOXEL_UINT16 && type != APIMAGE_VOXEL_FLOAT32) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "volume type must be UINT8, UINT16 or FLOAT32");
+    }
+    return guarded([&] {
+        auto handle = std::make_unique<apimage_volume>();
+        switch (type) {
+            case APIMAGE_VOXEL_UINT16:  handle->volume = Volume16(width, height, depth, channels); break;
+            case APIMAGE_VOXEL_FLOAT32: handle->volume = VolumeF(width, height, depth, channels); break;
+            default:                    handle->volume = Volume(width, height, depth, channels); break;
+        }
+        *volume = handle.release();
+        return APIMAGE_OK;
+    });
+}
+
+apimage_status apimage_volume_load(const char* folder, apimage_voxel_type type, int first, int last, int channels,
+                                   apimage_volume** volume) {
+    if (!folder || !volume || channels < 0 || channels > 4) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "load needs a folder, an output pointer and 0-4 channels");
+    }
+    *volume = nullptr;
+    return guarded([&] {
+        VoxelType voxels = toVoxelType(type);
+        if (voxels == VoxelType::Auto) {
+            voxels = probeVoxelType(folder, std::max(first, 1), last);
+        }
+        auto handle = std::make_unique<apimage_volume>();
+        bool loaded = false;
+        std::string reason;
+        auto fill = [&](auto vol) {
+            vol.firstSlice = std::max(first, 1);
+            vol.lastSlice = last;
+            vol.channels = channels;
+            loaded = vol.loadVolumeFromSlices(folder, &reason);
+            handle->volume = std::move(vol);
+        };
+        switch (voxels) {
+            case VoxelType::UInt16:  fill(Volume16()); break;
+            case VoxelType::Float32: fill(VolumeF()); break;
+            default:                 fill(Volume()); break;
+        }
+        if (!loaded) {
+            return fail(APIMAGE_ERROR_IO, std::string("failed to load volume from ") + folder + ": " + reason);
+        }
+        *volume = handle.release();
+        return APIMAGE_OK;
+    });
+}
+
+void apimage_volume_free(apimage_volume* volume) {
+    delete volume;
+}
+
+void* apimage_volume_data(apimage_volume* volume) {
+    if (!volume) {
+        return nullptr;
+    }
+    return std::visit([](auto& vol) -> void* { return vol.data.data(); }, volume->volume);
+}
+
+apimage_status apimage_volume_info(const apimage_volume* volume, apimage_voxel_type* type, int* width, int* height,
+                                   int* depth, int* channels) {
+    if (!volume) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "no volume");
+    }
+    std::visit([&](const auto& vol) {
+        using T = typename std::decay_t<decltype(vol)>::value_type;
+        if (type) *type = voxelTypeOf<T>();
+        if (width) *width = vol.width;
+        if (height) *height = vol.height;
+        if (depth) *depth = vol.depth;
+        if (channels) *channels = vol.channels;
+    }, volume->volume);
+    lastError.clear();
+    return APIMAGE_OK;
+}
+
+apimage_status apimage_volume_blur(apimage_volume* volume, const char* type, int kernel_size, float sigma) {
+    if (!volume || !isOneOf(type, { "Gaussian", "Median" }) || kernel_size < 1) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "3D blur needs a volume, type Gaussian or Median and a positive size");
+    }
+    return guarded([&] {
+        Filters3D filters;
+        std::visit([&](auto& vol) { filters.apply3DBlur(vol, type, static_cast<float>(kernel_size), sigma); },
+                   volume->volume);
+        return APIMAGE_OK;
+    });
+}
+
+apimage_status apimage_project(const apimage_volume* volume, const char* type, char axis, int first, int last,
+                               void* out, size_t capacity, int* out_width, int* out_height) {
+    if (!volume || !type || (axis != 'x' && axis != 'y' && axis != 'z' && axis != 'X' && axis != 'Y' && axis != 'Z')) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "projection needs a volume, a type and axis x, y or z");
+    }
+    const ProjectionAxis projAxis = (axis == 'x' || axis == 'X') ? ProjectionAxis::X
+                                    : (axis == 'y' || axis == 'Y') ? ProjectionAxis::Y
+                                                                    : ProjectionAxis::Z;
+    return guarded([&] {
+        return std::visit([&](const auto& vol) {
+            using T = typename std::decay_t<decltype(vol)>::value_type;
+            std::vector<T> plane;
+            int w = 0;
+            int h = 0;
+            Projections3D::project(vol, type, first, last, plane, w, h, projAxis);
+            if (out_width) *out_width = w;
+            if (out_height) *out_height = h;
+            return copyOut(plane, out, capacity);
+        }, volume->volume);
+    });
+}
+
+apimage_status apimage_slice(const apimage_volume* volume, const char* plane, int index, void* out, size_t capacity,
+                             int* out_width, int* out_height) {
+    if (!volume || !plane) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "slice needs a volume and a plane");
+    }
+    return guarded([&] {
+        return std::visit([&](const auto& vol) {
+            using T = typename std::decay_t<decltype(vol)>::value_type;
+            std::vector<T> slice;
+            int w = 0;
+            int h = 0;
+            Slicing3D::extractSlice(vol, plane, index, slice, w, h);
+            if (out_width) *out_width = w;
+            if (out_height) *out_height = h;
+            return copyOut(slice, out, capacity);
+        }, volume->volume);
+    });
+}
+
+apimage_status apimage_slice_oblique(const apimage_volume* volume, const double point[3], const double normal[3],
+                                     int out_width, int out_height, double spacing, void* out, size_t capacity) {
+    if (!volume || !point || !normal) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "oblique slice needs a volume, a point and a normal");
+    }
+    return guarded([&] {
+        const ObliquePlane plane = ObliquePlane::fromNormal({ point[0], point[1], point[2] },
+                                                            { normal[0], normal[1], normal[2] });
+        return std::visit([&](const auto& vol) {
+            using T = typename std::decay_t<decltype(vol)>::value_type;
+            std::vector<T> samples;
+            Slicing3D::resliceOblique(vol, plane, out_width, out_height, spacing, samples);
+            return copyOut(samples, out, capacity);
+        }, volume->volume);
+    });
+}
+
+apimage_status apimage_reformat_curved(const apimage_volume* volume, const double* points, int count, int out_width,
+                                       double spacing, int spline, void* out, size_t capacity, int* out_height) {
+    if (!volume || !points || count < 0) {
+        return fail(APIMAGE_ERROR_INVALID_ARGUMENT, "curved reformation needs a volume and centreline points");
+    }
+    return guarded([&] {
+        std::vector<Vec3> path(count);
+        for (int i = 0; i < count; ++i) {
+            path[i] = { points[3 * i], points[3 * i + 1], points[3 * i + 2] };
+        }
+        return std::visit([&](const auto& vol) {
+            using T = typename std::decay_t<decltype(vol)>::value_type;
+            std::vector<T> samples;
+            const int rows = Slicing3D::reformatCurved(vol, path, out_width, spacing, spline != 0, samples);
+            if (out_height) *out_height = rows;
+            return copyOut(samples, out, capacity);
+        }, volume->volume);
+    });
+}
+
+} // extern "C"
@@ -0,0 +1,177 @@
+/*
+ * @file APImageC.h
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+/**
+ * @brief C interface of the image and volume kernels, built as the shared library
+ *        libapimage for use from C, Python (ctypes/cffi) and other languages.
+ *
+ * Every call works on memory owned by the caller or by an opaque handle; nothing is
+ * read from or written to disk except by apimage_volume_load(). No call throws or exits
+ * the process: failures return an apimage_status and apimage_last_error() describes
+ * the most recent failure on the calling thread.
+ *
+ * 2D images are tightly packed, interleaved 8-bit pixels (row-major, channels per
+ * pixel). Filters run in place; greyscale and edge filters shrink the image to one
+ * channel and update image->channels.
+ *
+ * Volumes live in an apimage_volume handle. apimage_volume_data() exposes its voxel
+ * storage, laid out as data[((z * height + y) * width + x) * channels + c], so callers
+ * can fill or read it directly. Calls that produce a plane copy it into a caller
+ * buffer of `capacity` bytes with the volume's voxel type; passing a NULL buffer (or
+ * one that is too small) returns APIMAGE_ERROR_BUFFER_TOO_SMALL with the output size
+ * filled in, so the caller can allocate and call again.
+ *
+ * Type names are the command line's: "Box"/"Gaussian"/"Median" blurs, "Sobel",
+ * "Prewitt", "Scharr", "RobertsCross" and "Canny" edges, "HSV"/"HSL" colour spaces,
+ * "MIP"/"MinIP"/"AIP"/"AIPMedian" projections and "XY"/"XZ"/"YZ" planes.
+ */
+
+#ifndef APIMAGE_C_H
+#define APIMAGE_C_H
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#  if defined(APIMAGE_BUILDING_LIBRARY)
+#    define APIMAGE_API __declspec(dllexport)
+#  else
+#    define APIMAGE_API __declspec(dllimport)
+#  endif
+#else
+#  define APIMAGE_API __attribute__((visibility("default")))
+#endif
+
+/* Bumped whenever a declaration below changes incompatibly */
+#define APIMAGE_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum apimage_status {
+    APIMAGE_OK = 0,
+    APIMAGE_ERROR_INVALID_ARGUMENT = 1,  /* bad pointer, size, index or type name */
+    APIMAGE_ERROR_BUFFER_TOO_SMALL = 2,  /* output sizes were filled in; call again */
+    APIMAGE_ERROR_IO = 3,                /* slices could not be read */
+    APIMAGE_ERROR_OUT_OF_MEMORY = 4,
+    APIMAGE_ERROR_INTERNAL = 5
+} apimage_status;
+
+typedef enum apimage_voxel_type {
+    APIMAGE_VOXEL_AUTO = 0,     /* apimage_volume_load only: 16-bit slices -> UINT16, else UINT8 */
+    APIMAGE_VOXEL_UINT8 = 1,
+    APIMAGE_VOXEL_UINT16 = 2,
+    APIMAGE_VOXEL_FLOAT32 = 3   /* intensities normalised to [0, 1] */
+} apimage_voxel_type;
+
+/* A caller-owned 8-bit image, width * height * channels bytes at data */
+typedef struct apimage_image {
+    unsigned char* data;
+    int width;
+    int height;
+    int channels;
+} apimage_image;
+
+typedef struct apimage_volume apimage_volume;
+
+/** @brief APIMAGE_ABI_VERSION of the loaded library. */
+APIMAGE_API int apimage_abi_version(void);
+
+/** @brief Message of the last failed call on this thread ("" if none). */
+APIMAGE_API const char* apimage_last_error(void);
+
+/* ---- 2D filters (in place) ---- */
+
+APIMAGE_API apimage_status apimage_greyscale(apimage_image* image);
+APIMAGE_API apimage_status apimage_brightness(apimage_image* image, int value);
+/* Histogram equalisation and threshold accept 1, 3 or 4 channels (alpha is kept) */
+APIMAGE_API apimage_status apimage_histogram_equalise(apimage_image* image, const char* space);
+APIMAGE_API apimage_status apimage_threshold(apimage_image* image, int threshold, const char* space);
+
+/** @brief Salt and pepper noise on `percent` % of the pixels, reproducible for a given seed. */
+APIMAGE_API apimage_status apimage_salt_and_pepper(apimage_image* image, float percent, unsigned long long seed);
+
+/** @brief Box, Gaussian or Median blur; sigma is only used by Gaussian. */
+APIMAGE_API apimage_status apimage_blur(apimage_image* image, const char* type, int kernel_size, float sigma);
+
+APIMAGE_API apimage_status apimage_sharpen(apimage_image* image, float strength);
+APIMAGE_API apimage_status apimage_unsharp_mask(apimage_image* image, float amount, float radius, int threshold);
+
+/**
+ * @brief Edge magnitude as a single-channel image.
+ * @param orientation If not NULL, receives width * height gradient directions in radians
+ *                    (left untouched by Canny).
+ */
+APIMAGE_API apimage_status apimage_detect_edges(apimage_image* image, const char* type, int l1_magnitude,
+                                                float* orientation);
+
+APIMAGE_API apimage_status apimage_canny_edges(apimage_image* image, float low_threshold, float high_threshold);
+
+/* ---- Volumes ---- */
+
+/** @brief A zero-filled volume of the given type (not AUTO) and size. */
+APIMAGE_API apimage_status apimage_volume_create(apimage_voxel_type type, int width, int height, int depth,
+                                                 int channels, apimage_volume** volume);
+
+/**
+ * @brief Loads slices first..last (1-based; last = -1 for all) of a folder.
+ * @param channels Channels to keep per voxel (0 = as stored).
+ */
+APIMAGE_API apimage_status apimage_volume_load(const char* folder, apimage_voxel_type type, int first, int last,
+                                               int channels, apimage_volume** volume);
+
+APIMAGE_API void apimage_volume_free(apimage_volume* volume);
+
+/** @brief The voxel storage (width * height * depth * channels voxels), or NULL. */
+APIMAGE_API void* apimage_volume_data(apimage_volume* volume);
+
+/** @brief Any of the output pointers may be NULL. */
+APIMAGE_API apimage_status apimage_volume_info(const apimage_volume* volume, apimage_voxel_type* type, int* width,
+                                               int* height, int* depth, int* channels);
+
+/** @brief Gaussian or Median 3D blur, in place; sigma is only used by Gaussian. */
+APIMAGE_API apimage_status apimage_volume_blur(apimage_volume* volume, const char* type, int kernel_size,
+                                               float sigma);
+
+/**
+ * @brief Projection along axis 'x', 'y' or 'z' (slab first..last along that axis,
+ *        0-based, -1 for the whole axis), oriented as the command line writes it.
+ */
+APIMAGE_API apimage_status apimage_project(const apimage_volume* volume, const char* type, char axis, int first,
+                                           int last, void* out, size_t capacity, int* out_width, int* out_height);
+
+/** @brief Axis-aligned slice at index (0-based) along the plane's normal. */
+APIMAGE_API apimage_status apimage_slice(const apimage_volume* volume, const char* plane, int index, void* out,
+                                         size_t capacity, int* out_width, int* out_height);
+
+/**
+ * @brief Trilinear reslice on the plane through point (x, y, z) with the given normal,
+ *        out_width x out_height pixels `spacing` voxels apart.
+ */
+APIMAGE_API apimage_status apimage_slice_oblique(const apimage_volume* volume, const double point[3],
+                                                 const double normal[3], int out_width, int out_height,
+                                                 double spacing, void* out, size_t capacity);
+
+/**
+ * @brief Straightened curved reformation along `count` centreline points
+ *        (x, y, z triples); out_height receives the number of rows.
+ */
+APIMAGE_API apimage_status apimage_reformat_curved(const apimage_volume* volume, const double* points, int count,
+                                                   int out_width, double spacing, int spline, void* out,
+                                                   size_t capacity, int* out_height);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APIMAGE_C_H */
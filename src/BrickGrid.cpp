@@ -0,0 +1,262 @@
+/*
+ * @file BrickGrid.cpp
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#include "BrickGrid.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <sys/stat.h>
+
+namespace {
+
+constexpr char kMagic[8] = { 'A', 'P', 'B', 'R', 'I', 'C', 'K', '1' };
+
+template <typename T>
+const char* typeTag() {
+    if constexpr (std::is_same_v<T, unsigned char>) {
+        return "u8";
+    } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+        return "u16";
+    } else {
+        return "f32";
+    }
+}
+
+/**
+ * @brief Cache file for a dataset: inside the folder, or next to it for a folder/prefix path.
+ */
+std::string cachePath(const std::string& folderPath, const std::string& key) {
+    struct stat sb;
+    if (stat(folderPath.c_str(), &sb) == 0 && S_ISDIR(sb.st_mode)) {
+        std::string dir = folderPath;
+        if (dir.back() != '/' && dir.back() != '\\') {
+            dir += "/";
+        }
+        return dir + ".bricks-" + key + ".bin";
+    }
+    return folderPath + ".bricks-" + key + ".bin";
+}
+
+} // namespace
+
+/**
+ * @brief Scans each brick (plus its one-voxel apron) for its min, max and mean.
+ *
+ * Bands of z bricks are independent, so they run in parallel; a voxel row of a brick
+ * is contiguous, which keeps the scan streaming even though the aprons overlap.
+ */
+template <typename T>
+BrickGrid::BrickGrid(const BasicVolume<T>& vol, int size) : brick(size) {
+    if (size < 2) {
+        throw std::invalid_argument("Brick size must be at least 2");
+    }
+    if (vol.width <= 0 || vol.height <= 0 || vol.depth <= 0 || vol.channels <= 0 ||
+        vol.data.size() < static_cast<size_t>(vol.width) * vol.height * vol.depth * vol.channels) {
+        throw std::invalid_argument("Brick grid needs a non-empty volume");
+    }
+
+    width = vol.width;
+    height = vol.height;
+    depth = vol.depth;
+    nx = (vol.width + size - 1) / size;
+    ny = (vol.height + size - 1) / size;
+    nz = (vol.depth + size - 1) / size;
+    mins.assign(static_cast<size_t>(nx) * ny * nz, 0.0f);
+    maxs.assign(mins.size(), 0.0f);
+    means.assign(mins.size(), 0.0f);
+
+    const int channels = vol.channels;
+    const size_t rowLen = static_cast<size_t>(vol.width) * channels;
+    const size_t sliceLen = rowLen * vol.height;
+    Parallel::forBands(0, nz, [&](int bzBegin, int bzEnd) {
+        for (int bz = bzBegin; bz < bzEnd; ++bz) {
+            const int z0 = bz * size, z1 = std::min(z0 + size, vol.depth - 1);
+            for (int by = 0; by < ny; ++by) {
+                const int y0 = by * size, y1 = std::min(y0 + size, vol.height - 1);
+                for (int bx = 0; bx < nx; ++bx) {
+                    const int x0 = bx * size, x1 = std::min(x0 + size, vol.width - 1);
+                    const size_t ownedEnd = static_cast<size_t>(std::min(x0 + size, vol.width)) * channels;
+                    T mn = std::numeric_limits<T>::max();
+                    T mx = std::numeric_limits<T>::lowest();
+                    double sum = 0.0;
+                    size_t count = 0;
+                    for (int z = z0; z <= z1; ++z) {
+                        for (int y = y0; y <= y1; ++y) {
+                            const T* row = vol.data.data() + z * sliceLen + y * rowLen;
+                            const bool owned = z < z0 + size && y < y0 + size;
+                            for (size_t i = static_cast<size_t>(x0) * channels; i < static_cast<size_t>(x1 + 1) * channels; ++i) {
+                                mn = std::min(mn, row[i]);
+                                mx = std::max(mx, row[i]);
+                                if (owned && i < ownedEnd) {
+                                    sum += row[i];
+                                    ++count;
+                                }
+                            }
+                        }
+                    }
+                    mins[index(bx, by, bz)] = static_cast<float>(mn);
+                    maxs[index(bx, by, bz)] = static_cast<float>(mx);
+                    means[index(bx, by, bz)] = static_cast<float>(sum / count);
+                }
+            }
+        }
+    }, 1);
+
+    lo = *std::min_element(mins.begin(), mins.end());
+    hi = *std::max_element(maxs.begin(), maxs.end());
+}
+
+/**
+ * @brief Loads the grid cached for this dataset, or builds and caches it.
+ */
+template <typename T>
+BrickGrid BrickGrid::cached(const BasicVolume<T>& vol, const std::string& folderPath, int size) {
+    const std::string key = std::string(typeTag<T>()) + "-" + std::to_string(vol.firstSlice) + "-" +
+                            std::to_string(vol.lastSlice) + "-c" + std::to_string(vol.channels) + "-b" +
+                            std::to_string(size);
+    const std::string path = cachePath(folderPath, key);
+    const std::uint64_t current = sliceStamp(folderPath, vol.firstSlice, vol.lastSlice);
+
+    try {
+        BrickGrid grid = load(path);
+        if (grid.stamp == current && grid.size() == size && grid.covers(vol)) {
+            return grid;
+        }
+    } catch (const std::exception&) {
+        // Missing or unreadable: rebuild below
+    }
+
+    BrickGrid grid(vol, size);
+    grid.stamp = current;
+    try {
+        grid.save(path);
+    } catch (const std::exception& e) {
+        std::cerr << "[WARN] Brick cache not written: " << e.what() << "\n";
+    }
+    return grid;
+}
+
+/**
+ * @brief Writes the header (magic, sizes, stamp, range) and the three float arrays.
+ */
+void BrickGrid::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot write brick grid " + path);
+    }
+    const std::int32_t header[7] = { brick, width, height, depth, nx, ny, nz };
+    out.write(kMagic, sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(&stamp), sizeof(stamp));
+    out.write(reinterpret_cast<const char*>(&lo), sizeof(lo));
+    out.write(reinterpret_cast<const char*>(&hi), sizeof(hi));
+    for (const std::vector<float>* values : { &mins, &maxs, &means }) {
+        out.write(reinterpret_cast<const char*>(values->data()), values->size() * sizeof(float));
+    }
+    if (!out) {
+        throw std::runtime_error("Failed writing brick grid " + path);
+    }
+}
+
+/**
+ * @brief Reads a grid written by save(), checking the magic and the array sizes.
+ */
+BrickGrid BrickGrid::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open brick grid " + path);
+    }
+    char magic[sizeof(kMagic)];
+    std::int32_t header[7];
+    BrickGrid grid;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    in.read(reinterpret_cast<char*>(&grid.stamp), sizeof(grid.stamp));
+    in.read(reinterpret_cast<char*>(&grid.lo), sizeof(grid.lo));
+    in.read(reinterpret_cast<char*>(&grid.hi), sizeof(grid.hi));
+    if (!in || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error(path + " is not a brick grid");
+    }
+    grid.brick = header[0];
+    grid.width = header[1];
+    grid.height = header[2];
+    grid.depth = header[3];
+    grid.nx = header[4];
+    grid.ny = header[5];
+    grid.nz = header[6];
+    if (grid.brick < 2 || grid.width <= 0 || grid.height <= 0 || grid.depth <= 0 ||
+        grid.nx != (grid.width + grid.brick - 1) / grid.brick || grid.ny != (grid.height + grid.brick - 1) / grid.brick ||
+        grid.nz != (grid.depth + grid.brick - 1) / grid.brick) {
+        throw std::runtime_error(path + " has an inconsistent header");
+    }
+    const size_t count = static_cast<size_t>(grid.nx) * grid.ny * grid.nz;
+    for (std::vector<float>* values : { &grid.mins, &grid.maxs, &grid.means }) {
+        values->resize(count);
+        in.read(reinterpret_cast<char*>(values->data()), count * sizeof(float));
+    }
+    if (!in) {
+        throw std::runtime_error(path + " is truncated");
+    }
+    return grid;
+}
+
+/**
+ * @brief Min and max over the bricks overlapping a voxel box.
+ */
+BrickGrid::Range BrickGrid::rangeOver(int x0, int y0, int z0, int x1, int y1, int z1) const {
+    x0 = std::clamp(x0, 0, width - 1) / brick;
+    x1 = std::clamp(x1, 0, width - 1) / brick;
+    y0 = std::clamp(y0, 0, height - 1) / brick;
+    y1 = std::clamp(y1, 0, height - 1) / brick;
+    z0 = std::clamp(z0, 0, depth - 1) / brick;
+    z1 = std::clamp(z1, 0, depth - 1) / brick;
+    Range r{ std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+    for (int bz = std::min(z0, z1); bz <= std::max(z0, z1); ++bz) {
+        for (int by = std::min(y0, y1); by <= std::max(y0, y1); ++by) {
+            for (int bx = std::min(x0, x1); bx <= std::max(x0, x1); ++bx) {
+                r.min = std::min(r.min, minAt(bx, by, bz));
+                r.max = std::max(r.max, maxAt(bx, by, bz));
+            }
+        }
+    }
+    return r;
+}
+
+/**
+ * @brief Share of bricks (apron included) that hold nothing but v.
+ */
+double BrickGrid::fractionUniform(float v) const {
+    if (empty()) {
+        return 0.0;
+    }
+    size_t uniform = 0;
+    for (size_t i = 0; i < mins.size(); ++i) {
+        uniform += (mins[i] == v && maxs[i] == v) ? 1 : 0;
+    }
+    return static_cast<double>(uniform) / mins.size();
+}
+
+#define BRICKGRID_INSTANTIATE(T)                                                          \
+    template BrickGrid::BrickGrid(const BasicVolume<T>&, int);                            \
+    template BrickGrid BrickGrid::cached<T>(const BasicVolume<T>&, const std::string&, int);
+
+BRICKGRID_INSTANTIATE(unsigned char)
+BRICKGRID_INSTANTIATE(std::uint16_t)
+BRICKGRID_INSTANTIATE(float)
+
+#undef BRICKGRID_INSTANTIATE
@@ -0,0 +1,120 @@
+/*
+ * @file BrickGrid.h
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#ifndef BRICK_GRID_H
+#define BRICK_GRID_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Volume.h"
+
+/**
+ * @class BrickGrid
+ * @brief Coarse min/max/mean summary of a volume, one entry per brick of size^3 voxels.
+ *
+ * Brick (bx, by, bz) owns voxels [b * size, b * size + size) along each axis. Its min
+ * and max also cover one voxel past that (the apron), so every trilinear sample whose
+ * cell starts in the brick lies within [min, max]; the mean is over the owned voxels
+ * only. Values are in voxel units (0-255, 0-65535 or 0-1) and span all channels.
+ *
+ * A grid built from a freshly loaded volume can be cached next to the slices with
+ * cached(); the cache is keyed on the voxel type, slice range, channels and brick
+ * size, and rebuilt when sliceStamp() says the slices changed.
+ */
+class BrickGrid {
+public:
+    static constexpr int kDefaultSize = 16;
+
+    // Conservative value range of a region
+    struct Range {
+        float min, max;
+    };
+
+    BrickGrid() = default;
+
+    /**
+     * @brief Summarises a volume, in parallel over z bricks.
+     * @param vol The volume.
+     * @param size Brick edge length in voxels (>= 2).
+     * @throws std::invalid_argument If the volume is empty or size < 2.
+     */
+    template <typename T>
+    explicit BrickGrid(const BasicVolume<T>& vol, int size = kDefaultSize);
+
+    /**
+     * @brief Returns the grid cached next to the slices in folderPath, building (and
+     *        caching) it if the cache is missing or stale.
+     *
+     * vol must be the volume exactly as loaded from folderPath. A cache that cannot be
+     * written only gives a warning.
+     */
+    template <typename T>
+    static BrickGrid cached(const BasicVolume<T>& vol, const std::string& folderPath, int size = kDefaultSize);
+
+    /**
+     * @brief Writes the grid to a binary file.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * @brief Reads a grid written by save().
+     * @throws std::runtime_error If the file is missing, truncated or not a brick grid.
+     */
+    static BrickGrid load(const std::string& path);
+
+    int size() const { return brick; }
+    int bricksX() const { return nx; }
+    int bricksY() const { return ny; }
+    int bricksZ() const { return nz; }
+    bool empty() const { return mins.empty(); }
+
+    // True if the grid was built from a volume of these dimensions
+    template <typename T>
+    bool covers(const BasicVolume<T>& vol) const {
+        return !empty() && vol.width == width && vol.height == height && vol.depth == depth;
+    }
+
+    float minAt(int bx, int by, int bz) const { return mins[index(bx, by, bz)]; }
+    float maxAt(int bx, int by, int bz) const { return maxs[index(bx, by, bz)]; }
+    float meanAt(int bx, int by, int bz) const { return means[index(bx, by, bz)]; }
+
+    /**
+     * @brief Range of the voxels in the box [x0, x1] x [y0, y1] x [z0, z1] (inclusive,
+     *        clamped to the volume), from the bricks that overlap it.
+     */
+    Range rangeOver(int x0, int y0, int z0, int x1, int y1, int z1) const;
+
+    // Range over the whole volume
+    float globalMin() const { return lo; }
+    float globalMax() const { return hi; }
+
+    // Fraction of bricks whose range is the single value v (e.g. background)
+    double fractionUniform(float v) const;
+
+    std::uint64_t stamp = 0;  ///< sliceStamp() of the slices the grid was built from (0 = unknown)
+
+private:
+    size_t index(int bx, int by, int bz) const {
+        return (static_cast<size_t>(bz) * ny + by) * nx + bx;
+    }
+
+    int brick = kDefaultSize;
+    int width = 0, height = 0, depth = 0;
+    int nx = 0, ny = 0, nz = 0;
+    std::vector<float> mins, maxs, means;
+    float lo = 0.0f, hi = 0.0f;
+};
+
+#endif // BRICK_GRID_H
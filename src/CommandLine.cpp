@@ -14,9 +14,11 @@
  */
 
  #include "CommandLine.h"
+ #include "PngEncoder.h"
  #include <iostream>
  #include <cstdlib>
  #include <cctype>
+ #include <cerrno>
  #include <algorithm>
  
  /**
@@ -61,6 +63,16 @@
      return hasDigit;
  }
  
+ /**
+  * @brief Checks if a string names a volume axis ("x", "y" or "z", any case).
+  *
+  * @param s The string to check.
+  * @return true for a single axis letter.
+  */
+ static bool isAxis(const std::string &s){
+     return s=="x"||s=="y"||s=="z"||s=="X"||s=="Y"||s=="Z";
+ }
+ 
  /**
   * @brief Attempts to split tokens that appear combined, like "2.0-s"
   *        into separate tokens: ["2.0","-s"]. Also handles strings such
@@ -149,12 +161,25 @@
  
      // First argument => decide image or volume
      std::string firstArg= argv[1];
+     if(firstArg=="--serve"){
+         // Server mode: --serve <socket> [<workers>]; requests name their own outputs
+         opts.isServer= true;
+         opts.serverSocket= argv[2];
+         if(argc>3){
+             if(!isNumeric(argv[3]) || std::atoi(argv[3])<1){
+                 std::cerr<<"ERROR: --serve <socket> [<workers>] needs a positive worker count\n";
+                 std::exit(1);
+             }
+             opts.serverWorkers= std::atoi(argv[3]);
+         }
+         return opts;
+     }
      if(firstArg=="-i"){
          opts.isImage= true;
      } else if(firstArg=="-d"){
          opts.isVolume= true;
      } else {
-         std::cerr<<"ERROR: First option must be -i <image> or -d <volume>.\n";
+         std::cerr<<"ERROR: First option must be -i <image>, -d <volume> or --serve <socket>.\n";
          std::exit(1);
      }
  
@@ -211,10 +236,163 @@
              opts.volumeExt= tokens[i];
              continue;
          }
+         if(opts.isVolume && t=="--voxel-type"){
+             if(i+1>= tokens.size()){
+                 std::cerr<<"ERROR: "<< t <<" requires <type>\n";
+                 std::exit(1);
+             }
+             i++;
+             opts.voxelType= GetVoxelType(tokens[i]);
+             continue;
+         }
+         if(opts.isVolume && t=="--channels"){
+             if(i+1>= tokens.size()){
+                 std::cerr<<"ERROR: "<< t <<" requires <count>\n";
+                 std::exit(1);
+             }
+             i++;
+             int count= (tokens[i]=="auto") ? 0 : std::atoi(tokens[i].c_str());
+             if(count<0 || count>4){
+                 std::cerr<<"[WARN] --channels must be 1-4 or auto (using auto)\n";
+                 count= 0;
+             }
+             opts.volumeChannels= count;
+             continue;
+         }
+ 
+         if(opts.isVolume && t=="--transfer"){
+             if(i+1>= tokens.size()){
+                 std::cerr<<"ERROR: "<< t <<" requires <file>\n";
+                 std::exit(1);
+             }
+             i++;
+             opts.transferPath= tokens[i];
+             continue;
+         }
+         if(opts.isVolume && t=="--volume-cache"){
+             if(i+1>= tokens.size()){
+                 std::cerr<<"ERROR: "<< t <<" requires <dir>\n";
+                 std::exit(1);
+             }
+             i++;
+             opts.volumeCacheDir= tokens[i];
+             continue;
+         }
+         if(opts.isVolume && t=="--brick-cache"){
+             opts.useBrickCache= true;
+             continue;
+         }
+         if(opts.isVolume && t=="--frames"){
+             if(i+1>= tokens.size() || !isNumeric(tokens[i+1])){
+                 std::cerr<<"ERROR: "<< t <<" requires <count>\n";
+                 std::exit(1);
+             }
+             i++;
+             opts.renderFrames= std::max(1, std::atoi(tokens[i].c_str()));
+             continue;
+         }
  
+         // Seed for random operations, valid in either mode
+         if(t=="--seed"){
+             if(i+1>= tokens.size()){
+                 std::cerr<<"ERROR: "<< t <<" requires <value>\n";
+                 std::exit(1);
+             }
+             i++;
+             // strtoull alone would accept "-1", "12abc" or an empty string
+             const std::string &v= tokens[i];
+             char *end= nullptr;
+             errno= 0;
+             if(!v.empty() && std::isdigit(static_cast<unsigned char>(v[0]))){
+                 opts.seed= std::strtoull(v.c_str(), &end, 10);
+             }
+             if(end==nullptr || *end!='\0' || errno==ERANGE){
+                 std::cerr<<"ERROR: "<< t <<" requires a non-negative integer, got \""<< v <<"\"\n";
+                 std::exit(1);
+             }
+             opts.hasSeed= true;
+             continue;
+         }
+
+         // Stage timing, valid in either mode: an optional .json file gets a Chrome trace
+         if(t=="--trace"){
+             opts.trace= true;
+             if(i+1< tokens.size() && tokens[i+1].size()>5 &&
+                tokens[i+1].compare(tokens[i+1].size()-5, 5, ".json")==0){
+                 i++;
+                 opts.tracePath= tokens[i];
+             }
+             continue;
+         }
+
+         // Output encoder settings, valid in either mode
+         if(t=="--quality"||t=="--png-level"||t=="--png-filter"||t=="--bit-depth"||t=="--format"){
+             if(i+1>= tokens.size()){
+                 std::cerr<<"ERROR: "<< t <<" requires <value>\n";
+                 std::exit(1);
+             }
+             i++;
+             if(t=="--quality"){
+                 opts.writeOptions.jpegQuality= std::atoi(tokens[i].c_str());
+             } else if(t=="--png-level"){
+                 opts.writeOptions.pngCompression= std::atoi(tokens[i].c_str());
+             } else if(t=="--bit-depth"){
+                 int depth= std::atoi(tokens[i].c_str());
+                 if(depth!=8 && depth!=16){
+                     std::cerr<<"[WARN] --bit-depth must be 8 or 16 (following the source)\n";
+                     depth= 0;
+                 }
+                 opts.writeOptions.bitDepth= depth;
+             } else if(t=="--format"){
+                 std::string format= tokens[i];
+                 std::transform(format.begin(), format.end(), format.begin(), ::tolower);
+                 if(format!="png" && format!="jpg" && format!="jpeg" && format!="bmp" && format!="tga"){
+                     std::cerr<<"ERROR: --format must be png, jpg, bmp or tga\n";
+                     std::exit(1);
+                 }
+                 opts.writeOptions.format= format;
+             } else {
+                 opts.writeOptions.pngFilter= PngEncoder::GetFilter(tokens[i]);
+             }
+             continue;
+         }
+
          // Create a FilterOption object for storing operation details
          FilterOption fo;
  
+         // Resizing applies to images and to every volume plane alike
+         if(t=="--resize"||t=="--scale"){
+             const bool isResize= (t=="--resize");
+             const size_t needed= isResize ? 2 : 1;
+             for(size_t k=1; k<=needed; ++k){
+                 if(i+k>= tokens.size() || !isNumeric(tokens[i+k])){
+                     std::cerr<<"ERROR: "<< t <<(isResize ? " requires <width> <height>\n" : " requires <factor>\n");
+                     std::exit(1);
+                 }
+             }
+             fo.name= isResize ? "resize" : "scale";
+             for(size_t k=0; k<needed; ++k){
+                 i++;
+                 fo.floats.push_back(std::atof(tokens[i].c_str()));
+             }
+
+             // Sizes are whole pixels (at least 1), the factor only has to be positive
+             if(isResize ? (fo.floats[0]<1.f || fo.floats[1]<1.f) : !(fo.floats[0]>0.f)){
+                 std::cerr<<"ERROR: "<< t <<(isResize ? " needs a width and height of at least 1\n"
+                                                      : " needs a positive factor\n");
+                 std::exit(1);
+             }
+
+             // Optional kernel name
+             if(i+1< tokens.size() && (tokens[i+1]=="Box"||tokens[i+1]=="Bilinear"||
+                                       tokens[i+1]=="Bicubic"||tokens[i+1]=="Lanczos3")){
+                 i++;
+                 fo.subtype= tokens[i];
+             }
+             opts.operations.push_back(fo);
+             continue;
+         }
+
          // If in image mode, interpret tokens as 2D filter or operation
          if(opts.isImage){
              if(t=="-g"||t=="--greyscale"){
@@ -270,10 +448,37 @@
                  i++;
                  fo.name="edge";
                  fo.subtype= tokens[i];
+
+                 // Canny takes optional <low> <high> thresholds; after any other detector a
+                 // number is left to the main loop, which warns about it
+                 while(fo.subtype=="Canny" && fo.floats.size()<2 && i+1< tokens.size() && isNumeric(tokens[i+1])){
+                     i++;
+                     fo.floats.push_back(std::atof(tokens[i].c_str()));
+                 }
                  opts.operations.push_back(fo);
              }
              else if(t=="-p"||t=="--sharpen"){
                  fo.name="sharpen"; 
+
+                 // Optional <strength>
+                 if(i+1< tokens.size() && isNumeric(tokens[i+1])){
+                     i++;
+                     fo.floats.push_back(std::atof(tokens[i].c_str()));
+                 }
+                 opts.operations.push_back(fo);
+             }
+             else if(t=="-u"||t=="--unsharp"){
+                 if(i+1>= tokens.size() || !isNumeric(tokens[i+1])){
+                     std::cerr<<"ERROR: unsharp requires <amount>\n";
+                     std::exit(1);
+                 }
+                 fo.name="unsharp";
+
+                 // <amount> then optional <radius> <threshold>
+                 while(fo.floats.size()<3 && i+1< tokens.size() && isNumeric(tokens[i+1])){
+                     i++;
+                     fo.floats.push_back(std::atof(tokens[i].c_str()));
+                 }
                  opts.operations.push_back(fo);
              }
              else if(t=="-n"||t=="--saltpepper"){
@@ -286,6 +491,16 @@
                  fo.floats.push_back(std::atof(tokens[i].c_str()));
                  opts.operations.push_back(fo);
              }
+             else if(t=="--level"){
+                 if(i+1>= tokens.size() || !isNumeric(tokens[i+1])){
+                     std::cerr<<"ERROR: level requires <index>\n";
+                     std::exit(1);
+                 }
+                 i++;
+                 fo.name="level";
+                 fo.floats.push_back(std::atof(tokens[i].c_str()));
+                 opts.operations.push_back(fo);
+             }
              else if(t=="-t"||t=="--threshold"){
                  if(i+2>= tokens.size()){
                      std::cerr<<"ERROR: threshold requires <value> <type>\n";
@@ -339,6 +554,61 @@
                  fo.floats.push_back(std::atof(tokens[i].c_str()));
                  opts.operations.push_back(fo);
              }
+             else if(t=="--slices"){
+                 // <plane> then optional <first> <last> [<step>]
+                 if(i+1>= tokens.size()){
+                     std::cerr<<"ERROR: slices requires <plane>\n";
+                     std::exit(1);
+                 }
+                 i++;
+                 fo.name="slices";
+                 fo.subtype= tokens[i];
+                 while(fo.floats.size()<3 && i+1< tokens.size() && isNumeric(tokens[i+1])){
+                     i++;
+                     fo.floats.push_back(std::atof(tokens[i].c_str()));
+                 }
+                 opts.operations.push_back(fo);
+             }
+             else if(t=="--cpr"){
+                 // <points file> then optional <width> [<spacing>] and Spline|Polyline
+                 if(i+1>= tokens.size()){
+                     std::cerr<<"ERROR: cpr requires <points file>\n";
+                     std::exit(1);
+                 }
+                 i++;
+                 fo.name="cpr";
+                 fo.path= tokens[i];
+                 fo.subtype="Spline";
+                 while(fo.floats.size()<2 && i+1< tokens.size() && isNumeric(tokens[i+1])){
+                     i++;
+                     fo.floats.push_back(std::atof(tokens[i].c_str()));
+                 }
+                 if(i+1< tokens.size() && (tokens[i+1]=="Spline"||tokens[i+1]=="Polyline")){
+                     i++;
+                     fo.subtype= tokens[i];
+                 }
+                 opts.operations.push_back(fo);
+             }
+             else if(t=="--oblique"||t=="--oblique-points"){
+                 // Plane (6 numbers: point + normal, or 9: three points), then
+                 // optional <width> <height> [<spacing>]
+                 const bool byPoints= (t=="--oblique-points");
+                 const size_t needed= byPoints ? 9 : 6;
+                 for(size_t k=1; k<=needed; ++k){
+                     if(i+k>= tokens.size() || !isNumeric(tokens[i+k])){
+                         std::cerr<<"ERROR: "<< t <<(byPoints ? " requires <x1> <y1> <z1> <x2> <y2> <z2> <x3> <y3> <z3>\n"
+                                                               : " requires <x> <y> <z> <nx> <ny> <nz>\n");
+                         std::exit(1);
+                     }
+                 }
+                 fo.name="oblique";
+                 fo.subtype= byPoints ? "points" : "normal";
+                 while(fo.floats.size()< needed+3 && i+1< tokens.size() && isNumeric(tokens[i+1])){
+                     i++;
+                     fo.floats.push_back(std::atof(tokens[i].c_str()));
+                 }
+                 opts.operations.push_back(fo);
+             }
              else if(t=="-p"||t=="--projection"){
                  if(i+1>= tokens.size()){
                      std::cerr<<"ERROR: projection requires <type>\n";
@@ -347,6 +617,48 @@
                  i++;
                  fo.name="projection";
                  fo.subtype= tokens[i];
+
+                 // Optional axis (default z)
+                 if(i+1< tokens.size() && isAxis(tokens[i+1])){
+                     i++;
+                     fo.axis= tokens[i];
+                 }
+                 opts.operations.push_back(fo);
+             }
+             else if(t=="--slab"){
+                 // <type> <thickness> then optional <step> and axis
+                 if(i+2>= tokens.size() || !isNumeric(tokens[i+2])){
+                     std::cerr<<"ERROR: slab requires <type> <thickness>\n";
+                     std::exit(1);
+                 }
+                 i++;
+                 fo.name="slab";
+                 fo.subtype= tokens[i];
+                 i++;
+                 fo.floats.push_back(std::atof(tokens[i].c_str()));
+                 if(i+1< tokens.size() && isNumeric(tokens[i+1])){
+                     i++;
+                     fo.floats.push_back(std::atof(tokens[i].c_str()));
+                 }
+                 if(i+1< tokens.size() && isAxis(tokens[i+1])){
+                     i++;
+                     fo.axis= tokens[i];
+                 }
+                 opts.operations.push_back(fo);
+             }
+             else if(t=="--render"){
+                 // <mode> then optional <yaw> [<pitch> [<width> <height> [<step>]]]
+                 if(i+1>= tokens.size()){
+                     std::cerr<<"ERROR: render requires <mode>\n";
+                     std::exit(1);
+                 }
+                 i++;
+                 fo.name="render";
+                 fo.subtype= tokens[i];
+                 while(fo.floats.size()< 5 && i+1< tokens.size() && isNumeric(tokens[i+1])){
+                     i++;
+                     fo.floats.push_back(std::atof(tokens[i].c_str()));
+                 }
                  opts.operations.push_back(fo);
              }
              else {
@@ -369,6 +681,22 @@
          std::cerr<<"ERROR: missing output path.\n";
          std::exit(1);
      }
+
+     // "-" streams a single image through standard input/output
+     if(opts.isVolume && opts.inputPath=="-"){
+         std::cerr<<"ERROR: volume input must be a folder of slices, not standard input.\n";
+         std::exit(1);
+     }
+     if(opts.outputPath=="-"){
+         bool several= opts.renderFrames>1;
+         for(const auto &op: opts.operations){
+             several= several || op.name=="slab" || op.name=="slices";
+         }
+         if(several){
+             std::cerr<<"ERROR: --slab, --slices and --frames write several files; they cannot write to standard output.\n";
+             std::exit(1);
+         }
+     }
  
      return opts;
  }
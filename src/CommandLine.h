@@ -16,35 +16,67 @@
 
 #include <string>
 #include <vector>
+#include "Image.h"
+#include "Volume.h"
 
 /**
  * FilterOption: a single operation (2D or 3D).
  *   name: Represents the primary operation name (like "greyscale" for 2D or "slice" for 3D).
  *   subtype: Provides extra detail on the type of operation (like "Gaussian" for a blur, or "MIP" for a projection).
  *   floats: Holds any numeric parameters needed by the operation (e.g., kernel size, threshold value, etc.).
+ *   path: A file argument of the operation (e.g. the centreline of a curved reformation).
+ *   axis: The axis a projection runs along ("x", "y" or "z"; empty = z).
  */
 struct FilterOption {
     std::string name;          ///< Main identifier of the operation
     std::string subtype;       ///< Additional qualifier or variety of the operation
     std::vector<float> floats; ///< Numeric parameters for the operation
+    std::string path;          ///< File argument, if the operation takes one
+    std::string axis;          ///< Projection axis, if given
 };
 
 /**
  * CommandOptions: Stores results after parsing the command line.
  *   - isImage / isVolume indicate the mode (-i for images, -d for volumes).
+ *   - isServer selects server mode (--serve): serverSocket / serverWorkers configure it.
  *   - inputPath / outputPath are the paths for the input and output respectively.
  *   - firstIndex, lastIndex, volumeExt are used if it's a volume (to read slices).
+ *   - voxelType selects 8-bit, 16-bit or float voxels for a volume (Auto follows the slices).
+ *   - volumeChannels is the channel count kept per voxel (0 = as stored in the slices).
+ *   - transferPath / renderFrames configure --render (transfer function, turntable views).
+ *   - useBrickCache lets MIP/MinIP and --render skip background via a cached BrickGrid.
+ *   - volumeCacheDir is where preprocessed volumes are cached (empty = no caching).
+ *   - seed makes random operations reproducible when hasSeed is set.
+ *   - trace turns on stage timing; tracePath names the Chrome trace file (empty = summary).
+ *   - writeOptions holds the JPEG quality / PNG compression used for the output.
  *   - operations holds all filters/operations in order.
  */
 struct CommandOptions {
     bool isImage  = false;     ///< True if user selected an image mode (-i)
     bool isVolume = false;     ///< True if user selected a volume mode (-d)
+    bool isServer = false;     ///< True if user started the volume server (--serve)
+    std::string serverSocket;  ///< Unix domain socket the server listens on
+    int serverWorkers = 4;     ///< Connections the server handles at once
     std::string inputPath;     ///< The input file or directory path
     std::string outputPath;    ///< The resulting output file name
 
     int firstIndex = -1;       ///< Starting index for volume slices
     int lastIndex  = -1;       ///< Ending index for volume slices (if needed)
     std::string volumeExt = "png"; ///< File extension for volume slices
+    VoxelType voxelType = VoxelType::Auto; ///< Voxel storage type for volumes
+    int volumeChannels = 0;        ///< Channels per voxel (0 = as stored in the slices)
+    std::string transferPath;      ///< Transfer function file for composited rendering
+    int renderFrames = 1;          ///< Views in a rendered turntable (yaw steps of 360 / n)
+    bool useBrickCache = false;    ///< Use (and write) the brick summary cached next to the slices
+    std::string volumeCacheDir;    ///< Folder of cached preprocessed volumes (empty = off)
+
+    bool hasSeed = false;          ///< True if --seed was given
+    unsigned long long seed = 0;   ///< Seed for random operations (e.g. salt and pepper noise)
+
+    bool trace = false;            ///< True if --trace was given
+    std::string tracePath;         ///< Chrome trace-event JSON file (empty = print a summary)
+
+    ImageWriteOptions writeOptions; ///< Encoder settings for the output file
 
     std::vector<FilterOption> operations; ///< Sequence of operations (filters or transforms)
 };
@@ -12,13 +12,15 @@
  * - Keyun    (GitHub: esemsc-km824)
  */
 #include "Filters3D.h"
+#include "Parallel.h"
 #include <algorithm>
 #include <cmath>
 #include <vector>
-#include "stb_image_write.h"
+#include <type_traits>
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <mutex>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -41,7 +43,8 @@ void createDirectory(const std::string &dirName)
  * @param folder The output folder where images will be saved.
  * @param prefix The prefix for saved image file names.
  */
-void Filters3D::saveSlicesAsPNG(const Volume &volume, const std::string &folder, const std::string &prefix)
+template <typename T>
+void Filters3D::saveSlicesAsPNG(const BasicVolume<T> &volume, const std::string &folder, const std::string &prefix)
 {
     if (volume.depth == 0 || volume.width == 0 || volume.height == 0)
     {
@@ -56,33 +59,41 @@ void Filters3D::saveSlicesAsPNG(const Volume &volume, const std::string &folder,
     // Create the output directory if it doesn't exist
     createDirectory(folder);
 
-    // Save all slices
-    for (int z = 0; z < depth; ++z)
+    // Save all slices; slices are independent, so they are encoded in parallel
+    std::mutex logMutex;
+    Parallel::forBands(0, depth, [&](int zBegin, int zEnd)
     {
-        std::vector<unsigned char> sliceData(width * height);
-
-        // Copy slice data
-        for (int y = 0; y < height; ++y)
+        for (int z = zBegin; z < zEnd; ++z)
         {
-            for (int x = 0; x < width; ++x)
+            // A slice (interleaved channels included) is one contiguous block, written in place
+            const size_t sliceSize = static_cast<size_t>(width) * height * volume.channels;
+            const T *sliceData = volume.data.data() + sliceSize * z;
+
+            // Generate filename
+            std::string filename = folder + "/" + prefix + "_slice_" + std::to_string(z) + ".png";
+
+            // Save as PNG (1 channel = grayscale)
+            bool saved = true;
+            try
             {
-                sliceData[y * width + x] = volume.getVoxel(x, y, z);
+                writeVoxelPlane(sliceData, width, height, volume.channels, filename, ImageWriteOptions{});
+            }
+            catch (const std::exception &)
+            {
+                saved = false;
             }
-        }
-
-        // Generate filename
-        std::string filename = folder + "/" + prefix + "_slice_" + std::to_string(z) + ".png";
 
-        // Save as PNG (1 channel = grayscale)
-        if (stbi_write_png(filename.c_str(), width, height, 1, sliceData.data(), width))
-        {
-            std::cout << "Saved: " << filename << std::endl;
-        }
-        else
-        {
-            std::cerr << "Error saving PNG: " << filename << std::endl;
+            std::lock_guard<std::mutex> lock(logMutex);
+            if (saved)
+            {
+                std::cout << "Saved: " << filename << std::endl;
+            }
+            else
+            {
+                std::cerr << "Error saving PNG: " << filename << std::endl;
+            }
         }
-    }
+    });
 }
 
 /**
@@ -117,7 +128,8 @@ std::vector<double> generateGaussianKernel(int kernelSize, double sigma)
  * @param kernelSize Size of the Gaussian kernel.
  * @param sigma Standard deviation of the Gaussian function.
  */
-void Filters3D::apply3DGaussianBlur(Volume &volume, int kernelSize, double sigma)
+template <typename T>
+void Filters3D::apply3DGaussianBlur(BasicVolume<T> &volume, int kernelSize, double sigma)
 {
     if (kernelSize % 2 == 0)
         kernelSize += 1; // Ensure odd kernel size
@@ -126,35 +138,40 @@ void Filters3D::apply3DGaussianBlur(Volume &volume, int kernelSize, double sigma
     int height = volume.height;
     int depth = volume.depth;
     int radius = kernelSize / 2;
+    // Channels are interleaved, so each row holds width * channels samples; only the
+    // x pass has to step over the other channels, y and z treat rows as flat arrays
+    int channels = volume.channels;
+    int rowLen = width * channels;
 
     std::vector<double> kernel = generateGaussianKernel(kernelSize, sigma);
-    std::vector<unsigned char> tempData(volume.data.size());
+    std::vector<T> tempData(volume.data.size());
 
     // Step 1: Apply 1D Gaussian Blur in X direction
     for (int z = 0; z < depth; ++z)
     {
         for (int y = 0; y < height; ++y)
         {
-            for (int x = 0; x < width; ++x)
+            for (int x = 0; x < rowLen; ++x)
             {
+                const int px = x / channels, c = x % channels;
                 double sum = 0.0, weightSum = 0.0;
                 for (int dx = -radius; dx <= radius; ++dx)
                 {
-                    int nx = std::max(0, std::min(x + dx, width - 1));
+                    int nx = std::max(0, std::min(px + dx, width - 1));
                     double weight = kernel[dx + radius];
-                    sum += volume.getVoxel(nx, y, z) * weight;
+                    sum += volume.getVoxel(nx, y, z, c) * weight;
                     weightSum += weight;
                 }
-                tempData[x + width * (y + height * z)] = static_cast<unsigned char>(sum / weightSum);
+                tempData[x + rowLen * (y + height * z)] = static_cast<T>(sum / weightSum);
             }
         }
     }
 
     // Step 2: Apply 1D Gaussian Blur in Y direction
-    std::vector<unsigned char> tempData2(volume.data.size());
+    std::vector<T> tempData2(volume.data.size());
     for (int z = 0; z < depth; ++z)
     {
-        for (int x = 0; x < width; ++x)
+        for (int x = 0; x < rowLen; ++x)
         {
             for (int y = 0; y < height; ++y)
             {
@@ -163,10 +180,10 @@ void Filters3D::apply3DGaussianBlur(Volume &volume, int kernelSize, double sigma
                 {
                     int ny = std::max(0, std::min(y + dy, height - 1));
                     double weight = kernel[dy + radius];
-                    sum += tempData[x + width * (ny + height * z)] * weight;
+                    sum += tempData[x + rowLen * (ny + height * z)] * weight;
                     weightSum += weight;
                 }
-                tempData2[x + width * (y + height * z)] = static_cast<unsigned char>(sum / weightSum);
+                tempData2[x + rowLen * (y + height * z)] = static_cast<T>(sum / weightSum);
             }
         }
     }
@@ -174,7 +191,7 @@ void Filters3D::apply3DGaussianBlur(Volume &volume, int kernelSize, double sigma
     // Step 3: Apply 1D Gaussian Blur in Z direction
     for (int y = 0; y < height; ++y)
     {
-        for (int x = 0; x < width; ++x)
+        for (int x = 0; x < rowLen; ++x)
         {
             for (int z = 0; z < depth; ++z)
             {
@@ -183,21 +200,23 @@ void Filters3D::apply3DGaussianBlur(Volume &volume, int kernelSize, double sigma
                 {
                     int nz = std::max(0, std::min(z + dz, depth - 1));
                     double weight = kernel[dz + radius];
-                    sum += tempData2[x + width * (y + height * nz)] * weight;
+                    sum += tempData2[x + rowLen * (y + height * nz)] * weight;
                     weightSum += weight;
                 }
-                volume.data[x + width * (y + height * z)] = static_cast<unsigned char>(sum / weightSum);
+                volume.data[x + rowLen * (y + height * z)] = static_cast<T>(sum / weightSum);
             }
         }
     }
 }
 
 /**
- * @brief Applies a 3D median blur to a volume.
+ * @brief Median blur for wider voxel types: selects the median of each window with
+ *        std::nth_element (a histogram would need 65536 bins, or none for float).
  * @param volume The 3D volume to process.
  * @param kernelSize Size of the median filter kernel.
  */
-void Filters3D::apply3DMedianBlur(Volume &volume, int kernelSize)
+template <typename T>
+static void medianBlurSelect(BasicVolume<T> &volume, int kernelSize)
 {
     if (kernelSize % 2 == 0)
         kernelSize += 1; // Ensure kernel size is odd
@@ -206,75 +225,90 @@ void Filters3D::apply3DMedianBlur(Volume &volume, int kernelSize)
     int width = volume.width;
     int height = volume.height;
     int depth = volume.depth;
+    int channels = volume.channels;
 
-    std::vector<unsigned char> newData(volume.data.size(), 0);
-    int histogram[256]; // Histogram array for counting sort (0-255 values)
+    std::vector<T> newData(volume.data.size(), T(0));
+    std::vector<T> window(static_cast<size_t>(kernelSize) * kernelSize * kernelSize);
+    const size_t medianPos = window.size() / 2;
 
-    // Iterate over every voxel in the volume
     for (int z = 0; z < depth; ++z)
     {
         for (int y = 0; y < height; ++y)
         {
-            memset(histogram, 0, sizeof(histogram)); // Reset histogram for the new row
-
-            // Initialize histogram for the first column
-            for (int dz = -radius; dz <= radius; ++dz)
+            for (int x = 0; x < width * channels; ++x)
             {
-                for (int dy = -radius; dy <= radius; ++dy)
+                // x runs over interleaved samples; the window stays within one channel
+                const int px = x / channels, c = x % channels;
+                size_t n = 0;
+                for (int dz = -radius; dz <= radius; ++dz)
                 {
-                    for (int dx = -radius; dx <= radius; ++dx)
+                    int nz = std::max(0, std::min(z + dz, depth - 1));
+                    for (int dy = -radius; dy <= radius; ++dy)
                     {
-                        int nz = std::max(0, std::min(z + dz, depth - 1));
                         int ny = std::max(0, std::min(y + dy, height - 1));
-                        int nx = std::max(0, std::min(dx, width - 1));
-                        histogram[volume.getVoxel(nx, ny, nz)]++;
+                        for (int dx = -radius; dx <= radius; ++dx)
+                        {
+                            int nx = std::max(0, std::min(px + dx, width - 1));
+                            window[n++] = volume.data[((static_cast<size_t>(nz) * height + ny) * width + nx) * channels + c];
+                        }
                     }
                 }
+                std::nth_element(window.begin(), window.begin() + medianPos, window.end());
+                newData[x + static_cast<size_t>(width) * channels * (y + static_cast<size_t>(height) * z)] = window[medianPos];
             }
+        }
+    }
 
-            // Compute the first median
-            int count = 0, medianValue = 0;
-            int medianPos = (kernelSize * kernelSize * kernelSize) / 2;
-            for (int i = 0; i < 256; ++i)
-            {
-                count += histogram[i];
-                if (count > medianPos)
-                {
-                    medianValue = i;
-                    break;
-                }
-            }
-            newData[z * width * height + y * width] = medianValue;
+    volume.data = newData;
+}
+
+/**
+ * @brief Median blur for 8-bit volumes using a sliding 256-bin histogram per row
+ *        and channel.
+ * @param volume The 3D volume to process.
+ * @param kernelSize Size of the median filter kernel.
+ */
+static void medianBlurHistogram(Volume &volume, int kernelSize)
+{
+    if (kernelSize % 2 == 0)
+        kernelSize += 1; // Ensure kernel size is odd
+    int radius = kernelSize / 2;
 
-            // Move the window horizontally across the row
-            for (int x = 1; x < width; ++x)
+    int width = volume.width;
+    int height = volume.height;
+    int depth = volume.depth;
+    int channels = volume.channels;
+
+    std::vector<unsigned char> newData(volume.data.size(), 0);
+    int histogram[256]; // Histogram array for counting sort (0-255 values)
+
+    // Iterate over every voxel in the volume
+    for (int z = 0; z < depth; ++z)
+    {
+        for (int y = 0; y < height; ++y)
+        {
+            for (int c = 0; c < channels; ++c)
             {
-                // Remove the outgoing column
-                for (int dz = -radius; dz <= radius; ++dz)
-                {
-                    for (int dy = -radius; dy <= radius; ++dy)
-                    {
-                        int nz = std::max(0, std::min(z + dz, depth - 1));
-                        int ny = std::max(0, std::min(y + dy, height - 1));
-                        int oldNx = std::max(0, x - radius - 1);
-                        histogram[volume.getVoxel(oldNx, ny, nz)]--;
-                    }
-                }
+                memset(histogram, 0, sizeof(histogram)); // Reset histogram for the new row and channel
 
-                // Add the new column
+                // Initialize histogram for the first column
                 for (int dz = -radius; dz <= radius; ++dz)
                 {
                     for (int dy = -radius; dy <= radius; ++dy)
                     {
-                        int nz = std::max(0, std::min(z + dz, depth - 1));
-                        int ny = std::max(0, std::min(y + dy, height - 1));
-                        int newNx = std::min(width - 1, x + radius);
-                        histogram[volume.getVoxel(newNx, ny, nz)]++;
+                        for (int dx = -radius; dx <= radius; ++dx)
+                        {
+                            int nz = std::max(0, std::min(z + dz, depth - 1));
+                            int ny = std::max(0, std::min(y + dy, height - 1));
+                            int nx = std::max(0, std::min(dx, width - 1));
+                            histogram[volume.getVoxel(nx, ny, nz, c)]++;
+                        }
                     }
                 }
 
-                // Compute new median
-                count = 0, medianValue = 0;
+                // Compute the first median
+                int count = 0, medianValue = 0;
+                int medianPos = (kernelSize * kernelSize * kernelSize) / 2;
                 for (int i = 0; i < 256; ++i)
                 {
                     count += histogram[i];
@@ -284,9 +318,50 @@ void Filters3D::apply3DMedianBlur(Volume &volume, int kernelSize)
                         break;
                     }
                 }
+                newData[(z * width * height + y * width) * channels + c] = medianValue;
 
-                // Store new median
-                newData[z * width * height + y * width + x] = medianValue;
+                // Move the window horizontally across the row
+                for (int x = 1; x < width; ++x)
+                {
+                    // Remove the outgoing column
+                    for (int dz = -radius; dz <= radius; ++dz)
+                    {
+                        for (int dy = -radius; dy <= radius; ++dy)
+                        {
+                            int nz = std::max(0, std::min(z + dz, depth - 1));
+                            int ny = std::max(0, std::min(y + dy, height - 1));
+                            int oldNx = std::max(0, x - radius - 1);
+                            histogram[volume.getVoxel(oldNx, ny, nz, c)]--;
+                        }
+                    }
+
+                    // Add the new column
+                    for (int dz = -radius; dz <= radius; ++dz)
+                    {
+                        for (int dy = -radius; dy <= radius; ++dy)
+                        {
+                            int nz = std::max(0, std::min(z + dz, depth - 1));
+                            int ny = std::max(0, std::min(y + dy, height - 1));
+                            int newNx = std::min(width - 1, x + radius);
+                            histogram[volume.getVoxel(newNx, ny, nz, c)]++;
+                        }
+                    }
+
+                    // Compute new median
+                    count = 0, medianValue = 0;
+                    for (int i = 0; i < 256; ++i)
+                    {
+                        count += histogram[i];
+                        if (count > medianPos)
+                        {
+                            medianValue = i;
+                            break;
+                        }
+                    }
+
+                    // Store new median
+                    newData[(z * width * height + y * width + x) * channels + c] = medianValue;
+                }
             }
         }
     }
@@ -294,6 +369,20 @@ void Filters3D::apply3DMedianBlur(Volume &volume, int kernelSize)
     volume.data = newData;
 }
 
+/**
+ * @brief Applies a 3D median blur to a volume.
+ * @param volume The 3D volume to process.
+ * @param kernelSize Size of the median filter kernel.
+ */
+template <typename T>
+void Filters3D::apply3DMedianBlur(BasicVolume<T> &volume, int kernelSize)
+{
+    if constexpr (std::is_same_v<T, unsigned char>)
+        medianBlurHistogram(volume, kernelSize);
+    else
+        medianBlurSelect(volume, kernelSize);
+}
+
 /**
  * @brief Applies a selected 3D blur filter to a volume.
  * @param volume The 3D volume to process.
@@ -301,7 +390,8 @@ void Filters3D::apply3DMedianBlur(Volume &volume, int kernelSize)
  * @param kernelSize Size of the filter kernel.
  * @param sigma Standard deviation (only for Gaussian blur).
  */
-void Filters3D::apply3DBlur(Volume &volume,
+template <typename T>
+void Filters3D::apply3DBlur(BasicVolume<T> &volume,
                             const std::string &blurType,
                             float kernelSize,
                             float sigma /*=2.0f*/)
@@ -322,3 +412,16 @@ void Filters3D::apply3DBlur(Volume &volume,
         std::cerr << "[WARN] Unknown 3D blur type: " << blurType << "\n";
     }
 }
+
+// Explicit instantiations for the supported voxel types
+#define FILTERS3D_INSTANTIATE(T)                                                              \
+    template void Filters3D::apply3DGaussianBlur<T>(BasicVolume<T> &, int, double);            \
+    template void Filters3D::apply3DMedianBlur<T>(BasicVolume<T> &, int);                      \
+    template void Filters3D::apply3DBlur<T>(BasicVolume<T> &, const std::string &, float, float); \
+    template void Filters3D::saveSlicesAsPNG<T>(const BasicVolume<T> &, const std::string &, const std::string &);
+
+FILTERS3D_INSTANTIATE(unsigned char)
+FILTERS3D_INSTANTIATE(std::uint16_t)
+FILTERS3D_INSTANTIATE(float)
+
+#undef FILTERS3D_INSTANTIATE
@@ -16,21 +16,27 @@
 
 #include "Volume.h"
 
+// All methods are templates over the voxel type and are instantiated in
+// Filters3D.cpp for Volume, Volume16 and VolumeF.
 class Filters3D
 {
 public:
     // Existing specialized blur methods:
-    void apply3DGaussianBlur(Volume &volume, int kernelSize = 3, double sigma = 2.0);
-    void apply3DMedianBlur(Volume &volume, int kernelSize = 3);
+    template <typename T>
+    void apply3DGaussianBlur(BasicVolume<T> &volume, int kernelSize = 3, double sigma = 2.0);
+    template <typename T>
+    void apply3DMedianBlur(BasicVolume<T> &volume, int kernelSize = 3);
 
     // A "master" 3D blur dispatcher, to be called from main:
-    void apply3DBlur(Volume &volume,
+    template <typename T>
+    void apply3DBlur(BasicVolume<T> &volume,
                      const std::string &blurType, // e.g. "Gaussian", "Median", "Box", etc.
                      float kernelSize,            // e.g. 3
                      float sigma = 2.0f);         // optional stdev if "Gaussian"
                      
-    // Utility: Save volume slices
-    void saveSlicesAsPNG(const Volume &volume,
+    // Utility: Save volume slices (16-bit PNGs for uint16/float volumes)
+    template <typename T>
+    void saveSlicesAsPNG(const BasicVolume<T> &volume,
                          const std::string &folder,
                          const std::string &prefix);
 };
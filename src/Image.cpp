@@ -15,21 +15,135 @@
 #include "stb_image.h"
 #include "stb_image_write.h"
 #include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cctype>
+#include <cstdio>
+#include <limits>
+#include "PngEncoder.h"
+#include "Trace.h"
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+/**
+ * @brief stb_image_write callback that appends the encoded bytes to a std::vector.
+ */
+static void appendToVector(void* context, void* data, int size) {
+    auto* out = static_cast<std::vector<unsigned char>*>(context);
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    out->insert(out->end(), bytes, bytes + size);
+}
+
+/**
+ * @brief Writes an encoded file in one call ("-" writes to standard output).
+ */
+static bool writeFile(const char* filepath, const std::vector<unsigned char>& bytes) {
+    if (std::string(filepath) == "-") {
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        const size_t written = std::fwrite(bytes.data(), 1, bytes.size(), stdout);
+        return written == bytes.size() && std::fflush(stdout) == 0;
+    }
+    std::ofstream out(filepath, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Reads all of standard input (binary).
+ */
+static std::vector<unsigned char> readStdin() {
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+#endif
+    std::vector<unsigned char> bytes;
+    unsigned char chunk[65536];
+    size_t got;
+    while ((got = std::fread(chunk, 1, sizeof(chunk), stdin)) > 0) {
+        bytes.insert(bytes.end(), chunk, chunk + got);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Lower-case extension of a path without the dot ("" if there is none).
+ */
+static std::string fileExtension(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    size_t slash = path.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return "";
+    }
+    std::string ext = path.substr(dot + 1);
+    for (char& ch : ext) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    return ext;
+}
+
+/**
+ * @brief Format an output is encoded in: options.format if set, else the extension
+ *        ("png" for standard output).
+ */
+static std::string outputFormat(const char* filepath, const ImageWriteOptions& options) {
+    if (!options.format.empty()) {
+        return options.format;
+    }
+    return std::string(filepath) == "-" ? std::string("png") : fileExtension(filepath);
+}
 
 /**
  * @brief Constructs an Image object by loading an image from a file.
  * 
- * @param filepath The path to the image file.
+ * @param filepath The path to the image file, or "-" to read the encoded image from
+ *                 standard input.
  * 
  * @throws std::runtime_error If the image fails to load.
  */
 Image::Image(const char* filepath) {
+    if (std::string(filepath) == "-") {
+        const std::vector<unsigned char> bytes = readStdin();
+        if (bytes.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+            throw std::runtime_error("Image on standard input is too large to decode.");
+        }
+        data = stbi_load_from_memory(bytes.data(), static_cast<int>(bytes.size()), &width, &height, &channels, 0);
+        if (!data) {
+            throw std::runtime_error("Failed to decode image from standard input.");
+        }
+        return;
+    }
     data = stbi_load(filepath, &width, &height, &channels, 0);
     if (!data) {
         throw std::runtime_error("Failed to load image from filepath: " + std::string(filepath));
     }
 }
 
+/**
+ * @brief Constructs an Image object by decoding an encoded image (PNG, JPEG, BMP, TGA,
+ *        ... as read by stb_image) held in memory.
+ * 
+ * @param encoded The encoded bytes.
+ * @param size Number of bytes.
+ * 
+ * @throws std::runtime_error If the bytes cannot be decoded.
+ */
+Image::Image(const unsigned char* encoded, std::size_t size) {
+    if (!encoded || size == 0 || size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        throw std::runtime_error("Error: No encoded image data to decode.");
+    }
+    data = stbi_load_from_memory(encoded, static_cast<int>(size), &width, &height, &channels, 0);
+    if (!data) {
+        throw std::runtime_error("Failed to decode image from memory: " + std::string(stbi_failure_reason()));
+    }
+}
+
 /**
  * @brief Constructs an Image object from raw image data.
  * 
@@ -40,7 +154,11 @@ Image::Image(const char* filepath) {
  */
 Image::Image(unsigned char* input, int w, int h, int c) 
     : width(w), height(h), channels(c) {
-    data = new unsigned char[w * h * c];
+    // malloc rather than new[]: the destructor releases data with stbi_image_free (free)
+    data = static_cast<unsigned char*>(std::malloc(static_cast<size_t>(w) * h * c));
+    if (!data) {
+        throw std::runtime_error("Error: Failed to allocate image data.");
+    }
     std::copy(input, input + (w * h * c), data);
 }
 
@@ -54,22 +172,186 @@ Image::~Image() {
 }
 
 /**
- * @brief Writes an image to a file in PNG format.
+ * @brief Writes an image to a file with default encoder settings.
  * 
  * @param img The image object to write.
- * @param filepath The path where the image should be saved.
+ * @param filepath The path where the image should be saved; the extension picks the format.
  * 
  * @throws std::runtime_error If writing the image fails.
  */
 void Image::WriteImage(const Image& img, const char* filepath) {
+    WriteImage(img, filepath, ImageWriteOptions{});
+}
+
+/**
+ * @brief Writes an image to a file, choosing the format from the extension.
+ * 
+ * @param img The image object to write.
+ * @param filepath The path where the image should be saved.
+ * @param options JPEG quality and PNG compression settings.
+ * 
+ * @throws std::runtime_error If writing the image fails.
+ */
+void Image::WriteImage(const Image& img, const char* filepath, const ImageWriteOptions& options) {
     if (!img.data) {
         throw std::runtime_error("Error: No image data to save.");
     }
-    int success = stbi_write_png(filepath, img.width, img.height, img.channels, img.data, 0); // why 0?
+    WriteImage(img.data, img.width, img.height, img.channels, filepath, options);
+    std::cout << "Successfully exported transformed image to " + std::string(filepath) << std::endl;
+}
+
+/**
+ * @brief Encodes an image and hands the bytes to a callback instead of a file.
+ * 
+ * @param img The image object to encode.
+ * @param func Receives the encoded bytes.
+ * @param context Passed through to func.
+ * @param options Encoder settings; options.format picks the format (PNG if empty).
+ * 
+ * @throws std::runtime_error If encoding fails.
+ */
+void Image::WriteImage(const Image& img, ImageWriteFunc func, void* context, const ImageWriteOptions& options) {
+    if (!img.data || !func) {
+        throw std::runtime_error("Error: No image data or output callback.");
+    }
+    std::vector<unsigned char> encoded =
+        EncodeImage(img.data, img.width, img.height, img.channels, options.format.empty() ? "png" : options.format,
+                    options);
+    func(context, encoded.data(), static_cast<int>(encoded.size()));
+}
+
+/**
+ * @brief Encodes raw interleaved 8-bit pixels in memory.
+ * 
+ * PNG goes through PngEncoder (parallel deflate when built with zlib), JPEG/BMP/TGA
+ * through stb_image_write. Unknown formats are encoded as PNG with a warning.
+ * Single-channel data is encoded as greyscale, without expanding it to RGB.
+ * 
+ * @param data Pixel data, w * h * c bytes.
+ * @param w Width.
+ * @param h Height.
+ * @param c Channels (1-4).
+ * @param format "png", "jpg"/"jpeg", "bmp" or "tga" (any case).
+ * @param options JPEG quality and PNG compression settings.
+ * @return The encoded file contents.
+ * 
+ * @throws std::runtime_error If encoding fails.
+ */
+std::vector<unsigned char> Image::EncodeImage(const unsigned char* data, int w, int h, int c,
+                                              const std::string& format, const ImageWriteOptions& options) {
+    if (!data) {
+        throw std::runtime_error("Error: No image data to encode.");
+    }
+
+    std::string ext = format;
+    for (char& ch : ext) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    std::vector<unsigned char> encoded;
+    int success = 1;
+    if (ext == "jpg" || ext == "jpeg") {
+        int quality = std::clamp(options.jpegQuality, 1, 100);
+        success = stbi_write_jpg_to_func(appendToVector, &encoded, w, h, c, data, quality);
+    } else if (ext == "bmp") {
+        success = stbi_write_bmp_to_func(appendToVector, &encoded, w, h, c, data);
+    } else if (ext == "tga") {
+        success = stbi_write_tga_to_func(appendToVector, &encoded, w, h, c, data);
+    } else {
+        if (ext != "png") {
+            std::cerr << "[WARN] Unknown output format \"" << ext << "\" (writing PNG)\n";
+        }
+        encoded = PngEncoder::encode(data, w, h, c, options.pngCompression, options.pngFilter);
+    }
     if (!success) {
+        throw std::runtime_error("Error: Failed to encode " + ext + " image.");
+    }
+    return encoded;
+}
+
+/**
+ * @brief Encodes raw interleaved 16-bit samples in memory as a 16-bit PNG.
+ * 
+ * Only PNG stores 16 bits per sample; other formats get the samples rounded to 8 bits
+ * with a warning.
+ * 
+ * @return The encoded file contents.
+ * @throws std::runtime_error If encoding fails.
+ */
+std::vector<unsigned char> Image::EncodeImage16(const std::uint16_t* data, int w, int h, int c,
+                                                const std::string& format, const ImageWriteOptions& options) {
+    if (!data) {
+        throw std::runtime_error("Error: No image data to encode.");
+    }
+
+    std::string ext = format;
+    for (char& ch : ext) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    if (ext != "png") {
+        std::cerr << "[WARN] 16-bit output needs PNG; writing 8 bits as " << ext << "\n";
+        const size_t count = static_cast<size_t>(w) * h * c;
+        std::vector<unsigned char> narrow(count);
+        for (size_t i = 0; i < count; ++i) {
+            narrow[i] = static_cast<unsigned char>((data[i] + 128) / 257);
+        }
+        return EncodeImage(narrow.data(), w, h, c, ext, options);
+    }
+    return PngEncoder::encode16(data, w, h, c, options.pngCompression, options.pngFilter);
+}
+
+/**
+ * @brief Writes raw interleaved 8-bit pixels, choosing the format from the extension.
+ * 
+ * The whole file is encoded in memory (EncodeImage) and written with a single call.
+ * 
+ * @param data Pixel data, w * h * c bytes.
+ * @param w Width.
+ * @param h Height.
+ * @param c Channels (1-4).
+ * @param filepath The path where the image should be saved ("-" for standard output).
+ * @param options JPEG quality and PNG compression settings.
+ * 
+ * @throws std::runtime_error If writing the image fails.
+ */
+void Image::WriteImage(const unsigned char* data, int w, int h, int c, const char* filepath,
+                       const ImageWriteOptions& options) {
+    if (!data) {
+        throw std::runtime_error("Error: No image data to save.");
+    }
+    Trace::Scope span("io", "write", filepath);
+    std::vector<unsigned char> encoded = EncodeImage(data, w, h, c, outputFormat(filepath, options), options);
+    span.addBytes(static_cast<std::size_t>(w) * h * c + encoded.size());
+    if (!writeFile(filepath, encoded)) {
+        throw std::runtime_error("Error: Failed to write image to " + std::string(filepath));
+    }
+}
+
+/**
+ * @brief Writes raw interleaved 16-bit samples as a 16-bit PNG.
+ * 
+ * Only PNG stores 16 bits per sample; for other formats the samples are rounded
+ * to 8 bits with a warning.
+ * 
+ * @param data Samples, w * h * c values.
+ * @param w Width.
+ * @param h Height.
+ * @param c Channels (1-4).
+ * @param filepath The path where the image should be saved ("-" for standard output).
+ * @param options PNG compression settings.
+ * 
+ * @throws std::runtime_error If writing the image fails.
+ */
+void Image::WriteImage16(const std::uint16_t* data, int w, int h, int c, const char* filepath,
+                         const ImageWriteOptions& options) {
+    if (!data) {
+        throw std::runtime_error("Error: No image data to save.");
+    }
+    Trace::Scope span("io", "write", filepath);
+    std::vector<unsigned char> encoded = EncodeImage16(data, w, h, c, outputFormat(filepath, options), options);
+    span.addBytes(static_cast<std::size_t>(w) * h * c * sizeof(std::uint16_t) + encoded.size());
+    if (!writeFile(filepath, encoded)) {
         throw std::runtime_error("Error: Failed to write image to " + std::string(filepath));
     }
-    std::cout << "Successfully exported transformed image to " + std::string(filepath) << std::endl;
 }
 
 /**
@@ -87,6 +369,36 @@ void Image::setData(const unsigned char* newData) {
     std::copy(newData, newData + (width * height * channels), data);
 }
 
+/**
+ * @brief Replaces the image data with a buffer of different dimensions.
+ * 
+ * @param newData Pointer to the new image data (w * h * c bytes).
+ * @param w New image width.
+ * @param h New image height.
+ * @param c New number of channels.
+ * 
+ * @throws std::runtime_error If newData is null.
+ */
+void Image::setData(const unsigned char* newData, int w, int h, int c) {
+    if (!newData) {
+        throw std::runtime_error("Error: Attempted to set null image data.");
+    }
+
+    // Allocate with malloc so the destructor's stbi_image_free (free) matches
+    unsigned char* buffer = static_cast<unsigned char*>(std::malloc(static_cast<size_t>(w) * h * c));
+    if (!buffer) {
+        throw std::runtime_error("Error: Failed to allocate image data.");
+    }
+    std::copy(newData, newData + static_cast<size_t>(w) * h * c, buffer);
+    if (data) {
+        stbi_image_free(data);
+    }
+    data = buffer;
+    width = w;
+    height = h;
+    channels = c;
+}
+
 /**
  * @brief Sets the number of channels in the image.
  * 
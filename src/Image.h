@@ -14,19 +14,55 @@
 #ifndef IMAGE_H
 #define IMAGE_H
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Encoder settings for Image::WriteImage. The output format itself is chosen
+ *        from the file extension (.png, .jpg/.jpeg, .bmp, .tga) unless format is set.
+ *
+ * The path "-" stands for standard output; it is written as PNG unless format says
+ * otherwise.
+ */
+struct ImageWriteOptions {
+    int jpegQuality = 90;      ///< JPEG quality, 1-100
+    int pngCompression = -1;   ///< PNG deflate level 0-9, -1 for the encoder default
+    int pngFilter = -1;        ///< PNG scanline filter 0-4 (None..Paeth), -1 for adaptive
+    int bitDepth = 0;          ///< 8 or 16 forces the depth of volume outputs, 0 follows the voxel type
+    std::string format;        ///< "png", "jpg", "bmp" or "tga" overrides the extension ("" = from the path)
+};
+
+// Receives encoded bytes, possibly in several calls (the stbi_write_func signature)
+using ImageWriteFunc = void (*)(void* context, void* data, int size);
+
 class Image {
     public:
         Image(const char* filepath);
         Image(unsigned char* input, int w, int h, int c);
+        Image(const unsigned char* encoded, std::size_t size);
         ~Image();
         
         static void WriteImage(const Image& img, const char* filepath);
+        static void WriteImage(const Image& img, const char* filepath, const ImageWriteOptions& options);
+        static void WriteImage(const unsigned char* data, int w, int h, int c, const char* filepath,
+                               const ImageWriteOptions& options);
+        static void WriteImage16(const std::uint16_t* data, int w, int h, int c, const char* filepath,
+                                 const ImageWriteOptions& options);
+
+        static std::vector<unsigned char> EncodeImage(const unsigned char* data, int w, int h, int c,
+                                                      const std::string& format, const ImageWriteOptions& options);
+        static std::vector<unsigned char> EncodeImage16(const std::uint16_t* data, int w, int h, int c,
+                                                        const std::string& format, const ImageWriteOptions& options);
+        static void WriteImage(const Image& img, ImageWriteFunc func, void* context, const ImageWriteOptions& options);
         
         int getWidth() const { return width; }
         int getHeight() const { return height; }
         int getChannels() const { return channels; }
         const unsigned char* getData() const { return data; }
         void setData(const unsigned char* newData); 
+        void setData(const unsigned char* newData, int w, int h, int c);
         void setChannels(int newChannels); 
 
     private:
@@ -0,0 +1,86 @@
+/*
+ * @file Parallel.h
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Minimal fork/join helpers shared by the filters.
+ *
+ * Work is split into contiguous bands (usually image rows or tiles) and each band is
+ * handed to its own std::thread. On a single-core machine, or when there is only one
+ * band, everything runs inline on the calling thread. Nested calls made from inside a
+ * band also run inline, so per-item work that is itself parallel (e.g. PNG encoding)
+ * does not multiply the thread count when the items are already spread over threads.
+ */
+namespace Parallel {
+
+/**
+ * @brief True while the current thread is running a band of an outer forBands().
+ */
+inline thread_local bool inBand = false;
+
+/**
+ * @brief Number of worker threads to use (at least 1).
+ */
+inline int threadCount() {
+    unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : static_cast<int>(n);
+}
+
+/**
+ * @brief Runs fn(bandBegin, bandEnd) over [begin, end) split into at most threadCount() bands.
+ *
+ * @param begin First index of the range.
+ * @param end One past the last index of the range.
+ * @param fn Callable taking (int bandBegin, int bandEnd).
+ * @param minBand Smallest band worth giving to a thread, to avoid spawning for tiny ranges.
+ */
+template <typename Fn>
+void forBands(int begin, int end, Fn&& fn, int minBand = 1) {
+    const int total = end - begin;
+    if (total <= 0) {
+        return;
+    }
+    int bands = inBand ? 1 : std::min(threadCount(), std::max(1, total / std::max(1, minBand)));
+    if (bands <= 1) {
+        fn(begin, end);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(bands - 1);
+    const int step = (total + bands - 1) / bands;
+    for (int b = begin + step; b < end; b += step) {
+        const int e = std::min(b + step, end);
+        workers.emplace_back([&fn, b, e]() {
+            inBand = true;
+            fn(b, e);
+        });
+    }
+    // The calling thread takes the first band itself
+    inBand = true;
+    fn(begin, std::min(begin + step, end));
+    inBand = false;
+    for (auto& t : workers) {
+        t.join();
+    }
+}
+
+} // namespace Parallel
+
+#endif // PARALLEL_H
@@ -0,0 +1,316 @@
+/*
+ * @file PngEncoder.cpp
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#include "PngEncoder.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef APIMAGE_HAVE_ZLIB
+#include <zlib.h>
+#else
+// Defined (extern "C") by the stb_image_write implementation but not declared in its header
+extern "C" unsigned char* stbi_zlib_compress(unsigned char* data, int data_len, int* out_len, int quality);
+#endif
+
+namespace {
+
+constexpr size_t kIdatBytes = 1 << 20;       // split IDAT so no chunk gets huge
+
+int paeth(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) return a;
+    return pb <= pc ? b : c;
+}
+
+/**
+ * @brief Writes one filtered scanline (without the leading filter byte).
+ * @param bpp Bytes per complete pixel (channels * bytes per sample).
+ */
+void filterRow(int type, const unsigned char* row, const unsigned char* prev, int bytes, int bpp,
+               unsigned char* out) {
+    for (int i = 0; i < bytes; ++i) {
+        const int left = i >= bpp ? row[i - bpp] : 0;
+        const int up = prev[i];
+        const int upLeft = i >= bpp ? prev[i - bpp] : 0;
+        int predictor = 0;
+        switch (type) {
+            case PngEncoder::Sub:     predictor = left; break;
+            case PngEncoder::Up:      predictor = up; break;
+            case PngEncoder::Average: predictor = (left + up) >> 1; break;
+            case PngEncoder::Paeth:   predictor = paeth(left, up, upLeft); break;
+            default:                  predictor = 0; break;
+        }
+        out[i] = static_cast<unsigned char>(row[i] - predictor);
+    }
+}
+
+/**
+ * @brief Filters every scanline into the PNG byte layout (filter byte + row).
+ *
+ * Adaptive mode uses the usual heuristic: pick the filter whose output has the
+ * smallest sum of absolute values when read as signed bytes.
+ */
+void filterImage(const unsigned char* data, int rowBytes, int height, int bpp, int filter,
+                 std::vector<unsigned char>& filtered) {
+    filtered.resize(static_cast<size_t>(height) * (rowBytes + 1));
+    const std::vector<unsigned char> zeros(rowBytes, 0);
+
+    Parallel::forBands(0, height, [&](int yBegin, int yEnd) {
+        std::vector<unsigned char> trial(rowBytes);
+        for (int y = yBegin; y < yEnd; ++y) {
+            const unsigned char* row = data + static_cast<size_t>(y) * rowBytes;
+            const unsigned char* prev = y > 0 ? row - rowBytes : zeros.data();
+            unsigned char* out = filtered.data() + static_cast<size_t>(y) * (rowBytes + 1);
+
+            int best = filter;
+            if (filter == PngEncoder::Adaptive) {
+                long bestScore = -1;
+                for (int type = PngEncoder::None; type <= PngEncoder::Paeth; ++type) {
+                    filterRow(type, row, prev, rowBytes, bpp, trial.data());
+                    long score = 0;
+                    for (unsigned char v : trial) {
+                        score += std::abs(static_cast<int>(static_cast<signed char>(v)));
+                    }
+                    if (bestScore < 0 || score < bestScore) {
+                        bestScore = score;
+                        best = type;
+                    }
+                }
+            }
+            out[0] = static_cast<unsigned char>(best);
+            filterRow(best, row, prev, rowBytes, bpp, out + 1);
+        }
+    }, 16);
+}
+
+void putBigEndian(std::vector<unsigned char>& out, std::uint32_t v) {
+    out.push_back(static_cast<unsigned char>(v >> 24));
+    out.push_back(static_cast<unsigned char>(v >> 16));
+    out.push_back(static_cast<unsigned char>(v >> 8));
+    out.push_back(static_cast<unsigned char>(v));
+}
+
+#ifdef APIMAGE_HAVE_ZLIB
+constexpr size_t kChunkBytes = 128 * 1024;  // filtered bytes per deflate job
+constexpr size_t kWindowBytes = 32 * 1024;   // deflate window, used to prime each chunk
+
+std::uint32_t chunkCrc(const unsigned char* data, size_t size) {
+    return static_cast<std::uint32_t>(crc32(0L, data, static_cast<uInt>(size)));
+}
+
+/**
+ * @brief Raw-deflates one chunk of the filtered stream.
+ *
+ * @param dictionary Up to 32 KiB preceding the chunk (empty for the first chunk).
+ * @param last True for the final chunk, which closes the deflate stream.
+ */
+std::vector<unsigned char> deflateChunk(const unsigned char* input, size_t size,
+                                        const unsigned char* dictionary, size_t dictSize,
+                                        int level, int strategy, bool last) {
+    z_stream zs{};
+    if (deflateInit2(&zs, level, Z_DEFLATED, -15, 8, strategy) != Z_OK) {
+        throw std::runtime_error("Error: deflateInit2 failed.");
+    }
+    if (dictSize > 0) {
+        deflateSetDictionary(&zs, dictionary, static_cast<uInt>(dictSize));
+    }
+
+    // deflateBound covers Z_FINISH; a sync flush adds at most a few more bytes
+    std::vector<unsigned char> out(deflateBound(&zs, static_cast<uLong>(size)) + 16);
+    zs.next_in = const_cast<Bytef*>(input);
+    zs.avail_in = static_cast<uInt>(size);
+    zs.next_out = out.data();
+    zs.avail_out = static_cast<uInt>(out.size());
+    int status = deflate(&zs, last ? Z_FINISH : Z_SYNC_FLUSH);
+    const bool ok = last ? status == Z_STREAM_END : (status == Z_OK && zs.avail_in == 0);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    if (!ok) {
+        throw std::runtime_error("Error: deflate failed while encoding PNG.");
+    }
+    return out;
+}
+
+/**
+ * @brief Builds the zlib stream for the filtered scanlines, one deflate job per chunk.
+ */
+std::vector<unsigned char> compress(const std::vector<unsigned char>& filtered, int level, int filter) {
+    const size_t total = filtered.size();
+    const int chunks = static_cast<int>((total + kChunkBytes - 1) / kChunkBytes);
+    const int strategy = filter == PngEncoder::None ? Z_DEFAULT_STRATEGY : Z_FILTERED;
+    std::vector<std::vector<unsigned char>> compressed(chunks);
+    std::vector<uLong> adlers(chunks);
+
+    Parallel::forBands(0, chunks, [&](int cBegin, int cEnd) {
+        for (int c = cBegin; c < cEnd; ++c) {
+            const size_t begin = static_cast<size_t>(c) * kChunkBytes;
+            const size_t size = std::min(kChunkBytes, total - begin);
+            const size_t dictSize = std::min(begin, kWindowBytes);
+            compressed[c] = deflateChunk(filtered.data() + begin, size,
+                                         filtered.data() + begin - dictSize, dictSize,
+                                         level, strategy, c == chunks - 1);
+            adlers[c] = adler32(adler32(0L, Z_NULL, 0), filtered.data() + begin, static_cast<uInt>(size));
+        }
+    });
+
+    // zlib stream: header, concatenated raw deflate chunks, combined Adler-32
+    std::vector<unsigned char> zlibStream;
+    const int flevel = level < 0 ? 2 : level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+    const int cmf = 0x78;
+    int flg = flevel << 6;
+    flg += 31 - ((cmf * 256 + flg) % 31);
+    zlibStream.push_back(static_cast<unsigned char>(cmf));
+    zlibStream.push_back(static_cast<unsigned char>(flg));
+    uLong adler = adlers.empty() ? adler32(0L, Z_NULL, 0) : adlers[0];
+    for (int c = 0; c < chunks; ++c) {
+        zlibStream.insert(zlibStream.end(), compressed[c].begin(), compressed[c].end());
+        if (c > 0) {
+            const size_t size = std::min(kChunkBytes, total - static_cast<size_t>(c) * kChunkBytes);
+            adler = adler32_combine(adler, adlers[c], static_cast<z_off_t>(size));
+        }
+    }
+    putBigEndian(zlibStream, static_cast<std::uint32_t>(adler));
+    return zlibStream;
+}
+#else
+std::uint32_t chunkCrc(const unsigned char* data, size_t size) {
+    static std::uint32_t table[256];
+    static const bool ready = [] {
+        for (std::uint32_t n = 0; n < 256; ++n) {
+            std::uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        return true;
+    }();
+    (void)ready;
+
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * @brief Builds the zlib stream with stb_image_write's (single-threaded) deflate.
+ */
+std::vector<unsigned char> compress(const std::vector<unsigned char>& filtered, int level, int /*filter*/) {
+    int length = 0;
+    unsigned char* zlibData = stbi_zlib_compress(const_cast<unsigned char*>(filtered.data()),
+                                                 static_cast<int>(filtered.size()), &length,
+                                                 level < 0 ? 8 : std::max(level, 1));
+    if (!zlibData) {
+        throw std::runtime_error("Error: Failed to compress PNG data.");
+    }
+    std::vector<unsigned char> zlibStream(zlibData, zlibData + length);
+    std::free(zlibData);
+    return zlibStream;
+}
+#endif
+
+void putChunk(std::vector<unsigned char>& out, const char* type, const unsigned char* payload, size_t size) {
+    putBigEndian(out, static_cast<std::uint32_t>(size));
+    const size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), payload, payload + size);
+    putBigEndian(out, chunkCrc(out.data() + start, size + 4));
+}
+
+/**
+ * @brief Filters, compresses and wraps big-endian samples in a PNG container.
+ */
+std::vector<unsigned char> encodeSamples(const unsigned char* samples, int width, int height, int channels,
+                                         int bitDepth, int level, int filter) {
+    if (!samples || width <= 0 || height <= 0 || channels < 1 || channels > 4) {
+        throw std::runtime_error("Error: Invalid image passed to the PNG encoder.");
+    }
+    level = std::clamp(level, -1, 9);
+    if (filter < PngEncoder::Adaptive || filter > PngEncoder::Paeth) {
+        filter = PngEncoder::Adaptive;
+    }
+
+    const int bpp = channels * bitDepth / 8;
+    std::vector<unsigned char> filtered;
+    filterImage(samples, width * bpp, height, bpp, filter, filtered);
+    std::vector<unsigned char> zlibStream = compress(filtered, level, filter);
+
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    static const unsigned char colorTypes[5] = { 0, 0, 4, 2, 6 };
+    std::vector<unsigned char> png(signature, signature + 8);
+
+    std::vector<unsigned char> header;
+    putBigEndian(header, static_cast<std::uint32_t>(width));
+    putBigEndian(header, static_cast<std::uint32_t>(height));
+    header.push_back(static_cast<unsigned char>(bitDepth));
+    header.push_back(colorTypes[channels]); // colour type
+    header.push_back(0);                    // compression
+    header.push_back(0);                    // filter method
+    header.push_back(0);                    // no interlace
+    putChunk(png, "IHDR", header.data(), header.size());
+
+    for (size_t offset = 0; offset < zlibStream.size(); offset += kIdatBytes) {
+        putChunk(png, "IDAT", zlibStream.data() + offset, std::min(kIdatBytes, zlibStream.size() - offset));
+    }
+    putChunk(png, "IEND", nullptr, 0);
+    return png;
+}
+
+} // namespace
+
+/**
+ * @brief Encodes 8-bit pixels to PNG.
+ */
+std::vector<unsigned char> PngEncoder::encode(const unsigned char* data, int width, int height, int channels,
+                                              int level, int filter) {
+    return encodeSamples(data, width, height, channels, 8, level, filter);
+}
+
+/**
+ * @brief Encodes 16-bit pixels to PNG; samples are stored big-endian as PNG requires.
+ */
+std::vector<unsigned char> PngEncoder::encode16(const std::uint16_t* data, int width, int height, int channels,
+                                                int level, int filter) {
+    if (!data) {
+        throw std::runtime_error("Error: Invalid image passed to the PNG encoder.");
+    }
+    const size_t count = static_cast<size_t>(width) * height * channels;
+    std::vector<unsigned char> samples(count * 2);
+    for (size_t i = 0; i < count; ++i) {
+        samples[2 * i] = static_cast<unsigned char>(data[i] >> 8);
+        samples[2 * i + 1] = static_cast<unsigned char>(data[i] & 0xFF);
+    }
+    return encodeSamples(samples.data(), width, height, channels, 16, level, filter);
+}
+
+/**
+ * @brief Converts a filter name to a PngEncoder::Filter value.
+ */
+int PngEncoder::GetFilter(const std::string& name) {
+    if (name == "None") return None;
+    if (name == "Sub") return Sub;
+    if (name == "Up") return Up;
+    if (name == "Average") return Average;
+    if (name == "Paeth") return Paeth;
+    if (name != "Adaptive") {
+        std::cerr << "[WARN] Unknown PNG filter: " << name << " (defaulting to Adaptive)\n";
+    }
+    return Adaptive;
+}
@@ -0,0 +1,84 @@
+/*
+ * @file PngEncoder.h
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#ifndef PNG_ENCODER_H
+#define PNG_ENCODER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class PngEncoder
+ * @brief Encodes 8- and 16-bit images to PNG in memory.
+ *
+ * When built with zlib (APIMAGE_HAVE_ZLIB), scanlines are filtered in parallel and the
+ * filtered stream is cut into ~128 KiB chunks that are deflated on separate threads.
+ * Each chunk is primed with the previous 32 KiB as a dictionary and ends on a sync
+ * flush, so the concatenation is one valid zlib stream (the pigz approach), and the
+ * Adler-32 checksums are combined rather than recomputed. Without zlib the filtered
+ * stream is compressed with stb_image_write's built-in deflate instead.
+ */
+class PngEncoder {
+public:
+    /**
+     * @brief Scanline filter selection; Adaptive picks the best filter per row.
+     */
+    enum Filter {
+        Adaptive = -1,
+        None = 0,
+        Sub = 1,
+        Up = 2,
+        Average = 3,
+        Paeth = 4
+    };
+
+    /**
+     * @brief Encodes pixels to a complete PNG file image.
+     *
+     * @param data Interleaved 8-bit pixels, width * height * channels bytes.
+     * @param width Image width.
+     * @param height Image height.
+     * @param channels 1 (grey), 2 (grey + alpha), 3 (RGB) or 4 (RGBA).
+     * @param level Deflate level 0-9, or -1 for the library default.
+     * @param filter Scanline filter (default Adaptive).
+     * @return The PNG bytes.
+     * @throws std::runtime_error If encoding fails.
+     */
+    static std::vector<unsigned char> encode(const unsigned char* data, int width, int height, int channels,
+                                             int level = -1, int filter = Adaptive);
+
+    /**
+     * @brief Encodes 16-bit samples (host byte order) to a 16-bit PNG.
+     *
+     * @param data Interleaved samples, width * height * channels values.
+     * @param width Image width.
+     * @param height Image height.
+     * @param channels 1 (grey), 2 (grey + alpha), 3 (RGB) or 4 (RGBA).
+     * @param level Deflate level 0-9, or -1 for the library default.
+     * @param filter Scanline filter (default Adaptive).
+     * @return The PNG bytes.
+     * @throws std::runtime_error If encoding fails.
+     */
+    static std::vector<unsigned char> encode16(const std::uint16_t* data, int width, int height, int channels,
+                                               int level = -1, int filter = Adaptive);
+
+    /**
+     * @brief Converts a filter name ("None", "Sub", "Up", "Average", "Paeth", "Adaptive").
+     * @param name The filter name.
+     * @return The matching filter; unknown names warn and fall back to Adaptive.
+     */
+    static int GetFilter(const std::string& name);
+};
+
+#endif // PNG_ENCODER_H
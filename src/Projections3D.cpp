@@ -12,46 +12,148 @@
  */
 
 #include "Projections3D.h"
+#include "Parallel.h"
+#include "Slicing3D.h"
+#include "BrickGrid.h"
 #include <iostream>
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 
-#include "stb_image_write.h"
+
+namespace {
+
+// Sums along z: 64-bit integers for integer voxels (no overflow even for deep
+// 16-bit volumes), double for float voxels
+template <typename T>
+using AccumType = std::conditional_t<std::is_floating_point_v<T>, double, unsigned long long>;
+
+/**
+ * @brief Max (Max = true) or min of slices [z0, z1] into out, which holds the start values.
+ *
+ * Without bricks every slice is streamed through in order. With a grid that covers the
+ * volume, the image is walked in brick-sized tiles (tile rows in parallel): a brick is
+ * skipped when its range cannot beat any pixel of its tile so far, i.e. its max is at
+ * most the tile's smallest running maximum (largest running minimum for MinIP).
+ * Background bricks then cost one comparison and the result is unchanged.
+ */
+template <typename T, bool Max>
+void extremeOverSlices(const BasicVolume<T> &vol, int z0, int z1, const BrickGrid *bricks, std::vector<T> &out)
+{
+    auto better = [](T a, T b) { return Max ? std::max(a, b) : std::min(a, b); };
+    const int channels = vol.channels;
+    const size_t rowLen = (size_t)vol.width * channels;
+    const size_t plane = rowLen * vol.height;
+
+    if (!bricks || !bricks->covers(vol)) {
+        // Channels are interleaved and slices are contiguous, so each slice is one flat
+        // block of w * h * channels samples that is streamed through in order
+        for (int z = z0; z <= z1; ++z) {
+            const T *slice = vol.data.data() + plane * z;
+            for (size_t i = 0; i < plane; ++i) {
+                out[i] = better(out[i], slice[i]);
+            }
+        }
+        return;
+    }
+
+    const int B = bricks->size();
+    Parallel::forBands(0, bricks->bricksY(), [&](int byBegin, int byEnd) {
+        for (int by = byBegin; by < byEnd; ++by) {
+            const int y0 = by * B, y1 = std::min(y0 + B, vol.height);
+            for (int bx = 0; bx < bricks->bricksX(); ++bx) {
+                const size_t i0 = (size_t)(bx * B) * channels;
+                const size_t i1 = (size_t)std::min(bx * B + B, vol.width) * channels;
+                // The value every pixel of the tile already matches or beats
+                auto tileBound = [&]() {
+                    T bound = out[y0 * rowLen + i0];
+                    for (int y = y0; y < y1; ++y) {
+                        for (size_t i = i0; i < i1; ++i) {
+                            bound = Max ? std::min(bound, out[y * rowLen + i]) : std::max(bound, out[y * rowLen + i]);
+                        }
+                    }
+                    return static_cast<float>(bound);
+                };
+                float bound = tileBound();
+                for (int bz = z0 / B; bz <= z1 / B; ++bz) {
+                    if (Max ? bricks->maxAt(bx, by, bz) <= bound : bricks->minAt(bx, by, bz) >= bound) {
+                        continue;
+                    }
+                    for (int z = std::max(z0, bz * B); z <= std::min(z1, bz * B + B - 1); ++z) {
+                        for (int y = y0; y < y1; ++y) {
+                            const T *row = vol.data.data() + plane * z + y * rowLen;
+                            T *dst = out.data() + y * rowLen;
+                            for (size_t i = i0; i < i1; ++i) {
+                                dst[i] = better(dst[i], row[i]);
+                            }
+                        }
+                    }
+                    bound = tileBound();
+                }
+            }
+        }
+    }, 1);
+}
 
 /**
- * @brief Writes an 8-bit grayscale image to a PNG file.
+ * @brief Median of slices [z0, z1] for every pixel and channel (the mean of the two
+ *        middle values for an even count).
+ */
+template <typename T>
+void medianOverSlices(const BasicVolume<T> &vol, int z0, int z1, std::vector<T> &out)
+{
+    const size_t plane = (size_t)vol.width * vol.height * vol.channels;
+    const int d = z1 - z0 + 1;
+    std::vector<T> vals(d);
+    for (size_t i = 0; i < plane; ++i) {
+        // Collect intensity values along z
+        for (int z = 0; z < d; ++z) {
+            vals[z] = vol.data[i + plane * (z0 + z)];
+        }
+        std::sort(vals.begin(), vals.end());
+        if (d % 2 == 1) {
+            out[i] = vals[d / 2];
+        } else {
+            // safe integer average of the two middle values
+            out[i] = static_cast<T>((static_cast<AccumType<T>>(vals[(d / 2) - 1]) + vals[d / 2]) / 2);
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Writes a grayscale (or interleaved multi-channel) projection to a file.
  * 
- * @param filename The name of the output PNG file.
+ * Goes through the same writer as Image::WriteImage, so the output format follows the
+ * extension and the PNG encoder settings apply. 8-bit buffers give an 8-bit file,
+ * 16-bit and float buffers a 16-bit PNG, unless options.bitDepth forces a depth.
+ * 
+ * @param filename The name of the output file.
  * @param buffer Pointer to the grayscale image data.
  * @param width Width of the image.
  * @param height Height of the image.
+ * @param channels Interleaved channels per pixel.
+ * @param options Encoder settings.
  * @return True if the image was successfully written, false otherwise.
  */
+template <typename T>
 bool Projections3D::writeGrayPNG(const std::string &filename,
-    const unsigned char *buffer,
+    const T *buffer,
     int width,
-    int height)
+    int height,
+    int channels,
+    const ImageWriteOptions &options)
 {
-    // Will replicate 'buffer' (which is grayscale) into R,G,B
-    // Create an std::vector to hold 3 * width * height
-    std::vector<unsigned char> rgb(3 * width * height);
-
-    for (int i = 0; i < width * height; ++i) {
-        unsigned char g = buffer[i]; // grayscale intensity
-        rgb[3*i + 0] = g; // R
-        rgb[3*i + 1] = g; // G
-        rgb[3*i + 2] = g; // B
-    }
-
-    // Now call stbi_write_png with 3 channels
-    int stride_in_bytes = 3 * width;
-    int success = stbi_write_png(filename.c_str(),
-        width,
-        height,
-        /*channels=*/3,
-        rgb.data(),
-        stride_in_bytes);
-
-    return (success != 0);
+    try {
+        writeVoxelPlane(buffer, width, height, channels, filename, options);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return false;
+    }
+    return true;
 }
 
 /**
@@ -59,12 +161,13 @@ bool Projections3D::writeGrayPNG(const std::string &filename,
  * 
  * @param vol The input 3D volume.
  * @param outFilename The output file name for the generated projection.
+ * @param options Encoder settings.
+ * @param bricks Optional brick grid of vol; bricks that cannot raise the maximum are skipped.
  */
-void Projections3D::MIP(const Volume &vol, const std::string &outFilename)
+template <typename T>
+void Projections3D::MIP(const BasicVolume<T> &vol, const std::string &outFilename,
+                        const ImageWriteOptions &options, const BrickGrid *bricks)
 {
-    // now taking: vol.channels == 1 !!! (grayscale)
-    // If have multi-channel data, need to e.g. look at volume.data[ x + w*( y + h*z)*channels ].
-
     int w = vol.width;
     int h = vol.height;
     int d = vol.depth;
@@ -73,27 +176,15 @@ void Projections3D::MIP(const Volume &vol, const std::string &outFilename)
         return;
     }    
 
-    // will produce a 2D image of size w*h, each pixel an 8-bit intensity
-    // so allocate w*h bytes in a buffer
-    std::vector<unsigned char> output(w * h, 0); // zero-init
-
-    // MIP, so: for each (x,y), look across z in [0..d-1], find maximum
-    for (int y = 0; y < h; ++y) {
-        for (int x = 0; x < w; ++x) {
-            unsigned char maxVal = 0;
-            for (int z = 0; z < d; ++z) {
-                size_t idx = (size_t)x + (size_t)w * ((size_t)y + (size_t)h * z);
-                unsigned char val = vol.data[idx];
-                if (val > maxVal) {
-                    maxVal = val;
-                }
-            }
-            output[x + w * y] = maxVal;
-        }
-    }
+    // will produce a 2D image of size w*h with the volume's channels
+    const size_t plane = (size_t)w * h * vol.channels;
+    std::vector<T> output(plane, std::numeric_limits<T>::lowest());
+
+    // MIP, so: for each (x,y) and channel, look across z in [0..d-1], find maximum
+    extremeOverSlices<T, true>(vol, 0, d - 1, bricks, output);
 
     // Now write out the resulting 2D buffer as a PNG
-    if (!writeGrayPNG(outFilename, output.data(), w, h)) {
+    if (!writeGrayPNG(outFilename, output.data(), w, h, vol.channels, options)) {
         std::cerr << "Failed to write MIP to " << outFilename << std::endl;
     }
 }
@@ -103,30 +194,22 @@ void Projections3D::MIP(const Volume &vol, const std::string &outFilename)
  * 
  * @param vol The input 3D volume.
  * @param outFilename The output file name for the generated projection.
+ * @param options Encoder settings.
+ * @param bricks Optional brick grid of vol; bricks that cannot lower the minimum are skipped.
  */
-void Projections3D::MinIP(const Volume &vol, const std::string &outFilename)
+template <typename T>
+void Projections3D::MinIP(const BasicVolume<T> &vol, const std::string &outFilename,
+                          const ImageWriteOptions &options, const BrickGrid *bricks)
 {
     int w = vol.width;
     int h = vol.height;
     int d = vol.depth;
 
-    std::vector<unsigned char> output(w * h, 255); // start with all 255
-
-    for (int y = 0; y < h; ++y) {
-        for (int x = 0; x < w; ++x) {
-            unsigned char minVal = 255;
-            for (int z = 0; z < d; ++z) {
-                size_t idx = (size_t)x + (size_t)w * ((size_t)y + (size_t)h * z);
-                unsigned char val = vol.data[idx];
-                if (val < minVal) {
-                    minVal = val;
-                }
-            }
-            output[x + w * y] = minVal;
-        }
-    }
+    const size_t plane = (size_t)w * h * vol.channels;
+    std::vector<T> output(plane, std::numeric_limits<T>::max()); // start with the largest value
+    extremeOverSlices<T, false>(vol, 0, d - 1, bricks, output);
 
-    if (!writeGrayPNG(outFilename, output.data(), w, h)) {
+    if (!writeGrayPNG(outFilename, output.data(), w, h, vol.channels, options)) {
         std::cerr << "Failed to write MinIP to " << outFilename << std::endl;
     }
 }
@@ -136,39 +219,49 @@ void Projections3D::MinIP(const Volume &vol, const std::string &outFilename)
  * 
  * @param vol The input 3D volume.
  * @param outFilename The output file name for the generated projection.
+ * @param options Encoder settings; bitDepth 16 writes the mean as a 16-bit PNG.
  */
-void Projections3D::AIP(const Volume &vol, const std::string &outFilename)
+template <typename T>
+void Projections3D::AIP(const BasicVolume<T> &vol, const std::string &outFilename,
+                        const ImageWriteOptions &options)
 {
     int w = vol.width;
     int h = vol.height;
     int d = vol.depth;
 
-    std::vector<unsigned int> accum(w * h, 0); // 32-bit accumulators
-    std::vector<unsigned char> output(w * h, 0);
+    const size_t plane = (size_t)w * h * vol.channels;
+    std::vector<AccumType<T>> accum(plane, 0);
+    std::vector<T> output(plane, T(0));
 
-    // sum up all slices
-    for (int y = 0; y < h; ++y) {
-        for (int x = 0; x < w; ++x) {
-            unsigned int sumVal = 0;
-            for (int z = 0; z < d; ++z) {
-                size_t idx = (size_t)x + (size_t)w * ((size_t)y + (size_t)h * z);
-                sumVal += (unsigned int)(vol.data[idx]);
-            }
-            accum[x + w * y] = sumVal;
+    // sum up all slices, one contiguous slice (all channels) at a time
+    for (int z = 0; z < d; ++z) {
+        const T *slice = vol.data.data() + plane * z;
+        for (size_t i = 0; i < plane; ++i) {
+            accum[i] += (AccumType<T>)(slice[i]);
         }
     }
 
-    // now do the average
-    for (int y = 0; y < h; ++y) {
-        for (int x = 0; x < w; ++x) {
-            unsigned int sumVal = accum[x + w * y];
-            // integer division
-            unsigned char mean = (unsigned char)(sumVal / d);
-            output[x + w * y] = mean;
+    // 16-bit output of an 8-bit volume keeps the fraction the 8-bit mean throws
+    // away: sum * 257 / d, rounded
+    if (std::is_same_v<T, unsigned char> && options.bitDepth == 16) {
+        std::vector<std::uint16_t> output16(plane, 0);
+        for (size_t i = 0; i < plane; ++i) {
+            unsigned long long scaled = (unsigned long long)accum[i] * 257u;
+            output16[i] = (std::uint16_t)((scaled + d / 2) / d);
+        }
+        if (!writeGrayPNG(outFilename, output16.data(), w, h, vol.channels, options)) {
+            std::cerr << "Failed to write AIP to " << outFilename << std::endl;
         }
+        return;
+    }
+
+    // now do the average
+    for (size_t i = 0; i < plane; ++i) {
+        // integer division for integer voxels
+        output[i] = (T)(accum[i] / d);
     }
 
-    if (!writeGrayPNG(outFilename, output.data(), w, h)) {
+    if (!writeGrayPNG(outFilename, output.data(), w, h, vol.channels, options)) {
         std::cerr << "Failed to write AIP to " << outFilename << std::endl;
     }
 }
@@ -180,8 +273,12 @@ void Projections3D::AIP(const Volume &vol, const std::string &outFilename)
  * @param zStart The starting slice index for the slab.
  * @param zEnd The ending slice index for the slab.
  * @param outFilename The output file name for the generated projection.
+ * @param options Encoder settings.
+ * @param bricks Optional brick grid of vol; bricks that cannot raise the maximum are skipped.
  */
-void Projections3D::MIPSlab(const Volume &vol, int zStart, int zEnd, const std::string &outFilename)
+template <typename T>
+void Projections3D::MIPSlab(const BasicVolume<T> &vol, int zStart, int zEnd, const std::string &outFilename,
+                            const ImageWriteOptions &options, const BrickGrid *bricks)
 {
     // 1) clamp or validate zStart, zEnd
     int startZ = std::max(0, std::min(zStart, vol.depth - 1));
@@ -195,25 +292,14 @@ void Projections3D::MIPSlab(const Volume &vol, int zStart, int zEnd, const std::
     int w = vol.width;
     int h = vol.height;
     // allocate output 2D buffer
-    std::vector<unsigned char> output(w * h, 0);
-
-    // for each (x,y), find max in [zStart..zEnd]
-    for (int y = 0; y < h; ++y) {
-        for (int x = 0; x < w; ++x) {
-            unsigned char maxVal = 0;
-            for (int z = startZ; z <= endZ; ++z) {
-                size_t idx = (size_t)x + (size_t)w * ((size_t)y + (size_t)h * z);
-                unsigned char val = vol.data[idx];
-                if (val > maxVal) {
-                    maxVal = val;
-                }
-            }
-            output[x + w * y] = maxVal;
-        }
-    }
+    const size_t plane = (size_t)w * h * vol.channels;
+    std::vector<T> output(plane, std::numeric_limits<T>::lowest());
+
+    // for each (x,y) and channel, find max in [zStart..zEnd]
+    extremeOverSlices<T, true>(vol, startZ, endZ, bricks, output);
 
     // save result
-    if (!writeGrayPNG(outFilename, output.data(), w, h)) {
+    if (!writeGrayPNG(outFilename, output.data(), w, h, vol.channels, options)) {
         std::cerr << "MIPSlab failed to write PNG: " << outFilename << std::endl;
     }
 }
@@ -225,8 +311,12 @@ void Projections3D::MIPSlab(const Volume &vol, int zStart, int zEnd, const std::
  * @param zStart The starting slice index for the slab.
  * @param zEnd The ending slice index for the slab.
  * @param outFilename The output file name for the generated projection.
+ * @param options Encoder settings.
+ * @param bricks Optional brick grid of vol; bricks that cannot lower the minimum are skipped.
  */
-void Projections3D::MinIPSlab(const Volume &vol, int zStart, int zEnd, const std::string &outFilename)
+template <typename T>
+void Projections3D::MinIPSlab(const BasicVolume<T> &vol, int zStart, int zEnd, const std::string &outFilename,
+                              const ImageWriteOptions &options, const BrickGrid *bricks)
 {
     int startZ = std::max(0, std::min(zStart, vol.depth - 1));
     int endZ   = std::max(0, std::min(zEnd,   vol.depth - 1));
@@ -236,23 +326,11 @@ void Projections3D::MinIPSlab(const Volume &vol, int zStart, int zEnd, const std
 
     int w = vol.width;
     int h = vol.height;
-    std::vector<unsigned char> output(w * h, 255); // start with 255
-
-    for (int y = 0; y < h; ++y) {
-        for (int x = 0; x < w; ++x) {
-            unsigned char minVal = 255;
-            for (int z = startZ; z <= endZ; ++z) {
-                size_t idx = (size_t)x + (size_t)w * ((size_t)y + (size_t)h * z);
-                unsigned char val = vol.data[idx];
-                if (val < minVal) {
-                    minVal = val;
-                }
-            }
-            output[x + w * y] = minVal;
-        }
-    }
+    const size_t plane = (size_t)w * h * vol.channels;
+    std::vector<T> output(plane, std::numeric_limits<T>::max()); // start with the largest value
+    extremeOverSlices<T, false>(vol, startZ, endZ, bricks, output);
 
-    if (!writeGrayPNG(outFilename, output.data(), w, h)) {
+    if (!writeGrayPNG(outFilename, output.data(), w, h, vol.channels, options)) {
         std::cerr << "MinIPSlab failed to write PNG: " << outFilename << std::endl;
     }
 }
@@ -264,8 +342,11 @@ void Projections3D::MinIPSlab(const Volume &vol, int zStart, int zEnd, const std
  * @param zStart The starting slice index for the slab.
  * @param zEnd The ending slice index for the slab.
  * @param outFilename The output file name for the generated projection.
+ * @param options Encoder settings; bitDepth 16 writes the mean as a 16-bit PNG.
  */
-void Projections3D::AIPSlab(const Volume &vol, int zStart, int zEnd, const std::string &outFilename)
+template <typename T>
+void Projections3D::AIPSlab(const BasicVolume<T> &vol, int zStart, int zEnd, const std::string &outFilename,
+                            const ImageWriteOptions &options)
 {
     int startZ = std::max(0, std::min(zStart, vol.depth - 1));
     int endZ   = std::max(0, std::min(zEnd,   vol.depth - 1));
@@ -278,31 +359,39 @@ void Projections3D::AIPSlab(const Volume &vol, int zStart, int zEnd, const std::
     int d = (endZ - startZ + 1);
 
     // accumulators
-    std::vector<unsigned int> accum(w * h, 0);
-    std::vector<unsigned char> output(w * h, 0);
-
-    // sum partial slab
-    for (int y = 0; y < h; ++y) {
-        for (int x = 0; x < w; ++x) {
-            unsigned int sumVal = 0;
-            for (int z = startZ; z <= endZ; ++z) {
-                size_t idx = (size_t)x + (size_t)w * ((size_t)y + (size_t)h * z);
-                sumVal += (unsigned int)(vol.data[idx]);
-            }
-            accum[x + w * y] = sumVal;
+    const size_t plane = (size_t)w * h * vol.channels;
+    std::vector<AccumType<T>> accum(plane, 0);
+    std::vector<T> output(plane, T(0));
+
+    // sum partial slab, one contiguous slice (all channels) at a time
+    for (int z = startZ; z <= endZ; ++z) {
+        const T *slice = vol.data.data() + plane * z;
+        for (size_t i = 0; i < plane; ++i) {
+            accum[i] += (AccumType<T>)(slice[i]);
         }
     }
 
-    // average
-    for (int y = 0; y < h; ++y) {
-        for (int x = 0; x < w; ++x) {
-            unsigned int sumVal = accum[x + w * y];
-            unsigned char mean = (unsigned char)(sumVal / d);
-            output[x + w * y] = mean;
+    // 16-bit output of an 8-bit volume keeps the fraction the 8-bit mean throws
+    // away: sum * 257 / d, rounded
+    if (std::is_same_v<T, unsigned char> && options.bitDepth == 16) {
+        std::vector<std::uint16_t> output16(plane, 0);
+        for (size_t i = 0; i < plane; ++i) {
+            unsigned long long scaled = (unsigned long long)accum[i] * 257u;
+            output16[i] = (std::uint16_t)((scaled + d / 2) / d);
+        }
+        if (!writeGrayPNG(outFilename, output16.data(), w, h, vol.channels, options)) {
+            std::cerr << "Failed to write AIP to " << outFilename << std::endl;
         }
+        return;
     }
 
-    if (!writeGrayPNG(outFilename, output.data(), w, h)) {
+    // average
+    for (size_t i = 0; i < plane; ++i) {
+        // integer division for integer voxels
+        output[i] = (T)(accum[i] / d);
+    }
+
+    if (!writeGrayPNG(outFilename, output.data(), w, h, vol.channels, options)) {
         std::cerr << "AIPSlab failed to write PNG: " << outFilename << std::endl;
     }
 }
@@ -312,8 +401,11 @@ void Projections3D::AIPSlab(const Volume &vol, int zStart, int zEnd, const std::
  * 
  * @param vol The input 3D volume.
  * @param outFilename The output file name for the generated projection.
+ * @param options Encoder settings.
  */
-void Projections3D::AIPMedian(const Volume &vol, const std::string &outFilename)
+template <typename T>
+void Projections3D::AIPMedian(const BasicVolume<T> &vol, const std::string &outFilename,
+                              const ImageWriteOptions &options)
 {
     int w = vol.width;
     int h = vol.height;
@@ -325,43 +417,14 @@ void Projections3D::AIPMedian(const Volume &vol, const std::string &outFilename)
     }
 
     // Output buffer for the resulting 2D image
-    std::vector<unsigned char> output(w * h, 0);
+    const size_t plane = (size_t)w * h * vol.channels;
+    std::vector<T> output(plane, T(0));
 
-    // For each (x,y), gather all z-values, sort them, and pick the median
-    for (int y = 0; y < h; ++y)
-    {
-        for (int x = 0; x < w; ++x)
-        {
-            // Collect intensity values along z
-            std::vector<unsigned char> vals(d);
-            for (int z = 0; z < d; ++z)
-            {
-                size_t idx = (size_t)x + (size_t)w * ((size_t)y + (size_t)h * z);
-                vals[z] = vol.data[idx]; // grayscale intensity
-            }
-            // Sort the intensities
-            std::sort(vals.begin(), vals.end());
-
-            // Compute median
-            unsigned char medianVal = 0;
-            if (d % 2 == 1) {
-                // Odd number of slices
-                medianVal = vals[d / 2];
-            } else {
-                // Even number of slices; average the two middle values
-                unsigned char v1 = vals[(d / 2) - 1];
-                unsigned char v2 = vals[d / 2];
-                // safe integer average
-                medianVal = static_cast<unsigned char>((static_cast<int>(v1) + v2) / 2);
-            }
-
-            // Store in output image
-            output[x + w * y] = medianVal;
-        }
-    }
+    // For each (x,y) and channel, the median of its values along z
+    medianOverSlices(vol, 0, d - 1, output);
 
     // Finally, write out the resulting 2D image as a PNG
-    if (!writeGrayPNG(outFilename, output.data(), w, h))
+    if (!writeGrayPNG(outFilename, output.data(), w, h, vol.channels, options))
     {
         std::cerr << "Failed to write AIPMedian to " << outFilename << std::endl;
     }
@@ -375,19 +438,34 @@ void Projections3D::AIPMedian(const Volume &vol, const std::string &outFilename)
  * @param outPath The output file path for the projection result.
  * @param zStart Optional starting slice index for slab-based projections (default: full volume).
  * @param zEnd Optional ending slice index for slab-based projections (default: full volume).
+ * @param options Encoder settings forwarded to the writer.
+ * @param axis Axis to project along; for X and Y the slab range counts along that axis.
+ * @param bricks Optional brick grid of vol, used by MIP and MinIP along z.
  */
-void Projections3D::applyProjection3D(const Volume &vol, const std::string &projType,
-                                      const std::string &outPath, int zStart, int zEnd)
+template <typename T>
+void Projections3D::applyProjection3D(const BasicVolume<T> &vol, const std::string &projType,
+                                      const std::string &outPath, int zStart, int zEnd,
+                                      const ImageWriteOptions &options, ProjectionAxis axis,
+                                      const BrickGrid *bricks)
 {
+    if (axis != ProjectionAxis::Z) {
+        // Bring the projection axis to z; XZY keeps x across, YZX puts y across
+        std::cout << "[3D Projection] along " << (axis == ProjectionAxis::X ? "X" : "Y") << "\n";
+        BasicVolume<T> turned = vol.permuted(axis == ProjectionAxis::X ? AxisOrder::YZX : AxisOrder::XZY);
+        // The permuted volume's z is the original x or y, so the slab range carries over
+        applyProjection3D(turned, projType, outPath, zStart, zEnd, options, ProjectionAxis::Z);
+        return;
+    }
+
     if (projType == "MIP") {
         if (zStart > 0 || zEnd >= 0) {
             int zs = std::max(zStart, 0);
             int ze = (zEnd < 0) ? (vol.depth - 1) : std::min(zEnd, vol.depth - 1);
             std::cout << "[3D Projection] MIP (slab " << zs << ".." << ze << ") => " << outPath << "\n";
-            Projections3D::MIPSlab(vol, zs, ze, outPath);
+            Projections3D::MIPSlab(vol, zs, ze, outPath, options, bricks);
         } else {
             std::cout << "[3D Projection] MIP (full) => " << outPath << "\n";
-            Projections3D::MIP(vol, outPath);
+            Projections3D::MIP(vol, outPath, options, bricks);
         }
     }
     else if (projType == "MinIP") {
@@ -395,10 +473,10 @@ void Projections3D::applyProjection3D(const Volume &vol, const std::string &proj
             int zs = std::max(zStart, 0);
             int ze = (zEnd < 0) ? (vol.depth - 1) : std::min(zEnd, vol.depth - 1);
             std::cout << "[3D Projection] MinIP (slab) => " << outPath << "\n";
-            Projections3D::MinIPSlab(vol, zs, ze, outPath);
+            Projections3D::MinIPSlab(vol, zs, ze, outPath, options, bricks);
         } else {
             std::cout << "[3D Projection] MinIP (full) => " << outPath << "\n";
-            Projections3D::MinIP(vol, outPath);
+            Projections3D::MinIP(vol, outPath, options, bricks);
         }
     }
     else if (projType == "AIP") {
@@ -406,17 +484,269 @@ void Projections3D::applyProjection3D(const Volume &vol, const std::string &proj
             int zs = std::max(zStart, 0);
             int ze = (zEnd < 0) ? (vol.depth - 1) : std::min(zEnd, vol.depth - 1);
             std::cout << "[3D Projection] AIP (slab) => " << outPath << "\n";
-            Projections3D::AIPSlab(vol, zs, ze, outPath);
+            Projections3D::AIPSlab(vol, zs, ze, outPath, options);
         } else {
             std::cout << "[3D Projection] AIP (full) => " << outPath << "\n";
-            Projections3D::AIP(vol, outPath);
+            Projections3D::AIP(vol, outPath, options);
         }
     }
     else if (projType == "AIPMedian") {
         std::cout << "[3D Projection] AIPMedian => " << outPath << "\n";
-        Projections3D::AIPMedian(vol, outPath);
+        Projections3D::AIPMedian(vol, outPath, options);
     }
     else {
         std::cout << "[3D Projection] " << projType << " not yet implemented => " << outPath << "\n";
     }
 }
+
+/**
+ * @brief Computes a projection into a buffer instead of a file.
+ * 
+ * @param vol The input 3D volume.
+ * @param projType "MIP", "MinIP", "AIP" or "AIPMedian".
+ * @param zStart First slice of the slab along z (negative = from the start).
+ * @param zEnd Last slice of the slab along z (negative = to the end).
+ * @param out Receives outWidth * outHeight * vol.channels values.
+ * @param outWidth Receives the projection width.
+ * @param outHeight Receives the projection height.
+ * @param axis Axis to project along; X and Y permute the volume first, and the slab then
+ *             counts along that axis.
+ * @param bricks Optional brick grid of vol, used by MIP and MinIP along z.
+ * @throws std::invalid_argument If the volume is empty or projType is unknown.
+ */
+template <typename T>
+void Projections3D::project(const BasicVolume<T> &vol, const std::string &projType, int zStart, int zEnd,
+                            std::vector<T> &out, int &outWidth, int &outHeight, ProjectionAxis axis,
+                            const BrickGrid *bricks)
+{
+    if (vol.width <= 0 || vol.height <= 0 || vol.depth <= 0 || vol.channels <= 0) {
+        throw std::invalid_argument("Cannot project an empty volume");
+    }
+    if (projType != "MIP" && projType != "MinIP" && projType != "AIP" && projType != "AIPMedian") {
+        throw std::invalid_argument("Unknown projection type: " + projType);
+    }
+    if (axis != ProjectionAxis::Z) {
+        BasicVolume<T> turned = vol.permuted(axis == ProjectionAxis::X ? AxisOrder::YZX : AxisOrder::XZY);
+        project(turned, projType, zStart, zEnd, out, outWidth, outHeight, ProjectionAxis::Z);
+        return;
+    }
+
+    int zs = std::max(zStart, 0);
+    int ze = (zEnd < 0) ? (vol.depth - 1) : std::min(zEnd, vol.depth - 1);
+    zs = std::min(zs, vol.depth - 1);
+    if (zs > ze) {
+        std::swap(zs, ze);
+    }
+    outWidth = vol.width;
+    outHeight = vol.height;
+    const size_t plane = (size_t)vol.width * vol.height * vol.channels;
+
+    if (projType == "MIP") {
+        out.assign(plane, std::numeric_limits<T>::lowest());
+        extremeOverSlices<T, true>(vol, zs, ze, bricks, out);
+    } else if (projType == "MinIP") {
+        out.assign(plane, std::numeric_limits<T>::max());
+        extremeOverSlices<T, false>(vol, zs, ze, bricks, out);
+    } else if (projType == "AIP") {
+        std::vector<AccumType<T>> accum(plane, 0);
+        for (int z = zs; z <= ze; ++z) {
+            const T *slice = vol.data.data() + plane * z;
+            for (size_t i = 0; i < plane; ++i) {
+                accum[i] += (AccumType<T>)(slice[i]);
+            }
+        }
+        out.resize(plane);
+        const int n = ze - zs + 1;
+        for (size_t i = 0; i < plane; ++i) {
+            out[i] = (T)(accum[i] / n);
+        }
+    } else {
+        out.resize(plane);
+        medianOverSlices(vol, zs, ze, out);
+    }
+}
+
+/**
+ * @brief Writes a stack of sliding thick-slab projections.
+ * 
+ * Slices are streamed once in z order. For MIP/MinIP every pixel keeps a monotonic
+ * deque (a ring of at most `thickness` slice indices and values, decreasing for MIP):
+ * a new value pops the entries it dominates from the back, the entry that left the
+ * window drops off the front, and the front is the window's extreme. AIP adds the
+ * entering slice and subtracts the leaving one. Pixels are updated in parallel bands.
+ * 
+ * @param vol The input 3D volume.
+ * @param projType "MIP", "MinIP" or "AIP".
+ * @param thickness Slices per slab (clamped to the axis length).
+ * @param step Slices between the starts of consecutive slabs (at least 1).
+ * @param outPattern Output path pattern; the slab's first slice is appended.
+ * @param options Encoder settings; bitDepth 16 writes 8-bit AIP means as 16-bit.
+ * @param axis The axis the slabs are stacked along.
+ * @return The number of slabs written.
+ */
+template <typename T>
+int Projections3D::slidingSlab(const BasicVolume<T> &vol, const std::string &projType, int thickness, int step,
+                               const std::string &outPattern, const ImageWriteOptions &options,
+                               ProjectionAxis axis)
+{
+    if (axis != ProjectionAxis::Z) {
+        BasicVolume<T> turned = vol.permuted(axis == ProjectionAxis::X ? AxisOrder::YZX : AxisOrder::XZY);
+        return slidingSlab(turned, projType, thickness, step, outPattern, options, ProjectionAxis::Z);
+    }
+
+    const int w = vol.width;
+    const int h = vol.height;
+    const int d = vol.depth;
+    if (w <= 0 || h <= 0 || d <= 0) {
+        std::cerr << "Volume dimensions are zero; cannot do sliding slabs!\n";
+        return 0;
+    }
+    const bool isMax = (projType == "MIP");
+    const bool isMin = (projType == "MinIP");
+    const bool isMean = (projType == "AIP");
+    if (!isMax && !isMin && !isMean) {
+        std::cerr << "Sliding slabs support MIP, MinIP and AIP, not " << projType << "\n";
+        return 0;
+    }
+
+    const int n = std::clamp(thickness, 1, d);
+    const int s = std::max(step, 1);
+    const int pixels = w * h * vol.channels;
+    const size_t plane = (size_t)pixels;
+    const int digits = std::max(4, (int)std::to_string(d - n).size());
+    const bool wideMean = isMean && std::is_same_v<T, unsigned char> && options.bitDepth == 16;
+
+    std::vector<T> output(plane, T(0));
+    std::vector<std::uint16_t> output16(wideMean ? plane : 0, 0);
+
+    // Per-pixel deques (MIP/MinIP): a ring of n entries per pixel plus head and size
+    std::vector<int> dqIndex, dqHead, dqSize;
+    std::vector<T> dqValue;
+    // Running sums (AIP)
+    std::vector<AccumType<T>> accum;
+    if (isMean) {
+        accum.assign(plane, 0);
+    } else {
+        dqIndex.resize(plane * n);
+        dqValue.resize(plane * n);
+        dqHead.assign(plane, 0);
+        dqSize.assign(plane, 0);
+    }
+
+    int written = 0;
+    for (int z = 0; z < d; ++z) {
+        const T *slice = vol.data.data() + plane * z;
+        const int start = z - n + 1;                      // first slice of the window ending here
+        const bool emit = start >= 0 && start % s == 0;
+
+        Parallel::forBands(0, pixels, [&](int iBegin, int iEnd) {
+            if (isMean) {
+                const T *leaving = (start > 0) ? slice - plane * n : nullptr;
+                for (int i = iBegin; i < iEnd; ++i) {
+                    accum[i] += (AccumType<T>)slice[i];
+                    if (leaving) {
+                        accum[i] -= (AccumType<T>)leaving[i];
+                    }
+                    if (emit) {
+                        if (wideMean) {
+                            output16[i] = (std::uint16_t)(((unsigned long long)accum[i] * 257u + n / 2) / n);
+                        } else {
+                            output[i] = (T)(accum[i] / n);
+                        }
+                    }
+                }
+                return;
+            }
+            for (int i = iBegin; i < iEnd; ++i) {
+                int *idx = dqIndex.data() + (size_t)i * n;
+                T *val = dqValue.data() + (size_t)i * n;
+                int head = dqHead[i];
+                int size = dqSize[i];
+                const T v = slice[i];
+
+                // Drop the front once it falls out of the window [z - n + 1, z]
+                if (size > 0 && idx[head] <= z - n) {
+                    head = (head + 1 == n) ? 0 : head + 1;
+                    --size;
+                }
+                // Pop everything the new value dominates, then append it
+                while (size > 0) {
+                    int back = head + size - 1;
+                    if (back >= n) back -= n;
+                    if (isMax ? (val[back] > v) : (val[back] < v)) break;
+                    --size;
+                }
+                int tail = head + size;
+                if (tail >= n) tail -= n;
+                idx[tail] = z;
+                val[tail] = v;
+                ++size;
+
+                dqHead[i] = head;
+                dqSize[i] = size;
+                if (emit) {
+                    output[i] = val[head];
+                }
+            }
+        }, 4096);
+
+        if (emit) {
+            const std::string path = Slicing3D::slicePath(outPattern, start, digits);
+            bool ok = wideMean ? writeGrayPNG(path, output16.data(), w, h, vol.channels, options)
+                               : writeGrayPNG(path, output.data(), w, h, vol.channels, options);
+            if (ok) {
+                ++written;
+            } else {
+                std::cerr << "Failed to write " << projType << " slab to " << path << std::endl;
+            }
+        }
+    }
+
+    std::cout << "[3D Projection] " << written << " sliding " << projType << " slabs (" << n << " thick, step "
+              << s << ") => " << Slicing3D::slicePath(outPattern, 0, digits) << " ...\n";
+    return written;
+}
+
+/**
+ * @brief Converts an axis name to a ProjectionAxis.
+ * 
+ * @param name "x", "y" or "z" (case-insensitive).
+ * @return The matching axis, or Z for unknown names.
+ */
+ProjectionAxis Projections3D::GetProjectionAxis(const std::string &name)
+{
+    if (name == "x" || name == "X") return ProjectionAxis::X;
+    if (name == "y" || name == "Y") return ProjectionAxis::Y;
+    if (name == "z" || name == "Z") return ProjectionAxis::Z;
+    std::cerr << "[WARN] Unknown projection axis: " << name << " (defaulting to Z)\n";
+    return ProjectionAxis::Z;
+}
+
+// Explicit instantiations for the supported voxel types
+#define PROJECTIONS3D_INSTANTIATE(T)                                                                        \
+    template void Projections3D::MIP<T>(const BasicVolume<T> &, const std::string &, const ImageWriteOptions &,    \
+                                        const BrickGrid *);                                                      \
+    template void Projections3D::MinIP<T>(const BasicVolume<T> &, const std::string &, const ImageWriteOptions &,  \
+                                          const BrickGrid *);                                                    \
+    template void Projections3D::AIP<T>(const BasicVolume<T> &, const std::string &, const ImageWriteOptions &);   \
+    template void Projections3D::MIPSlab<T>(const BasicVolume<T> &, int, int, const std::string &,                \
+                                            const ImageWriteOptions &, const BrickGrid *);                       \
+    template void Projections3D::MinIPSlab<T>(const BasicVolume<T> &, int, int, const std::string &,              \
+                                              const ImageWriteOptions &, const BrickGrid *);                     \
+    template void Projections3D::AIPSlab<T>(const BasicVolume<T> &, int, int, const std::string &,                \
+                                            const ImageWriteOptions &);                                          \
+    template void Projections3D::AIPMedian<T>(const BasicVolume<T> &, const std::string &,                        \
+                                              const ImageWriteOptions &);                                        \
+    template void Projections3D::applyProjection3D<T>(const BasicVolume<T> &, const std::string &,                \
+                                                      const std::string &, int, int, const ImageWriteOptions &,  \
+                                                      ProjectionAxis, const BrickGrid *);                        \
+    template int Projections3D::slidingSlab<T>(const BasicVolume<T> &, const std::string &, int, int,            \
+                                               const std::string &, const ImageWriteOptions &, ProjectionAxis);  \
+    template void Projections3D::project<T>(const BasicVolume<T> &, const std::string &, int, int,               \
+                                            std::vector<T> &, int &, int &, ProjectionAxis, const BrickGrid *);
+
+PROJECTIONS3D_INSTANTIATE(unsigned char)
+PROJECTIONS3D_INSTANTIATE(std::uint16_t)
+PROJECTIONS3D_INSTANTIATE(float)
+
+#undef PROJECTIONS3D_INSTANTIATE
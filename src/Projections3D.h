@@ -15,35 +15,104 @@
 #define PROJECTIONS3D_H
 
 #include <string>
+#include <vector>
 #include "Volume.h"
+#include "Image.h"
 
+class BrickGrid;
+
+// Direction a projection runs along. X and Y give images in the same orientation as
+// the YZ and XZ slices (the other in-plane axis across, z down).
+enum class ProjectionAxis {
+    X,
+    Y,
+    Z
+};
+
+// All projections are templates over the voxel type, instantiated in Projections3D.cpp
+// for Volume, Volume16 and VolumeF. uint16/float volumes write 16-bit PNGs unless
+// options.bitDepth is 8. Multi-channel volumes are projected per channel and give
+// an image with the same channels. MIP and MinIP (full or slab) take an optional
+// BrickGrid of the volume and then skip bricks that cannot change the result.
 class Projections3D {
 public:
     // Maximum Intensity Projection
-    static void MIP(const Volume &vol, const std::string &outFilename);
+    template <typename T>
+    static void MIP(const BasicVolume<T> &vol, const std::string &outFilename,
+                    const ImageWriteOptions &options = ImageWriteOptions{},
+                    const BrickGrid *bricks = nullptr);
 
     // Minimum Intensity Projection
-    static void MinIP(const Volume &vol, const std::string &outFilename);
+    template <typename T>
+    static void MinIP(const BasicVolume<T> &vol, const std::string &outFilename,
+                      const ImageWriteOptions &options = ImageWriteOptions{},
+                      const BrickGrid *bricks = nullptr);
 
     // Average Intensity Projection
-    static void AIP(const Volume &vol, const std::string &outFilename);
+    template <typename T>
+    static void AIP(const BasicVolume<T> &vol, const std::string &outFilename,
+                    const ImageWriteOptions &options = ImageWriteOptions{});
 
     // Optional partial-slab versions of MIP, MinIP, AIP.
     // zStart, zEnd define the subrange in [0..vol.depth-1].
-    static void MIPSlab(const Volume &vol, int zStart, int zEnd, const std::string &outFilename);
-    static void MinIPSlab(const Volume &vol, int zStart, int zEnd, const std::string &outFilename);
-    static void AIPSlab(const Volume &vol, int zStart, int zEnd, const std::string &outFilename);
-    static void AIPMedian(const Volume &vol, const std::string &outFilename);
+    template <typename T>
+    static void MIPSlab(const BasicVolume<T> &vol, int zStart, int zEnd, const std::string &outFilename,
+                        const ImageWriteOptions &options = ImageWriteOptions{},
+                        const BrickGrid *bricks = nullptr);
+    template <typename T>
+    static void MinIPSlab(const BasicVolume<T> &vol, int zStart, int zEnd, const std::string &outFilename,
+                          const ImageWriteOptions &options = ImageWriteOptions{},
+                          const BrickGrid *bricks = nullptr);
+    template <typename T>
+    static void AIPSlab(const BasicVolume<T> &vol, int zStart, int zEnd, const std::string &outFilename,
+                        const ImageWriteOptions &options = ImageWriteOptions{});
+    template <typename T>
+    static void AIPMedian(const BasicVolume<T> &vol, const std::string &outFilename,
+                          const ImageWriteOptions &options = ImageWriteOptions{});
+
+    // Dispatches on projType. Along X or Y the volume is first permuted (blocked
+    // transpose) so the z-wise projections run on contiguous slices; the slab range
+    // then counts along that axis, and the brick grid is not used.
+    template <typename T>
+    static void applyProjection3D(const BasicVolume<T> &vol, const std::string &projType,
+                                  const std::string &outPath, int zStart, int zEnd,
+                                  const ImageWriteOptions &options = ImageWriteOptions{},
+                                  ProjectionAxis axis = ProjectionAxis::Z,
+                                  const BrickGrid *bricks = nullptr);
+
+    // In-memory projection for embedding (no file written): fills out with
+    // width * height * channels values of the projection along the axis, in the
+    // orientation applyProjection3D writes. The slab [zStart, zEnd] counts along the
+    // projection axis (negative = whole axis); AIP is the integer mean for integer voxels.
+    // Throws std::invalid_argument for an empty volume or an unknown projType.
+    template <typename T>
+    static void project(const BasicVolume<T> &vol, const std::string &projType, int zStart, int zEnd,
+                        std::vector<T> &out, int &outWidth, int &outHeight,
+                        ProjectionAxis axis = ProjectionAxis::Z, const BrickGrid *bricks = nullptr);
+
+    // Sliding thick slab: one MIP, MinIP or AIP per window of `thickness` slices along
+    // the axis, the windows starting every `step` slices. Each slice is visited once:
+    // MIP/MinIP keep a monotonic deque per pixel and AIP a running sum, so the cost
+    // does not depend on the thickness. Files are named after outPattern with the
+    // window's first slice appended (see Slicing3D::slicePath). Returns the number written.
+    template <typename T>
+    static int slidingSlab(const BasicVolume<T> &vol, const std::string &projType, int thickness, int step,
+                           const std::string &outPattern,
+                           const ImageWriteOptions &options = ImageWriteOptions{},
+                           ProjectionAxis axis = ProjectionAxis::Z);
 
-    static void applyProjection3D(const Volume &vol, const std::string &projType,
-                                  const std::string &outPath, int zStart, int zEnd);
+    // Converts "x", "y" or "z" (case-insensitive); unknown names warn and give Z
+    static ProjectionAxis GetProjectionAxis(const std::string &name);
 
 private:
-    // Helper to write out a 2D buffer as PNG
+    // Helper to write out a 2D buffer (8-bit, 16-bit or float; channels interleaved)
+    template <typename T>
     static bool writeGrayPNG(const std::string &filename,
-                             const unsigned char *buffer,
+                             const T *buffer,
                              int width,
-                             int height);
+                             int height,
+                             int channels,
+                             const ImageWriteOptions &options);
 };
 
 #endif // PROJECTIONS3D_H
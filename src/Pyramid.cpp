@@ -0,0 +1,217 @@
+/*
+ * @file Pyramid.cpp
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#include "Pyramid.h"
+#include "Parallel.h"
+#include "Resampler.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// 5-tap binomial kernel; two passes multiply to 256, so the result is a single shift
+constexpr int kTaps[5] = { 1, 4, 6, 4, 1 };
+
+/**
+ * @brief Blur-and-decimate one level into the next (Burt & Adelson REDUCE).
+ *
+ * The horizontal pass keeps unnormalised 16-bit sums for the rows it needs, so the
+ * whole reduction is exact integer arithmetic with a single rounding at the end.
+ */
+void reduce(const unsigned char* src, int sw, int sh, int channels,
+            unsigned char* dst, int dw, int dh) {
+    const int rowLen = dw * channels;
+    std::vector<std::uint16_t> rows(static_cast<size_t>(sh) * rowLen);
+
+    // Horizontal: every source row -> half-width row of sums (max 255 * 16)
+    Parallel::forBands(0, sh, [&](int yBegin, int yEnd) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            const unsigned char* in = src + static_cast<size_t>(y) * sw * channels;
+            std::uint16_t* out = rows.data() + static_cast<size_t>(y) * rowLen;
+            for (int x = 0; x < dw; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    int acc = 0;
+                    for (int k = 0; k < 5; ++k) {
+                        int sx = std::clamp(2 * x + k - 2, 0, sw - 1);
+                        acc += kTaps[k] * in[sx * channels + c];
+                    }
+                    out[x * channels + c] = static_cast<std::uint16_t>(acc);
+                }
+            }
+        }
+    }, 32);
+
+    // Vertical: combine five rows of sums, then normalise by 256 with rounding
+    Parallel::forBands(0, dh, [&](int yBegin, int yEnd) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            const std::uint16_t* in[5];
+            for (int k = 0; k < 5; ++k) {
+                in[k] = rows.data() + static_cast<size_t>(std::clamp(2 * y + k - 2, 0, sh - 1)) * rowLen;
+            }
+            unsigned char* out = dst + static_cast<size_t>(y) * rowLen;
+            for (int i = 0; i < rowLen; ++i) {
+                int acc = in[0][i] + 4 * in[1][i] + 6 * in[2][i] + 4 * in[3][i] + in[4][i];
+                out[i] = static_cast<unsigned char>((acc + 128) >> 8);
+            }
+        }
+    }, 16);
+}
+
+} // namespace
+
+/**
+ * @brief Builds the Gaussian pyramid of an image.
+ */
+Pyramid::Pyramid(const Image& base, int maxLevels) {
+    build(base.getData(), base.getWidth(), base.getHeight(), base.getChannels(), maxLevels);
+}
+
+/**
+ * @brief Builds the Gaussian pyramid into a single arena.
+ *
+ * Level sizes are known up front, so the arena is sized once and each level is
+ * reduced straight into its slot from the previous one.
+ */
+void Pyramid::build(const unsigned char* data, int width, int height, int channels, int maxLevels) {
+    if (!data || width <= 0 || height <= 0 || channels < 1 || channels > 4) {
+        throw std::invalid_argument("Pyramid requires a non-empty image with 1 to 4 channels");
+    }
+
+    numChannels = channels;
+    views.clear();
+    laplacian.clear();
+
+    size_t total = 0;
+    int w = width, h = height;
+    while (true) {
+        views.push_back({ w, h, total });
+        total += static_cast<size_t>(w) * h * channels;
+        if ((w == 1 && h == 1) || (maxLevels > 0 && levels() == maxLevels)) {
+            break;
+        }
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+
+    arena.resize(total);
+    std::memcpy(arena.data(), data, static_cast<size_t>(width) * height * channels);
+    for (int i = 1; i < levels(); ++i) {
+        const Level& prev = views[i - 1];
+        const Level& cur = views[i];
+        reduce(arena.data() + prev.offset, prev.width, prev.height, channels,
+               arena.data() + cur.offset, cur.width, cur.height);
+    }
+}
+
+/**
+ * @brief Returns the view describing a level.
+ */
+const Pyramid::Level& Pyramid::level(int level) const {
+    if (level < 0 || level >= levels()) {
+        throw std::out_of_range("Pyramid level " + std::to_string(level) + " does not exist");
+    }
+    return views[level];
+}
+
+/**
+ * @brief Returns the pixels of a Gaussian level.
+ */
+const unsigned char* Pyramid::levelData(int level) const {
+    return arena.data() + this->level(level).offset;
+}
+
+/**
+ * @brief Copies a Gaussian level into an image, resizing it to match.
+ */
+void Pyramid::copyLevelTo(int level, Image& img) const {
+    const Level& view = this->level(level);
+    img.setData(arena.data() + view.offset, view.width, view.height, numChannels);
+}
+
+/**
+ * @brief Upsamples a buffer with the dimensions of level + 1 to the size of level.
+ *
+ * Uses the bilinear resampler; the Laplacian only needs expand() to be deterministic
+ * for collapse() to be exact, and bilinear is the cheapest kernel that is smooth.
+ */
+void Pyramid::expand(const unsigned char* src, int level, std::vector<unsigned char>& dst) const {
+    const Level& coarse = views[level + 1];
+    const Level& fine = views[level];
+    dst.resize(static_cast<size_t>(fine.width) * fine.height * numChannels);
+    Resampler::resamplePlane(src, coarse.width, coarse.height, numChannels,
+                             dst.data(), fine.width, fine.height, ResizeKernel::Bilinear);
+}
+
+/**
+ * @brief Computes the Laplacian levels into an int16 arena with the same layout.
+ */
+void Pyramid::buildLaplacian() {
+    laplacian.assign(arena.size(), 0);
+    const int top = levels() - 1;
+
+    std::vector<unsigned char> up;
+    for (int i = 0; i < top; ++i) {
+        expand(arena.data() + views[i + 1].offset, i, up);
+        const unsigned char* g = arena.data() + views[i].offset;
+        std::int16_t* l = laplacian.data() + views[i].offset;
+        for (size_t k = 0; k < up.size(); ++k) {
+            l[k] = static_cast<std::int16_t>(g[k] - up[k]);
+        }
+    }
+
+    // The coarsest level is the Gaussian residual itself
+    const size_t topSize = arena.size() - views[top].offset;
+    for (size_t k = 0; k < topSize; ++k) {
+        laplacian[views[top].offset + k] = arena[views[top].offset + k];
+    }
+}
+
+/**
+ * @brief Returns the pixels of a Laplacian level.
+ */
+const std::int16_t* Pyramid::laplacianData(int level) const {
+    if (laplacian.empty()) {
+        throw std::logic_error("buildLaplacian() must be called before laplacianData()");
+    }
+    return laplacian.data() + this->level(level).offset;
+}
+
+/**
+ * @brief Rebuilds level 0 by expanding from the coarsest level and adding back each
+ *        Laplacian band.
+ */
+void Pyramid::collapse(Image& img) const {
+    if (laplacian.empty()) {
+        throw std::logic_error("buildLaplacian() must be called before collapse()");
+    }
+    const int top = levels() - 1;
+
+    std::vector<unsigned char> current(arena.size() - views[top].offset);
+    for (size_t k = 0; k < current.size(); ++k) {
+        current[k] = static_cast<unsigned char>(std::clamp<int>(laplacian[views[top].offset + k], 0, 255));
+    }
+
+    std::vector<unsigned char> up;
+    for (int i = top - 1; i >= 0; --i) {
+        expand(current.data(), i, up);
+        const std::int16_t* l = laplacian.data() + views[i].offset;
+        for (size_t k = 0; k < up.size(); ++k) {
+            up[k] = static_cast<unsigned char>(std::clamp(l[k] + up[k], 0, 255));
+        }
+        current.swap(up);
+    }
+
+    img.setData(current.data(), views[0].width, views[0].height, numChannels);
+}
@@ -0,0 +1,128 @@
+/*
+ * @file Pyramid.h
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#ifndef PYRAMID_H
+#define PYRAMID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Image.h"
+
+/**
+ * @class Pyramid
+ * @brief Gaussian (and optionally Laplacian) image pyramid stored in one contiguous arena.
+ *
+ * Level 0 is the input; each further level is blurred with the 5-tap binomial kernel
+ * [1 4 6 4 1] / 16 and decimated by two, rounding odd sizes up, down to 1x1 or the
+ * requested number of levels. All levels live back to back in a single buffer and are
+ * addressed through per-level views, so building a pyramid is one allocation and
+ * filters can run on any level without re-decoding or re-filtering the original.
+ */
+class Pyramid {
+public:
+    /**
+     * @brief View of one level inside the arena.
+     */
+    struct Level {
+        int width;      ///< Level width in pixels
+        int height;     ///< Level height in pixels
+        size_t offset;  ///< Offset of the first pixel in the arena
+    };
+
+    /**
+     * @brief Creates an empty pyramid; call build() before use.
+     */
+    Pyramid() = default;
+
+    /**
+     * @brief Builds the Gaussian pyramid of an image.
+     * @param base The full-resolution image (level 0).
+     * @param maxLevels Maximum number of levels including level 0 (0 = down to 1x1).
+     */
+    explicit Pyramid(const Image& base, int maxLevels = 0);
+
+    /**
+     * @brief (Re)builds the Gaussian pyramid from raw interleaved pixels.
+     * @param data Pixel data, width * height * channels bytes.
+     * @param width Level 0 width.
+     * @param height Level 0 height.
+     * @param channels Interleaved channels per pixel.
+     * @param maxLevels Maximum number of levels including level 0 (0 = down to 1x1).
+     */
+    void build(const unsigned char* data, int width, int height, int channels, int maxLevels = 0);
+
+    /**
+     * @brief Number of levels in the pyramid.
+     */
+    int levels() const { return static_cast<int>(views.size()); }
+
+    /**
+     * @brief Number of interleaved channels per pixel (same on every level).
+     */
+    int channels() const { return numChannels; }
+
+    /**
+     * @brief The view describing a level.
+     * @param level Level index, 0 is full resolution.
+     * @throws std::out_of_range If the level does not exist.
+     */
+    const Level& level(int level) const;
+
+    /**
+     * @brief Pixels of a Gaussian level (points into the shared arena).
+     * @param level Level index, 0 is full resolution.
+     */
+    const unsigned char* levelData(int level) const;
+
+    /**
+     * @brief Replaces an image's contents with a copy of a Gaussian level.
+     * @param level Level index, 0 is full resolution.
+     * @param img The image to overwrite (dimensions change to the level's).
+     */
+    void copyLevelTo(int level, Image& img) const;
+
+    /**
+     * @brief Computes the Laplacian pyramid: L_i = G_i - expand(G_{i+1}), with the
+     *        coarsest level holding G itself. Stored as int16 with the same layout.
+     */
+    void buildLaplacian();
+
+    /**
+     * @brief Signed pixels of a Laplacian level; buildLaplacian() must have been called.
+     * @param level Level index, 0 is full resolution.
+     */
+    const std::int16_t* laplacianData(int level) const;
+
+    /**
+     * @brief Reconstructs level 0 from the Laplacian pyramid (exact inverse of buildLaplacian).
+     * @param img The image to overwrite with the reconstruction.
+     */
+    void collapse(Image& img) const;
+
+private:
+    int numChannels = 0;                   ///< Channels per pixel
+    std::vector<Level> views;              ///< Per-level views into the arenas
+    std::vector<unsigned char> arena;      ///< Gaussian levels, back to back
+    std::vector<std::int16_t> laplacian;   ///< Laplacian levels (empty until buildLaplacian)
+
+    /**
+     * @brief Upsamples level + 1 (or any buffer of that size) to the size of level.
+     * @param src Pixels with the dimensions of level + 1.
+     * @param level The target level.
+     * @param dst Output buffer, resized to the target level's size.
+     */
+    void expand(const unsigned char* src, int level, std::vector<unsigned char>& dst) const;
+};
+
+#endif // PYRAMID_H
@@ -0,0 +1,501 @@
+/*
+ * @file RayCaster.cpp
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#include "RayCaster.h"
+#include "Parallel.h"
+#include "Slicing3D.h"
+#include "Trilinear.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+constexpr int kLanes = 8;       // rays per packet (two SSE registers)
+constexpr int kLutSize = 1024;  // transfer function resolution
+constexpr double kPi = 3.14159265358979323846;
+
+/**
+ * @brief Factor that maps voxel values to the transfer function's [0, 1].
+ */
+template <typename T>
+constexpr float normalisation() {
+    if constexpr (std::is_same_v<T, unsigned char>) {
+        return 1.0f / 255.0f;
+    } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+        return 1.0f / 65535.0f;
+    } else {
+        return 1.0f;
+    }
+}
+
+/**
+ * @brief Transfer function sampled at kLutSize points, opacity corrected for the step.
+ *
+ * `opaque[i]` counts the entries below i with non-zero opacity, so whether a value
+ * range is fully transparent is one subtraction.
+ */
+struct TransferLut {
+    std::vector<float> r, g, b, a;
+    std::vector<int> opaque;
+    float scale = 0.0f;  // voxel value -> LUT position
+
+    TransferLut(const TransferFunction& tf, double step, float norm)
+        : r(kLutSize), g(kLutSize), b(kLutSize), a(kLutSize), opaque(kLutSize + 1, 0),
+          scale(norm * (kLutSize - 1)) {
+        const auto& pts = tf.points;
+        for (int i = 0; i < kLutSize; ++i) {
+            const float x = static_cast<float>(i) / (kLutSize - 1);
+            auto hi = std::lower_bound(pts.begin(), pts.end(), x,
+                                       [](const TransferFunction::Point& p, float v) { return p.value < v; });
+            TransferFunction::Point p;
+            if (hi == pts.begin()) {
+                p = pts.front();
+            } else if (hi == pts.end()) {
+                p = pts.back();
+            } else {
+                const auto& lo = *(hi - 1);
+                const float t = hi->value > lo.value ? (x - lo.value) / (hi->value - lo.value) : 1.0f;
+                p = { x, lo.r + (hi->r - lo.r) * t, lo.g + (hi->g - lo.g) * t, lo.b + (hi->b - lo.b) * t,
+                      lo.a + (hi->a - lo.a) * t };
+            }
+            r[i] = p.r;
+            g[i] = p.g;
+            b[i] = p.b;
+            a[i] = p.a > 0.0f ? static_cast<float>(1.0 - std::pow(1.0 - std::min(p.a, 1.0f), step)) : 0.0f;
+            opaque[i + 1] = opaque[i] + (a[i] > 0.0f ? 1 : 0);
+        }
+    }
+
+    int index(float v) const {
+        return std::clamp(static_cast<int>(v * scale + 0.5f), 0, kLutSize - 1);
+    }
+
+    bool transparent(float lo, float hi) const {
+        return opaque[index(hi) + 1] == opaque[index(lo)];
+    }
+};
+
+/**
+ * @brief Orientation of the image plane and the view direction.
+ */
+struct View {
+    Vec3 u, v, dir;
+};
+
+View orient(double yawDeg, double pitchDeg) {
+    const double cy = std::cos(yawDeg * kPi / 180.0), sy = std::sin(yawDeg * kPi / 180.0);
+    const double cp = std::cos(pitchDeg * kPi / 180.0), sp = std::sin(pitchDeg * kPi / 180.0);
+    // Pitch about x, then yaw about y, applied to the axis-aligned view
+    return { { cy, 0.0, -sy }, { sp * sy, cp, sp * cy }, { cp * sy, -sp, cp * cy } };
+}
+
+/**
+ * @brief Ray parameters [sNear, sFar] where origin + s * dir is within half a voxel of the volume.
+ * @return False if the ray misses.
+ */
+bool clipRay(const double origin[3], const double dir[3], const int dims[3], double& sNear, double& sFar) {
+    sNear = -std::numeric_limits<double>::infinity();
+    sFar = std::numeric_limits<double>::infinity();
+    for (int a = 0; a < 3; ++a) {
+        const double lo = -0.5, hi = dims[a] - 0.5;
+        if (std::abs(dir[a]) < 1e-12) {
+            if (origin[a] < lo || origin[a] > hi) {
+                return false;
+            }
+            continue;
+        }
+        double t0 = (lo - origin[a]) / dir[a], t1 = (hi - origin[a]) / dir[a];
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        sNear = std::max(sNear, t0);
+        sFar = std::min(sFar, t1);
+    }
+    return sNear <= sFar;
+}
+
+} // namespace
+
+/**
+ * @brief Default ramp: transparent black at 0 to opaque white at 1.
+ */
+TransferFunction TransferFunction::ramp() {
+    return { { { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f } } };
+}
+
+/**
+ * @brief Reads "value r g b a" control points from a text file.
+ */
+TransferFunction TransferFunction::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open transfer function " + path);
+    }
+    TransferFunction tf;
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first) || first[0] == '#') {
+            continue;
+        }
+        fields.seekg(0);
+        Point p;
+        std::string extra;
+        if (!(fields >> p.value >> p.r >> p.g >> p.b >> p.a) || (fields >> extra)) {
+            throw std::runtime_error(path + ":" + std::to_string(lineNo) + ": expected \"value r g b a\"");
+        }
+        tf.points.push_back(p);
+    }
+    if (tf.points.empty()) {
+        throw std::runtime_error("Transfer function " + path + " has no control points");
+    }
+    std::stable_sort(tf.points.begin(), tf.points.end(),
+                     [](const Point& a, const Point& b) { return a.value < b.value; });
+    return tf;
+}
+
+template <typename T>
+RayCaster<T>::RayCaster(const BasicVolume<T>& vol, int brickSize) : volume(vol) {
+    if (vol.channels != 1) {
+        throw std::invalid_argument("Ray casting needs a single-channel volume");
+    }
+    grid = BrickGrid(vol, brickSize);
+}
+
+template <typename T>
+RayCaster<T>::RayCaster(const BasicVolume<T>& vol, BrickGrid prebuilt) : volume(vol), grid(std::move(prebuilt)) {
+    if (vol.channels != 1) {
+        throw std::invalid_argument("Ray casting needs a single-channel volume");
+    }
+    if (!grid.covers(vol)) {
+        throw std::invalid_argument("Brick grid does not match the volume");
+    }
+}
+
+/**
+ * @brief Fills in the image size from the extent of the volume seen from the camera.
+ */
+template <typename T>
+Camera RayCaster<T>::resolve(const Camera& cam) const {
+    Camera c = cam;
+    const View view = orient(cam.yaw, cam.pitch);
+    auto extent = [&](const Vec3& axis) {
+        const double e = volume.width * std::abs(axis.x) + volume.height * std::abs(axis.y) +
+                         volume.depth * std::abs(axis.z);
+        return std::max(1, static_cast<int>(std::lround(e)));
+    };
+    if (c.width <= 0) {
+        c.width = extent(view.u);
+    }
+    if (c.height <= 0) {
+        c.height = extent(view.v);
+    }
+    return c;
+}
+
+/**
+ * @brief Casts one ray per pixel, eight at a time.
+ *
+ * Every ray samples at origin + k * step * dir where origin is the pixel's projection
+ * onto the plane dot(p, dir) = 0, so sample k of every ray lies on the same plane. The
+ * packet walks k from the first to the last sample of any of its lanes, and lanes
+ * outside the volume contribute nothing (the sampler masks them).
+ */
+template <typename T>
+Camera RayCaster<T>::render(const Camera& camera, RenderMode mode, std::vector<float>& out) const {
+    const Camera cam = resolve(camera);
+    if (!(cam.step > 0.0)) {
+        throw std::invalid_argument("Ray step must be positive");
+    }
+    const int W = cam.width, H = cam.height;
+    const int outChannels = mode == RenderMode::Composite ? 3 : 1;
+    out.assign(static_cast<size_t>(W) * H * outChannels, 0.0f);
+
+    const View view = orient(cam.yaw, cam.pitch);
+    const Vec3 centre{ (volume.width - 1) / 2.0, (volume.height - 1) / 2.0, (volume.depth - 1) / 2.0 };
+    const double along = centre.x * view.dir.x + centre.y * view.dir.y + centre.z * view.dir.z;
+    const double dirD[3] = { view.dir.x, view.dir.y, view.dir.z };
+    const int dims[3] = { volume.width, volume.height, volume.depth };
+    const float stepF[3] = { static_cast<float>(cam.step * view.dir.x), static_cast<float>(cam.step * view.dir.y),
+                             static_cast<float>(cam.step * view.dir.z) };
+
+    const Trilinear::Grid g = Trilinear::Grid::of(volume);
+    const T* data = volume.data.data();
+    const TransferLut lut(transfer, cam.step, normalisation<T>());
+    const float globalMin = grid.globalMin(), globalMax = grid.globalMax();
+    const int B = grid.size();
+    const int lastBrick[3] = { grid.bricksX() - 1, grid.bricksY() - 1, grid.bricksZ() - 1 };
+    const bool skip = skipping && mode != RenderMode::AIP;
+
+    Parallel::forBands(0, H, [&](int rowBegin, int rowEnd) {
+        alignas(16) float L[3][kLanes];  // lattice origin of each lane
+        int kFirst[kLanes], kLast[kLanes];
+        alignas(16) float vals[kLanes];
+        float acc[kLanes], cnt[kLanes], rgb[kLanes][3];
+        bool done[kLanes];
+
+        for (int j = rowBegin; j < rowEnd; ++j) {
+            for (int i0 = 0; i0 < W; i0 += kLanes) {
+                const int lanes = std::min(kLanes, W - i0);
+                int kMin = INT_MAX, kMax = INT_MIN;
+                for (int l = 0; l < kLanes; ++l) {
+                    const int i = i0 + std::min(l, lanes - 1);  // spare lanes repeat the last ray
+                    const double a = i - (W - 1) / 2.0, b = j - (H - 1) / 2.0;
+                    const double o[3] = { centre.x + view.u.x * a + view.v.x * b - view.dir.x * along,
+                                          centre.y + view.u.y * a + view.v.y * b - view.dir.y * along,
+                                          centre.z + view.u.z * a + view.v.z * b - view.dir.z * along };
+                    L[0][l] = static_cast<float>(o[0]);
+                    L[1][l] = static_cast<float>(o[1]);
+                    L[2][l] = static_cast<float>(o[2]);
+                    double sNear, sFar;
+                    done[l] = l >= lanes || !clipRay(o, dirD, dims, sNear, sFar);
+                    if (done[l]) {
+                        kFirst[l] = 1;
+                        kLast[l] = 0;
+                        continue;
+                    }
+                    // One spare sample either side; the sampler's own inside test decides
+                    kFirst[l] = static_cast<int>(std::ceil(sNear / cam.step)) - 1;
+                    kLast[l] = static_cast<int>(std::floor(sFar / cam.step)) + 1;
+                    kMin = std::min(kMin, kFirst[l]);
+                    kMax = std::max(kMax, kLast[l]);
+                }
+                std::fill(acc, acc + kLanes, mode == RenderMode::MinIP ? std::numeric_limits<float>::infinity() : 0.0f);
+                std::fill(cnt, cnt + kLanes, 0.0f);
+                std::fill(&rgb[0][0], &rgb[0][0] + kLanes * 3, 0.0f);
+
+                // Brick of lane l's sample k (positions outside are clamped to the edge bricks)
+                auto brickOf = [&](int l, int k, float p[3], int br[3]) {
+                    const float kf = static_cast<float>(k);
+                    for (int a = 0; a < 3; ++a) {
+                        p[a] = L[a][l] + kf * stepF[a];
+                        br[a] = std::min(static_cast<int>(std::clamp(p[a], 0.0f, static_cast<float>(dims[a] - 1))) / B,
+                                         lastBrick[a]);
+                    }
+                };
+                // Whether no sample in the brick can change lane l
+                auto skippable = [&](int l, const int br[3]) {
+                    const float bMin = grid.minAt(br[0], br[1], br[2]);
+                    const float bMax = grid.maxAt(br[0], br[1], br[2]);
+                    return mode == RenderMode::MIP     ? bMax <= acc[l]
+                           : mode == RenderMode::MinIP ? bMin >= acc[l]
+                                                       : lut.transparent(bMin, bMax);
+                };
+                // Samples (>= 1) from p until the ray leaves brick br; the outer faces of
+                // the edge bricks are open because everything past them is outside the volume
+                auto runLength = [&](const float p[3], const int br[3]) {
+                    double run = std::numeric_limits<double>::infinity();
+                    for (int a = 0; a < 3; ++a) {
+                        const double s = stepF[a];
+                        if (s > 1e-9 && br[a] < lastBrick[a]) {
+                            run = std::min(run, std::ceil(((br[a] + 1.0) * B - p[a]) / s - 1e-3));
+                        } else if (s < -1e-9 && br[a] > 0) {
+                            run = std::min(run, std::floor((p[a] - br[a] * B) / -s - 1e-3) + 1.0);
+                        }
+                    }
+                    return static_cast<int>(std::clamp(run, 1.0, static_cast<double>(INT_MAX / 2)));
+                };
+
+                // clearUntil[l]: lane l has nothing to add before that step. Sampling only
+                // raises a MIP maximum or lowers a MinIP minimum, so this stays valid.
+                int clearUntil[kLanes];
+                std::fill(clearUntil, clearUntil + kLanes, kMin);
+                int k = kMin;
+                int recheckAt = kMin;  // no skip test until the lane that blocked leaves its brick
+                while (k <= kMax) {
+                    if (skip && k >= recheckAt) {
+                        int advanceTo = INT_MAX;
+                        for (int l = 0; l < kLanes; ++l) {
+                            if (done[l] || k > kLast[l]) {
+                                continue;
+                            }
+                            if (clearUntil[l] <= k) {
+                                if (k < kFirst[l]) {
+                                    clearUntil[l] = kFirst[l];
+                                } else {
+                                    float p[3];
+                                    int br[3];
+                                    brickOf(l, k, p, br);
+                                    const int run = runLength(p, br);
+                                    if (!skippable(l, br)) {
+                                        advanceTo = k;
+                                        recheckAt = k + run;
+                                        break;
+                                    }
+                                    clearUntil[l] = k + run;
+                                }
+                            }
+                            advanceTo = std::min(advanceTo, clearUntil[l]);
+                        }
+                        if (advanceTo == INT_MAX) {
+                            break;
+                        }
+                        if (advanceTo > k) {
+                            k = advanceTo;
+                            continue;
+                        }
+                    }
+
+                    // Sample all eight lanes at step k
+                    const float kf = static_cast<float>(k);
+                    int inside = 0;
+#if defined(__SSE2__)
+                    Trilinear::Cell4 cell;
+                    const __m128 kv = _mm_set1_ps(kf);
+                    for (int h = 0; h < kLanes; h += 4) {
+                        const __m128 px = _mm_add_ps(_mm_load_ps(L[0] + h), _mm_mul_ps(kv, _mm_set1_ps(stepF[0])));
+                        const __m128 py = _mm_add_ps(_mm_load_ps(L[1] + h), _mm_mul_ps(kv, _mm_set1_ps(stepF[1])));
+                        const __m128 pz = _mm_add_ps(_mm_load_ps(L[2] + h), _mm_mul_ps(kv, _mm_set1_ps(stepF[2])));
+                        const int bits = Trilinear::locate4(g, px, py, pz, cell);
+                        _mm_store_ps(vals + h, bits ? Trilinear::gather4(data, g, cell, 0) : _mm_setzero_ps());
+                        inside |= bits << h;
+                    }
+#else
+                    Trilinear::Cell cell;
+                    for (int l = 0; l < kLanes; ++l) {
+                        vals[l] = 0.0f;
+                        if (Trilinear::locate(g, L[0][l] + kf * stepF[0], L[1][l] + kf * stepF[1],
+                                              L[2][l] + kf * stepF[2], cell)) {
+                            vals[l] = Trilinear::gather(data, g, cell, 0);
+                            inside |= 1 << l;
+                        }
+                    }
+#endif
+
+                    bool allDone = true;
+                    for (int l = 0; l < kLanes; ++l) {
+                        if (done[l]) {
+                            continue;
+                        }
+                        if (inside & (1 << l)) {
+                            const float v = vals[l];
+                            switch (mode) {
+                            case RenderMode::MIP:
+                                acc[l] = std::max(acc[l], v);
+                                done[l] = acc[l] >= globalMax;
+                                break;
+                            case RenderMode::MinIP:
+                                acc[l] = std::min(acc[l], v);
+                                done[l] = acc[l] <= globalMin;
+                                break;
+                            case RenderMode::AIP:
+                                acc[l] += v;
+                                cnt[l] += 1.0f;
+                                break;
+                            case RenderMode::Composite: {
+                                const int idx = lut.index(v);
+                                const float w = (1.0f - acc[l]) * lut.a[idx];
+                                rgb[l][0] += w * lut.r[idx];
+                                rgb[l][1] += w * lut.g[idx];
+                                rgb[l][2] += w * lut.b[idx];
+                                acc[l] += w;
+                                done[l] = acc[l] >= 0.99f;  // early ray termination
+                                break;
+                            }
+                            }
+                        }
+                        done[l] = done[l] || k >= kLast[l];
+                        allDone = allDone && done[l];
+                    }
+                    if (allDone) {
+                        break;
+                    }
+                    ++k;
+                }
+
+                for (int l = 0; l < lanes; ++l) {
+                    const size_t px = static_cast<size_t>(j) * W + i0 + l;
+                    switch (mode) {
+                    case RenderMode::MIP:
+                        out[px] = acc[l];
+                        break;
+                    case RenderMode::MinIP:
+                        out[px] = std::isinf(acc[l]) ? 0.0f : acc[l];
+                        break;
+                    case RenderMode::AIP:
+                        out[px] = cnt[l] > 0.0f ? acc[l] / cnt[l] : 0.0f;
+                        break;
+                    case RenderMode::Composite:
+                        out[px * 3 + 0] = rgb[l][0];
+                        out[px * 3 + 1] = rgb[l][1];
+                        out[px * 3 + 2] = rgb[l][2];
+                        break;
+                    }
+                }
+            }
+        }
+    }, 2);
+    return cam;
+}
+
+/**
+ * @brief Renders one view and writes it with writeVoxelPlane().
+ */
+template <typename T>
+void RayCaster<T>::renderToFile(const Camera& cam, RenderMode mode, const std::string& outPath,
+                                const ImageWriteOptions& options) const {
+    std::vector<float> pixels;
+    const Camera used = render(cam, mode, pixels);
+    if (mode == RenderMode::Composite) {
+        ImageWriteOptions rgbOptions = options;
+        rgbOptions.bitDepth = options.bitDepth == 16 ? 16 : 8;
+        writeVoxelPlane(pixels.data(), used.width, used.height, 3, outPath, rgbOptions);
+    } else if (std::is_same_v<T, unsigned char> && options.bitDepth == 16 && mode == RenderMode::AIP) {
+        // Keep the fractional part of 8-bit means, as the AIP projections do
+        std::vector<std::uint16_t> wide(pixels.size());
+        for (size_t i = 0; i < pixels.size(); ++i) {
+            wide[i] = static_cast<std::uint16_t>(std::lround(std::clamp(pixels[i], 0.0f, 255.0f) * 257.0f));
+        }
+        writeVoxelPlane(wide.data(), used.width, used.height, 1, outPath, options);
+    } else {
+        std::vector<T> voxels(pixels.size());
+        for (size_t i = 0; i < pixels.size(); ++i) {
+            if constexpr (std::is_floating_point_v<T>) {
+                voxels[i] = static_cast<T>(pixels[i]);
+            } else {
+                const float hi = static_cast<float>(std::numeric_limits<T>::max());
+                voxels[i] = static_cast<T>(std::clamp(pixels[i] + 0.5f, 0.0f, hi));
+            }
+        }
+        writeVoxelPlane(voxels.data(), used.width, used.height, 1, outPath, options);
+    }
+    std::cout << "Rendered " << used.width << "x" << used.height << " view (yaw " << used.yaw
+              << ", pitch " << used.pitch << ") to " << outPath << std::endl;
+}
+
+template <typename T>
+RenderMode RayCaster<T>::GetRenderMode(const std::string& name) {
+    if (name == "MIP") return RenderMode::MIP;
+    if (name == "MinIP") return RenderMode::MinIP;
+    if (name == "AIP") return RenderMode::AIP;
+    if (name == "Composite") return RenderMode::Composite;
+    std::cerr << "[WARN] Unknown render mode: " << name << " (defaulting to MIP)\n";
+    return RenderMode::MIP;
+}
+
+template class RayCaster<unsigned char>;
+template class RayCaster<std::uint16_t>;
+template class RayCaster<float>;
@@ -0,0 +1,146 @@
+/*
+ * @file RayCaster.h
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#ifndef RAY_CASTER_H
+#define RAY_CASTER_H
+
+#include <string>
+#include <vector>
+#include "BrickGrid.h"
+#include "Image.h"
+#include "Volume.h"
+
+// What a ray accumulates along its path through the volume
+enum class RenderMode {
+    MIP,
+    MinIP,
+    AIP,
+    Composite  // front-to-back alpha compositing through a transfer function
+};
+
+/**
+ * @brief Piecewise-linear transfer function from normalised intensity to colour and opacity.
+ *
+ * Intensities are normalised like VolumeF (8-bit / 255, 16-bit / 65535). Opacity is
+ * per voxel of travel; the ray caster corrects it for the step size.
+ */
+struct TransferFunction {
+    struct Point {
+        float value, r, g, b, a;  // all in [0, 1]
+    };
+    std::vector<Point> points;  // sorted by value
+
+    /**
+     * @brief Default ramp: transparent black at 0 to opaque white at 1.
+     */
+    static TransferFunction ramp();
+
+    /**
+     * @brief Reads "value r g b a" control points, one per line.
+     *
+     * Commas may separate the numbers and '#' starts a comment. Points are sorted by value.
+     * @throws std::runtime_error If the file cannot be read, a line is malformed, or
+     *         there are no points.
+     */
+    static TransferFunction load(const std::string& path);
+};
+
+/**
+ * @brief Orthographic camera orbiting the volume centre.
+ *
+ * With yaw = pitch = 0 rays run along +z and image x/y are volume x/y, so a full-depth
+ * MIP matches Projections3D::MIP. Yaw turns about the volume's y axis, then pitch tilts
+ * about the image x axis (degrees). A zero width or height is taken from the volume's
+ * projected extent; step is the sample spacing along the ray in voxels.
+ */
+struct Camera {
+    double yaw = 0.0;
+    double pitch = 0.0;
+    int width = 0;
+    int height = 0;
+    double step = 1.0;
+};
+
+/**
+ * @class RayCaster
+ * @brief CPU volume renderer: MIP, MinIP, AIP and composited ray casting.
+ *
+ * Rays are traced in packets of eight neighbouring pixels that step together, sampled
+ * trilinearly four at a time with SSE2; rows of packets run in parallel. All rays sample
+ * the same planes perpendicular to the view direction, which lets a packet skip a
+ * brick of the BrickGrid whenever no lane could change there (MIP below the running
+ * maximum, MinIP above the running minimum, Composite where the transfer function is
+ * transparent) without changing the image. Rays stop early once they are opaque or
+ * have reached the volume's global extreme.
+ *
+ * Single-channel volumes only. Instantiated for Volume, Volume16 and VolumeF.
+ */
+template <typename T>
+class RayCaster {
+public:
+    /**
+     * @brief Prepares to render a volume; builds the brick grid used for skipping.
+     * @throws std::invalid_argument If the volume is empty or has more than one channel.
+     */
+    explicit RayCaster(const BasicVolume<T>& vol, int brickSize = BrickGrid::kDefaultSize);
+
+    /**
+     * @brief Prepares to render a volume with a grid built earlier (e.g. BrickGrid::cached()).
+     * @throws std::invalid_argument If the volume is not single-channel or the grid does not cover it.
+     */
+    RayCaster(const BasicVolume<T>& vol, BrickGrid prebuilt);
+
+    void setTransferFunction(const TransferFunction& tf) { transfer = tf; }
+    void setSkipping(bool on) { skipping = on; }
+
+    /**
+     * @brief Resolves the camera's automatic image size for this volume.
+     */
+    Camera resolve(const Camera& cam) const;
+
+    /**
+     * @brief Renders one view.
+     *
+     * @param cam The camera (see resolve() for the size).
+     * @param mode What the rays accumulate.
+     * @param out Receives width * height values in voxel units for the intensity modes,
+     *            or width * height * 3 composited RGB values in [0, 1] for Composite.
+     * @return The camera actually used.
+     * @throws std::invalid_argument If the step or the image size is not positive.
+     */
+    Camera render(const Camera& cam, RenderMode mode, std::vector<float>& out) const;
+
+    /**
+     * @brief Renders one view to an image file.
+     *
+     * Intensity modes are written like a projection of the volume (8-bit for Volume,
+     * 16-bit otherwise unless options.bitDepth says so); Composite writes RGB, 8-bit
+     * unless options.bitDepth is 16.
+     * @throws std::runtime_error If writing fails.
+     */
+    void renderToFile(const Camera& cam, RenderMode mode, const std::string& outPath,
+                      const ImageWriteOptions& options = ImageWriteOptions{}) const;
+
+    const BrickGrid& bricks() const { return grid; }
+
+    // Converts "MIP", "MinIP", "AIP" or "Composite"; unknown names warn and give MIP
+    static RenderMode GetRenderMode(const std::string& name);
+
+private:
+    const BasicVolume<T>& volume;
+    BrickGrid grid;
+    TransferFunction transfer = TransferFunction::ramp();
+    bool skipping = true;
+};
+
+#endif // RAY_CASTER_H
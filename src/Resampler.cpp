@@ -0,0 +1,428 @@
+/*
+ * @file Resampler.cpp
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#include "Resampler.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <numbers>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Fixed-point weights: 14 fractional bits keep them (and 255 * weight) inside int16/int32
+constexpr int kWeightBits = 14;
+constexpr int kRound = 1 << (kWeightBits - 1);
+
+double sinc(double x) {
+    if (x == 0.0) return 1.0;
+    x *= std::numbers::pi;
+    return std::sin(x) / x;
+}
+
+double kernelSupport(ResizeKernel kernel) {
+    switch (kernel) {
+        case ResizeKernel::Box:      return 0.5;
+        case ResizeKernel::Bilinear: return 1.0;
+        case ResizeKernel::Bicubic:  return 2.0;
+        case ResizeKernel::Lanczos3: return 3.0;
+    }
+    return 1.0;
+}
+
+double kernelWeight(ResizeKernel kernel, double x) {
+    if (kernel == ResizeKernel::Box) {
+        // Half-open so a sample exactly between two pixels is only counted once
+        return (x > -0.5 && x <= 0.5) ? 1.0 : 0.0;
+    }
+    x = std::abs(x);
+    switch (kernel) {
+        case ResizeKernel::Box:
+            return 0.0;
+        case ResizeKernel::Bilinear:
+            return x < 1.0 ? 1.0 - x : 0.0;
+        case ResizeKernel::Bicubic: {
+            // Keys cubic with a = -0.5
+            const double a = -0.5;
+            if (x < 1.0) return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+            if (x < 2.0) return (((x - 5.0) * x + 8.0) * x - 4.0) * a;
+            return 0.0;
+        }
+        case ResizeKernel::Lanczos3:
+            return x < 3.0 ? sinc(x) * sinc(x / 3.0) : 0.0;
+    }
+    return 0.0;
+}
+
+/**
+ * @brief Per-output-coordinate taps along one axis.
+ *
+ * Output i reads count[i] consecutive inputs starting at start[i], with weights at
+ * weights[i * stride]. stride is even and the unused tail is zero, so the SIMD loops
+ * can always consume taps in pairs.
+ */
+struct WeightTable {
+    int stride = 0;
+    std::vector<int> start;
+    std::vector<int> count;
+    std::vector<std::int16_t> weights;
+};
+
+WeightTable buildWeights(int inSize, int outSize, ResizeKernel kernel) {
+    const double scale = static_cast<double>(inSize) / outSize;
+    const double filterScale = std::max(scale, 1.0); // widen the kernel when shrinking
+    const double support = kernelSupport(kernel) * filterScale;
+
+    WeightTable table;
+    int maxTaps = static_cast<int>(std::ceil(support)) * 2 + 1;
+    table.stride = (maxTaps + 1) & ~1;
+    table.start.resize(outSize);
+    table.count.resize(outSize);
+    table.weights.assign(static_cast<size_t>(outSize) * table.stride, 0);
+
+    std::vector<double> w(maxTaps);
+    for (int i = 0; i < outSize; ++i) {
+        const double center = (i + 0.5) * scale;
+        int first = std::max(static_cast<int>(center - support + 0.5), 0);
+        int last = std::min(static_cast<int>(center + support + 0.5), inSize);
+        int n = std::min(last - first, maxTaps);
+
+        double sum = 0.0;
+        for (int k = 0; k < n; ++k) {
+            w[k] = kernelWeight(kernel, (first + k - center + 0.5) / filterScale);
+            sum += w[k];
+        }
+        std::int16_t* dst = &table.weights[static_cast<size_t>(i) * table.stride];
+        for (int k = 0; k < n; ++k) {
+            double normalised = sum != 0.0 ? w[k] / sum : 0.0;
+            dst[k] = static_cast<std::int16_t>(std::lround(normalised * (1 << kWeightBits)));
+        }
+        table.start[i] = first;
+        table.count[i] = n;
+    }
+    return table;
+}
+
+unsigned char clampFixed(int acc) {
+    return static_cast<unsigned char>(std::clamp(acc >> kWeightBits, 0, 255));
+}
+
+/**
+ * @brief Horizontal pass for rows [yBegin, yEnd): src row width sw -> dst row width dw.
+ *
+ * Each source row is first widened to 4 bytes per pixel (zero padded) in a scratch
+ * buffer so one SIMD path serves 1-4 channels: a pair of pixels unpacks to
+ * [c0 c0' c1 c1' c2 c2' c3 c3'] and a single madd applies both tap weights.
+ */
+void horizontalPass(const unsigned char* src, int sw, int channels, unsigned char* dst, int dw,
+                    const WeightTable& table, int yBegin, int yEnd) {
+    std::vector<unsigned char> row(static_cast<size_t>(sw) * 4 + 8, 0);
+
+    for (int y = yBegin; y < yEnd; ++y) {
+        const unsigned char* in = src + static_cast<size_t>(y) * sw * channels;
+        for (int x = 0; x < sw; ++x) {
+            std::memcpy(&row[x * 4], in + x * channels, channels);
+        }
+        unsigned char* out = dst + static_cast<size_t>(y) * dw * channels;
+
+        for (int x = 0; x < dw; ++x) {
+            const std::int16_t* k = &table.weights[static_cast<size_t>(x) * table.stride];
+            const unsigned char* p = &row[table.start[x] * 4];
+            const int n = table.count[x];
+#if defined(__SSE2__)
+            const __m128i zero = _mm_setzero_si128();
+            __m128i acc = _mm_set1_epi32(kRound);
+            for (int t = 0; t < n; t += 2) {
+                __m128i px = _mm_unpacklo_epi8(
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + t * 4)), zero);
+                px = _mm_unpacklo_epi16(px, _mm_srli_si128(px, 8));
+                const __m128i w = _mm_set1_epi32(static_cast<int>(
+                    (static_cast<std::uint32_t>(static_cast<std::uint16_t>(k[t + 1])) << 16) |
+                    static_cast<std::uint16_t>(k[t])));
+                acc = _mm_add_epi32(acc, _mm_madd_epi16(px, w));
+            }
+            acc = _mm_srai_epi32(acc, kWeightBits);
+            acc = _mm_packus_epi16(_mm_packs_epi32(acc, acc), zero);
+            std::uint32_t packed = static_cast<std::uint32_t>(_mm_cvtsi128_si32(acc));
+            std::memcpy(out + x * channels, &packed, channels);
+#else
+            for (int c = 0; c < channels; ++c) {
+                int acc = kRound;
+                for (int t = 0; t < n; ++t) {
+                    acc += p[t * 4 + c] * k[t];
+                }
+                out[x * channels + c] = clampFixed(acc);
+            }
+#endif
+        }
+    }
+}
+
+/**
+ * @brief Vertical pass for output rows [yBegin, yEnd). Every tap uses one weight for a
+ *        whole row, so rows are blended as flat byte arrays 16 bytes at a time.
+ */
+void verticalPass(const unsigned char* src, int rowBytes, unsigned char* dst,
+                  const WeightTable& table, int yBegin, int yEnd) {
+    for (int y = yBegin; y < yEnd; ++y) {
+        const std::int16_t* k = &table.weights[static_cast<size_t>(y) * table.stride];
+        const unsigned char* first = src + static_cast<size_t>(table.start[y]) * rowBytes;
+        const int n = table.count[y];
+        unsigned char* out = dst + static_cast<size_t>(y) * rowBytes;
+        int i = 0;
+
+#if defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= rowBytes; i += 16) {
+            __m128i acc0 = _mm_set1_epi32(kRound), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+            for (int t = 0; t < n; t += 2) {
+                const unsigned char* ra = first + static_cast<size_t>(t) * rowBytes + i;
+                // An odd final tap pairs with itself under a zero weight
+                const unsigned char* rb = (t + 1 < n) ? ra + rowBytes : ra;
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ra));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rb));
+                const __m128i w = _mm_set1_epi32(static_cast<int>(
+                    (static_cast<std::uint32_t>(static_cast<std::uint16_t>(k[t + 1])) << 16) |
+                    static_cast<std::uint16_t>(k[t])));
+                const __m128i lo = _mm_unpacklo_epi8(a, b);
+                const __m128i hi = _mm_unpackhi_epi8(a, b);
+                acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), w));
+                acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), w));
+                acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), w));
+                acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), w));
+            }
+            const __m128i r01 = _mm_packs_epi32(_mm_srai_epi32(acc0, kWeightBits), _mm_srai_epi32(acc1, kWeightBits));
+            const __m128i r23 = _mm_packs_epi32(_mm_srai_epi32(acc2, kWeightBits), _mm_srai_epi32(acc3, kWeightBits));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(r01, r23));
+        }
+#endif
+        for (; i < rowBytes; ++i) {
+            int acc = kRound;
+            for (int t = 0; t < n; ++t) {
+                acc += first[static_cast<size_t>(t) * rowBytes + i] * k[t];
+            }
+            out[i] = clampFixed(acc);
+        }
+    }
+}
+
+/**
+ * @brief Converts a filtered value back to the voxel type (rounded and clamped for
+ *        integer types).
+ */
+template <typename T>
+T toVoxel(float value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<T>(value);
+    } else {
+        const float hi = static_cast<float>(std::numeric_limits<T>::max());
+        return static_cast<T>(std::lround(std::clamp(value, 0.0f, hi)));
+    }
+}
+
+/**
+ * @brief Scalar resampling of one plane of 16-bit or float voxels.
+ *
+ * Uses the same weight tables as the 8-bit path, converted to float, with a float
+ * intermediate between the horizontal and the vertical pass.
+ */
+template <typename T>
+void resamplePlaneWide(const T* src, int sw, int sh, int channels, T* dst, int dw, int dh,
+                       ResizeKernel kernel) {
+    const WeightTable hTable = buildWeights(sw, dw, kernel);
+    const WeightTable vTable = buildWeights(sh, dh, kernel);
+    const float unit = 1.0f / (1 << kWeightBits);
+    const int rowLen = dw * channels;
+
+    std::vector<float> rows(static_cast<size_t>(rowLen) * sh);
+    for (int y = 0; y < sh; ++y) {
+        const T* in = src + static_cast<size_t>(y) * sw * channels;
+        float* out = rows.data() + static_cast<size_t>(y) * rowLen;
+        for (int x = 0; x < dw; ++x) {
+            const std::int16_t* k = &hTable.weights[static_cast<size_t>(x) * hTable.stride];
+            const T* p = in + static_cast<size_t>(hTable.start[x]) * channels;
+            for (int c = 0; c < channels; ++c) {
+                float acc = 0.0f;
+                for (int t = 0; t < hTable.count[x]; ++t) {
+                    acc += static_cast<float>(p[t * channels + c]) * k[t];
+                }
+                out[x * channels + c] = acc * unit;
+            }
+        }
+    }
+
+    for (int y = 0; y < dh; ++y) {
+        const std::int16_t* k = &vTable.weights[static_cast<size_t>(y) * vTable.stride];
+        const float* first = rows.data() + static_cast<size_t>(vTable.start[y]) * rowLen;
+        T* out = dst + static_cast<size_t>(y) * rowLen;
+        for (int i = 0; i < rowLen; ++i) {
+            float acc = 0.0f;
+            for (int t = 0; t < vTable.count[y]; ++t) {
+                acc += first[static_cast<size_t>(t) * rowLen + i] * k[t];
+            }
+            out[i] = toVoxel<T>(acc * unit);
+        }
+    }
+}
+
+void checkArguments(int newWidth, int newHeight, int channels) {
+    if (newWidth <= 0 || newHeight <= 0) {
+        throw std::invalid_argument("Resize target must be at least 1x1");
+    }
+    if (channels < 1 || channels > 4) {
+        throw std::invalid_argument("Resize supports 1 to 4 channels");
+    }
+}
+
+int scaledSize(int size, float factor) {
+    return std::max(1, static_cast<int>(std::lround(size * static_cast<double>(factor))));
+}
+
+} // namespace
+
+/**
+ * @brief Resamples one interleaved plane with a horizontal then a vertical pass.
+ */
+void Resampler::resamplePlane(const unsigned char* src, int srcWidth, int srcHeight, int channels,
+                              unsigned char* dst, int dstWidth, int dstHeight,
+                              ResizeKernel kernel, bool threaded) {
+    auto run = [threaded](int begin, int end, auto&& fn) {
+        if (threaded) {
+            Parallel::forBands(begin, end, fn, 16);
+        } else {
+            fn(begin, end);
+        }
+    };
+
+    // Horizontal pass (skipped when the width is unchanged)
+    std::vector<unsigned char> intermediate;
+    const unsigned char* rows = src;
+    if (dstWidth != srcWidth) {
+        WeightTable table = buildWeights(srcWidth, dstWidth, kernel);
+        intermediate.resize(static_cast<size_t>(dstWidth) * srcHeight * channels);
+        run(0, srcHeight, [&](int yBegin, int yEnd) {
+            horizontalPass(src, srcWidth, channels, intermediate.data(), dstWidth, table, yBegin, yEnd);
+        });
+        rows = intermediate.data();
+    }
+
+    // Vertical pass
+    const int rowBytes = dstWidth * channels;
+    if (dstHeight == srcHeight) {
+        std::memcpy(dst, rows, static_cast<size_t>(rowBytes) * dstHeight);
+        return;
+    }
+    WeightTable table = buildWeights(srcHeight, dstHeight, kernel);
+    run(0, dstHeight, [&](int yBegin, int yEnd) {
+        verticalPass(rows, rowBytes, dst, table, yBegin, yEnd);
+    });
+}
+
+/**
+ * @brief Resizes an image in place.
+ */
+void Resampler::resize(Image& img, int newWidth, int newHeight, ResizeKernel kernel) {
+    const int channels = img.getChannels();
+    checkArguments(newWidth, newHeight, channels);
+    if (newWidth == img.getWidth() && newHeight == img.getHeight()) {
+        return;
+    }
+
+    std::vector<unsigned char> output(static_cast<size_t>(newWidth) * newHeight * channels);
+    resamplePlane(img.getData(), img.getWidth(), img.getHeight(), channels,
+                  output.data(), newWidth, newHeight, kernel);
+    img.setData(output.data(), newWidth, newHeight, channels);
+}
+
+/**
+ * @brief Scales an image in place by a uniform factor.
+ */
+void Resampler::scale(Image& img, float factor, ResizeKernel kernel) {
+    if (factor <= 0.0f) {
+        throw std::invalid_argument("Scale factor must be positive");
+    }
+    resize(img, scaledSize(img.getWidth(), factor), scaledSize(img.getHeight(), factor), kernel);
+}
+
+/**
+ * @brief Resizes every xy plane of a volume. Planes are independent, so the threads
+ *        split the slices rather than the rows within a slice.
+ */
+template <typename T>
+void Resampler::resize(BasicVolume<T>& vol, int newWidth, int newHeight, ResizeKernel kernel) {
+    checkArguments(newWidth, newHeight, vol.channels);
+    if (newWidth == vol.width && newHeight == vol.height) {
+        return;
+    }
+
+    const size_t srcPlane = static_cast<size_t>(vol.width) * vol.height * vol.channels;
+    const size_t dstPlane = static_cast<size_t>(newWidth) * newHeight * vol.channels;
+    std::vector<T> output(dstPlane * vol.depth);
+
+    Parallel::forBands(0, vol.depth, [&](int zBegin, int zEnd) {
+        for (int z = zBegin; z < zEnd; ++z) {
+            if constexpr (std::is_same_v<T, unsigned char>) {
+                resamplePlane(vol.data.data() + z * srcPlane, vol.width, vol.height, vol.channels,
+                              output.data() + z * dstPlane, newWidth, newHeight, kernel, false);
+            } else {
+                resamplePlaneWide(vol.data.data() + z * srcPlane, vol.width, vol.height, vol.channels,
+                                  output.data() + z * dstPlane, newWidth, newHeight, kernel);
+            }
+        }
+    });
+
+    vol.data.swap(output);
+    vol.width = newWidth;
+    vol.height = newHeight;
+}
+
+/**
+ * @brief Scales every xy plane of a volume by a uniform factor.
+ */
+template <typename T>
+void Resampler::scale(BasicVolume<T>& vol, float factor, ResizeKernel kernel) {
+    if (factor <= 0.0f) {
+        throw std::invalid_argument("Scale factor must be positive");
+    }
+    resize(vol, scaledSize(vol.width, factor), scaledSize(vol.height, factor), kernel);
+}
+
+/**
+ * @brief Converts a string to the corresponding ResizeKernel.
+ */
+ResizeKernel Resampler::GetResizeKernel(const std::string& st) {
+    if (st == "Box") return ResizeKernel::Box;
+    if (st == "Bilinear") return ResizeKernel::Bilinear;
+    if (st == "Bicubic") return ResizeKernel::Bicubic;
+    if (st == "Lanczos3" || st == "Lanczos") return ResizeKernel::Lanczos3;
+    std::cerr << "[WARN] Unknown resize kernel: " << st << " (defaulting to Bicubic)\n";
+    return ResizeKernel::Bicubic;
+}
+
+// Explicit instantiations for the supported voxel types
+template void Resampler::resize<unsigned char>(Volume&, int, int, ResizeKernel);
+template void Resampler::resize<std::uint16_t>(Volume16&, int, int, ResizeKernel);
+template void Resampler::resize<float>(VolumeF&, int, int, ResizeKernel);
+template void Resampler::scale<unsigned char>(Volume&, float, ResizeKernel);
+template void Resampler::scale<std::uint16_t>(Volume16&, float, ResizeKernel);
+template void Resampler::scale<float>(VolumeF&, float, ResizeKernel);
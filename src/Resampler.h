@@ -0,0 +1,110 @@
+/*
+ * @file Resampler.h
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <string>
+#include "Image.h"
+#include "Volume.h"
+
+/**
+ * @enum ResizeKernel
+ * @brief Reconstruction filters for resampling, from cheapest to sharpest.
+ */
+enum class ResizeKernel {
+    Box,
+    Bilinear,
+    Bicubic,
+    Lanczos3
+};
+
+/**
+ * @class Resampler
+ * @brief Separable image/volume resizing with precomputed fixed-point weight tables.
+ *
+ * Each axis is filtered independently: a horizontal pass into an 8-bit intermediate,
+ * then a vertical pass. When shrinking, the kernel is stretched by the scale factor so
+ * it also acts as the anti-aliasing filter. Weights are stored as int16 with 14
+ * fractional bits so both passes can use SSE2 multiply-add.
+ */
+class Resampler {
+public:
+    /**
+     * @brief Resizes an image in place to newWidth x newHeight.
+     * @param img The image to resize (1-4 channels).
+     * @param newWidth Target width in pixels (> 0).
+     * @param newHeight Target height in pixels (> 0).
+     * @param kernel The reconstruction filter (default is Bicubic).
+     * @throws std::invalid_argument If the target size or channel count is invalid.
+     */
+    static void resize(Image& img, int newWidth, int newHeight, ResizeKernel kernel = ResizeKernel::Bicubic);
+
+    /**
+     * @brief Scales an image in place by a uniform factor (result is at least 1x1).
+     * @param img The image to scale.
+     * @param factor Scale factor, e.g. 0.5 halves both dimensions.
+     * @param kernel The reconstruction filter (default is Bicubic).
+     */
+    static void scale(Image& img, float factor, ResizeKernel kernel = ResizeKernel::Bicubic);
+
+    /**
+     * @brief Resizes every xy plane of a volume; the number of slices is unchanged.
+     *
+     * 8-bit volumes use the fixed-point SIMD passes; uint16 and float volumes go
+     * through a scalar float path with the same weights, so they keep their precision.
+     *
+     * @param vol The volume to resize.
+     * @param newWidth Target width in voxels (> 0).
+     * @param newHeight Target height in voxels (> 0).
+     * @param kernel The reconstruction filter (default is Bicubic).
+     */
+    template <typename T>
+    static void resize(BasicVolume<T>& vol, int newWidth, int newHeight, ResizeKernel kernel = ResizeKernel::Bicubic);
+
+    /**
+     * @brief Scales every xy plane of a volume by a uniform factor.
+     * @param vol The volume to scale.
+     * @param factor In-plane scale factor.
+     * @param kernel The reconstruction filter (default is Bicubic).
+     */
+    template <typename T>
+    static void scale(BasicVolume<T>& vol, float factor, ResizeKernel kernel = ResizeKernel::Bicubic);
+
+    /**
+     * @brief Resamples one interleaved 8-bit plane into a caller-provided buffer.
+     *
+     * @param src Source pixels, srcWidth * srcHeight * channels bytes.
+     * @param srcWidth Source width.
+     * @param srcHeight Source height.
+     * @param channels Interleaved channels per pixel (1-4).
+     * @param dst Destination, dstWidth * dstHeight * channels bytes.
+     * @param dstWidth Destination width.
+     * @param dstHeight Destination height.
+     * @param kernel The reconstruction filter.
+     * @param threaded Split the passes into row bands across threads; pass false when
+     *                 the caller already parallelises over planes.
+     */
+    static void resamplePlane(const unsigned char* src, int srcWidth, int srcHeight, int channels,
+                              unsigned char* dst, int dstWidth, int dstHeight,
+                              ResizeKernel kernel, bool threaded = true);
+
+    /**
+     * @brief Converts a string ("Box", "Bilinear", "Bicubic", "Lanczos3") to a ResizeKernel.
+     * @param st The kernel name.
+     * @return The matching kernel; unknown names warn and fall back to Bicubic.
+     */
+    static ResizeKernel GetResizeKernel(const std::string& st);
+};
+
+#endif // RESAMPLER_H
@@ -0,0 +1,230 @@
+/*
+ * @file SlabProjector.cpp
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#include "SlabProjector.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * @brief Validates the volume and type, then builds the tree bottom-up.
+ *
+ * Each level pairs up the nodes of the one below (an odd last node is carried up
+ * unchanged), until a single node covers the whole axis. Nodes of a level are
+ * independent and built in parallel.
+ */
+template <typename T>
+SlabProjector<T>::SlabProjector(const BasicVolume<T>& vol, const std::string& projType, ProjectionAxis axis)
+    : volume(&vol) {
+    if (vol.width <= 0 || vol.height <= 0 || vol.depth <= 0 || vol.channels <= 0 ||
+        vol.data.size() < static_cast<size_t>(vol.width) * vol.height * vol.depth * vol.channels) {
+        throw std::invalid_argument("Slab projector needs a non-empty volume");
+    }
+    if (projType != "MIP" && projType != "MinIP" && projType != "AIP") {
+        throw std::invalid_argument("Slab projector supports MIP, MinIP and AIP, not " + projType);
+    }
+    if (axis != ProjectionAxis::Z) {
+        turned = vol.permuted(axis == ProjectionAxis::X ? AxisOrder::YZX : AxisOrder::XZY);
+        volume = &turned;
+    }
+    isMax = (projType == "MIP");
+    isMean = (projType == "AIP");
+    plane = static_cast<size_t>(volume->width) * volume->height * volume->channels;
+    result.assign(plane, T(0));
+
+    if (isMean) {
+        sums.assign(plane, 0);
+    } else {
+        for (int below = volume->depth; below > 1; below = (below + 1) / 2) {
+            const int count = (below + 1) / 2;
+            levels.emplace_back(static_cast<size_t>(count) * plane);
+            const int level = static_cast<int>(levels.size());
+            Parallel::forBands(0, count, [&](int iBegin, int iEnd) {
+                for (int i = iBegin; i < iEnd; ++i) {
+                    const T* a = node(level - 1, 2 * i);
+                    const T* b = (2 * i + 1 < below) ? node(level - 1, 2 * i + 1) : a;
+                    T* out = levels.back().data() + static_cast<size_t>(i) * plane;
+                    if (isMax) {
+                        for (size_t p = 0; p < plane; ++p) out[p] = std::max(a[p], b[p]);
+                    } else {
+                        for (size_t p = 0; p < plane; ++p) out[p] = std::min(a[p], b[p]);
+                    }
+                }
+            });
+        }
+    }
+    setWindow(0, volume->depth - 1);
+}
+
+/**
+ * @brief Plane of node `index` at tree level `level` (level 0 is slice `index`).
+ */
+template <typename T>
+const T* SlabProjector<T>::node(int level, int index) const {
+    const T* base = (level == 0) ? volume->data.data() : levels[level - 1].data();
+    return base + static_cast<size_t>(index) * plane;
+}
+
+/**
+ * @brief Folds planes into the result by max or min, starting afresh if first is set.
+ */
+template <typename T>
+void SlabProjector<T>::combine(const std::vector<const T*>& planes, bool first) {
+    if (planes.empty()) {
+        return;
+    }
+    Parallel::forBands(0, static_cast<int>(plane), [&](int iBegin, int iEnd) {
+        size_t k = 0;
+        if (first) {
+            std::copy(planes[0] + iBegin, planes[0] + iEnd, result.begin() + iBegin);
+            k = 1;
+        }
+        for (; k < planes.size(); ++k) {
+            const T* src = planes[k];
+            if (isMax) {
+                for (int i = iBegin; i < iEnd; ++i) result[i] = std::max(result[i], src[i]);
+            } else {
+                for (int i = iBegin; i < iEnd; ++i) result[i] = std::min(result[i], src[i]);
+            }
+        }
+    }, 4096);
+}
+
+/**
+ * @brief Adds (or subtracts) slices [z0, z1] to the running sums.
+ */
+template <typename T>
+void SlabProjector<T>::addPlanes(int z0, int z1, bool subtract) {
+    if (z0 > z1) {
+        return;
+    }
+    Parallel::forBands(0, static_cast<int>(plane), [&](int iBegin, int iEnd) {
+        for (int z = z0; z <= z1; ++z) {
+            const T* slice = node(0, z);
+            if (subtract) {
+                for (int i = iBegin; i < iEnd; ++i) sums[i] -= static_cast<Accum>(slice[i]);
+            } else {
+                for (int i = iBegin; i < iEnd; ++i) sums[i] += static_cast<Accum>(slice[i]);
+            }
+        }
+    }, 4096);
+    touched += z1 - z0 + 1;
+}
+
+/**
+ * @brief Moves the window, updating the sums or combining tree nodes.
+ *
+ * AIP applies the difference between the old and new windows unless rebuilding the
+ * sums from the new window reads fewer slices. MIP/MinIP collect the tree nodes that
+ * exactly cover the new window (walking both ends up the levels); when the new window
+ * contains the old one and the added slices are fewer than those nodes, the slices are
+ * folded into the current result instead.
+ */
+template <typename T>
+void SlabProjector<T>::setWindow(int zStart, int zEnd) {
+    const int d = volume->depth;
+    int s = std::max(0, std::min(zStart, d - 1));
+    int e = std::max(0, std::min(zEnd, d - 1));
+    if (s > e) {
+        std::swap(s, e);
+    }
+    touched = 0;
+    if (s == start && e == end) {
+        return;
+    }
+    const bool overlaps = end >= s && start <= e;
+
+    if (isMean) {
+        const int diff = std::abs(s - start) + std::abs(e - end);
+        if (!overlaps || diff >= e - s + 1) {
+            std::fill(sums.begin(), sums.end(), Accum(0));
+            addPlanes(s, e, false);
+        } else {
+            addPlanes(s, start - 1, false);
+            addPlanes(start, s - 1, true);
+            addPlanes(end + 1, e, false);
+            addPlanes(e + 1, end, true);
+        }
+        meanDirty = true;
+    } else {
+        std::vector<const T*> nodes;
+        for (int level = 0, l = s, r = e + 1; l < r; ++level, l >>= 1, r >>= 1) {
+            if (l & 1) nodes.push_back(node(level, l++));
+            if (r & 1) nodes.push_back(node(level, --r));
+        }
+        const int added = (s <= start && e >= end && end >= start) ? (start - s) + (e - end) : d + 1;
+        if (added <= static_cast<int>(nodes.size())) {
+            std::vector<const T*> slices;
+            for (int z = s; z < start; ++z) slices.push_back(node(0, z));
+            for (int z = end + 1; z <= e; ++z) slices.push_back(node(0, z));
+            combine(slices, false);
+            touched = added;
+        } else {
+            combine(nodes, true);
+            touched = static_cast<int>(nodes.size());
+        }
+    }
+    start = s;
+    end = e;
+}
+
+template <typename T>
+void SlabProjector<T>::scroll(int k) {
+    const int thickness = end - start + 1;
+    const int s = std::clamp(start + k, 0, volume->depth - thickness);
+    setWindow(s, s + thickness - 1);
+}
+
+template <typename T>
+const std::vector<T>& SlabProjector<T>::image() {
+    if (isMean && meanDirty) {
+        const Accum n = static_cast<Accum>(end - start + 1);
+        for (size_t i = 0; i < plane; ++i) {
+            result[i] = static_cast<T>(sums[i] / n);
+        }
+        meanDirty = false;
+    }
+    return result;
+}
+
+/**
+ * @brief Writes the projection; 16-bit output of an 8-bit AIP keeps the fraction of the
+ *        mean (sum * 257 / n, rounded) as AIPSlab does.
+ */
+template <typename T>
+bool SlabProjector<T>::write(const std::string& outFilename, const ImageWriteOptions& options) {
+    try {
+        if (std::is_same_v<T, unsigned char> && isMean && options.bitDepth == 16) {
+            const unsigned long long n = static_cast<unsigned long long>(end - start + 1);
+            std::vector<std::uint16_t> output16(plane);
+            for (size_t i = 0; i < plane; ++i) {
+                output16[i] = static_cast<std::uint16_t>((static_cast<unsigned long long>(sums[i]) * 257u + n / 2) / n);
+            }
+            writeVoxelPlane(output16.data(), width(), height(), channels(), outFilename, options);
+        } else {
+            writeVoxelPlane(image().data(), width(), height(), channels(), outFilename, options);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << "SlabProjector failed to write: " << outFilename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template class SlabProjector<unsigned char>;
+template class SlabProjector<std::uint16_t>;
+template class SlabProjector<float>;
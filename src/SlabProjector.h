@@ -0,0 +1,116 @@
+/*
+ * @file SlabProjector.h
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#ifndef SLAB_PROJECTOR_H
+#define SLAB_PROJECTOR_H
+
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Image.h"
+#include "Projections3D.h"
+#include "Volume.h"
+
+/**
+ * @class SlabProjector
+ * @brief Thick-slab MIP, MinIP or AIP of a window that moves through the volume, for
+ *        interactive slab scrolling.
+ *
+ * Where Projections3D::MIPSlab and friends start from scratch for every window, the
+ * projector keeps state between calls to setWindow():
+ * - AIP keeps the running per-pixel sums of the current window, so moving it adds the
+ *   slices that enter and subtracts those that leave: k plane operations for a move
+ *   of k slices (never more than the new window's thickness).
+ * - MIP and MinIP keep a segment tree of per-pixel extremes over the slices (level j
+ *   holds the extreme of each aligned run of 2^j slices; level 0 is the volume
+ *   itself). Any window is the combination of at most 2 * log2(depth) nodes, whatever
+ *   its thickness, and a window that only grows folds in just the new slices. The
+ *   tree costs about one extra copy of the volume.
+ *
+ * Results match MIPSlab, MinIPSlab and AIPSlab over the same window (AIP of float
+ * volumes up to rounding of the running sums). The projector reads the volume it was
+ * built from, which must outlive it and not change, unless the axis is X or Y: the
+ * volume is then permuted into a private copy as for Projections3D::slidingSlab.
+ * Instantiated for Volume, Volume16 and VolumeF.
+ */
+template <typename T>
+class SlabProjector {
+public:
+    /**
+     * @brief Prepares to project windows of a volume; builds the tree for MIP/MinIP.
+     *
+     * The initial window is the whole axis.
+     * @param vol The volume.
+     * @param projType "MIP", "MinIP" or "AIP".
+     * @param axis The axis the window moves along.
+     * @throws std::invalid_argument If the volume is empty or projType is unknown.
+     */
+    SlabProjector(const BasicVolume<T>& vol, const std::string& projType,
+                  ProjectionAxis axis = ProjectionAxis::Z);
+
+    // Holds a pointer into itself for the permuted axes
+    SlabProjector(const SlabProjector&) = delete;
+    SlabProjector& operator=(const SlabProjector&) = delete;
+
+    /**
+     * @brief Moves the window to slices [zStart, zEnd] (clamped and ordered like MIPSlab).
+     */
+    void setWindow(int zStart, int zEnd);
+
+    /**
+     * @brief Moves the window by k slices, keeping its thickness and stopping at the ends.
+     */
+    void scroll(int k);
+
+    int first() const { return start; }
+    int last() const { return end; }
+    int width() const { return volume->width; }
+    int height() const { return volume->height; }
+    int channels() const { return volume->channels; }
+
+    /**
+     * @brief The projection of the current window (width * height * channels values;
+     *        AIP means use integer division for integer voxels, as in AIPSlab).
+     */
+    const std::vector<T>& image();
+
+    /**
+     * @brief Writes the current projection like MIPSlab / MinIPSlab / AIPSlab would.
+     * @return False (after a message on std::cerr) if the file could not be written.
+     */
+    bool write(const std::string& outFilename, const ImageWriteOptions& options = ImageWriteOptions{});
+
+    // Slice planes read by the last setWindow() / scroll(): a measure of its cost
+    int planesTouched() const { return touched; }
+
+private:
+    using Accum = std::conditional_t<std::is_floating_point_v<T>, double, unsigned long long>;
+
+    const T* node(int level, int index) const;
+    void combine(const std::vector<const T*>& planes, bool first);
+    void addPlanes(int z0, int z1, bool subtract);
+
+    BasicVolume<T> turned;  // permuted copy for the X and Y axes
+    const BasicVolume<T>* volume;
+    bool isMax = false, isMean = false;
+    size_t plane = 0;
+    int start = 0, end = -1;
+    int touched = 0;
+
+    std::vector<std::vector<T>> levels;  // levels[j - 1] = tree level j, one plane per node
+    std::vector<Accum> sums;
+    std::vector<T> result;
+    bool meanDirty = true;
+};
+
+#endif // SLAB_PROJECTOR_H
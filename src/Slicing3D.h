@@ -1,64 +1,253 @@
-/**
- * @file Slicing3D.h
- * @brief Header file for the Slicing3D class, providing functionality to extract 2D slices from 3D volumes
- * @author Your Name
- *
- * This class provides methods for extracting 2D slices from 3D volumes along principal planes (xy, xz, yz).
- * Group Members:
- * - Jiaqi    (GitHub: esemsc-jc1424)
- * - Daicong  (GitHub: esemsc-c730ef50)
- * - Ida      (GitHub: esemsc-ifc24)
- * - Zhuyi    (GitHub: esemsc-zf1124)
- * - Dany     (GitHub: esemsc-dh324)
- * - Ethan    (GitHub: edsml-elm224)
- * - Keyun    (GitHub: esemsc-km824)
- */
-
-#ifndef SLICING3D_H
-#define SLICING3D_H
-
-#include "Volume.h"
-#include <string>
-
-class Slicing3D {
-public:
-    /**
-     * @brief Extract a slice from a 3D volume along a given plane
-     *
-     * @param vol The 3D volume to slice
-     * @param plane The plane to slice along ("xy", "xz", "yz")
-     * @param coordinate The coordinate at which to extract the slice
-     * @param outputPath The path to save the resulting 2D image
-     */
-    static void slice3D(const Volume& vol, const std::string& plane, int coordinate, const std::string& outputPath);
-
-private:
-    /**
-     * @brief Extract a slice in the xy plane at a given z-coordinate
-     *
-     * @param vol The 3D volume to slice
-     * @param z The z-coordinate at which to extract the slice
-     * @param outputPath The path to save the resulting image
-     */
-    static void sliceXY(const Volume& vol, int z, const std::string& outputPath);
-
-    /**
-     * @brief Extract a slice in the xz plane at a given y-coordinate
-     *
-     * @param vol The 3D volume to slice
-     * @param y The y-coordinate at which to extract the slice
-     * @param outputPath The path to save the resulting image
-     */
-    static void sliceXZ(const Volume& vol, int y, const std::string& outputPath);
-
-    /**
-     * @brief Extract a slice in the yz plane at a given x-coordinate
-     *
-     * @param vol The 3D volume to slice
-     * @param x The x-coordinate at which to extract the slice
-     * @param outputPath The path to save the resulting image
-     */
-    static void sliceYZ(const Volume& vol, int x, const std::string& outputPath);
-};
-
+/**
+ * @file Slicing3D.h
+ * @brief Header file for the Slicing3D class, providing functionality to extract 2D slices from 3D volumes
+ * @author Your Name
+ *
+ * This class provides methods for extracting 2D slices from 3D volumes along principal planes (xy, xz, yz).
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#ifndef SLICING3D_H
+#define SLICING3D_H
+
+#include "Volume.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief A point or direction in voxel coordinates (x = column, y = row, z = slice).
+ */
+struct Vec3 {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+};
+
+/**
+ * @brief An oblique sampling plane: a centre point and two orthonormal in-plane axes.
+ *
+ * Output pixel (i, j) of a W x H reslice with spacing s is sampled at
+ * center + (i - (W - 1) / 2) * s * u + (j - (H - 1) / 2) * s * v, so the centre
+ * lands in the middle of the image.
+ */
+struct ObliquePlane {
+    Vec3 center;  ///< Point on the plane, mapped to the centre of the output image
+    Vec3 u;       ///< Unit direction of increasing output column
+    Vec3 v;       ///< Unit direction of increasing output row
+
+    /**
+     * @brief Plane through a point with the given normal.
+     *
+     * u is the x axis (or the y axis when the normal is close to x) projected onto the
+     * plane, and v is chosen to point along +y/+z, so normals along z, y and x give the
+     * same orientation as the XY, XZ and YZ slices.
+     *
+     * @param point Point on the plane.
+     * @param normal Plane normal (need not be unit length).
+     * @throws std::invalid_argument If the normal is zero.
+     */
+    static ObliquePlane fromNormal(const Vec3& point, const Vec3& normal);
+
+    /**
+     * @brief Plane through three points, centred on their centroid, with u along a -> b
+     *        and c on the +v side.
+     *
+     * @throws std::invalid_argument If the points are collinear.
+     */
+    static ObliquePlane fromPoints(const Vec3& a, const Vec3& b, const Vec3& c);
+};
+
+class Slicing3D {
+public:
+    /**
+     * @brief Extract a slice from a 3D volume along a given plane
+     *
+     * @param vol The 3D volume to slice
+     * @param plane The plane to slice along ("xy", "xz", "yz")
+     * @param coordinate The coordinate at which to extract the slice
+     * @param outputPath The path to save the resulting 2D image
+     * @param options Encoder settings (uint16/float volumes write 16-bit PNGs unless bitDepth is 8)
+     */
+    template <typename T>
+    static void slice3D(const BasicVolume<T>& vol, const std::string& plane, int coordinate, const std::string& outputPath,
+                        const ImageWriteOptions& options = ImageWriteOptions{});
+
+    /**
+     * @brief Copy an axis-aligned slice into a buffer instead of a file
+     *
+     * XY slices are width x height, XZ slices width x depth and YZ slices height x depth,
+     * oriented as slice3D writes them.
+     *
+     * @param vol The 3D volume to slice
+     * @param plane The plane to slice along ("xy", "xz", "yz", any case)
+     * @param coordinate The coordinate at which to extract the slice
+     * @param out Receives outWidth * outHeight * vol.channels interleaved values
+     * @param outWidth Receives the slice width
+     * @param outHeight Receives the slice height
+     * @throws std::invalid_argument If the plane is unknown or the coordinate is out of range
+     */
+    template <typename T>
+    static void extractSlice(const BasicVolume<T>& vol, const std::string& plane, int coordinate,
+                             std::vector<T>& out, int& outWidth, int& outHeight);
+
+    /**
+     * @brief Resample a volume on an oblique plane (MPR) with trilinear interpolation
+     *
+     * Voxel centres sit at integer coordinates; samples within half a voxel of the
+     * volume are clamped to the edge and samples further out are 0. Rows are spread
+     * over threads and each row is interpolated four samples at a time with SSE2.
+     *
+     * @param vol The 3D volume to sample
+     * @param plane The sampling plane
+     * @param outWidth Output width in pixels
+     * @param outHeight Output height in pixels
+     * @param spacing Distance between output pixels, in voxels
+     * @param out Receives outWidth * outHeight * vol.channels interleaved samples
+     * @throws std::invalid_argument If the output size or spacing is not positive
+     */
+    template <typename T>
+    static void resliceOblique(const BasicVolume<T>& vol, const ObliquePlane& plane, int outWidth, int outHeight,
+                               double spacing, std::vector<T>& out);
+
+    /**
+     * @brief Resample a volume on an oblique plane and write the result to an image file
+     *
+     * @param vol The 3D volume to sample
+     * @param plane The sampling plane
+     * @param outWidth Output width in pixels
+     * @param outHeight Output height in pixels
+     * @param spacing Distance between output pixels, in voxels
+     * @param outputPath The path to save the resulting image
+     * @param options Encoder settings
+     * @return false (after printing the error) if the slice could not be sampled or written
+     */
+    template <typename T>
+    static bool sliceOblique(const BasicVolume<T>& vol, const ObliquePlane& plane, int outWidth, int outHeight,
+                             double spacing, const std::string& outputPath,
+                             const ImageWriteOptions& options = ImageWriteOptions{});
+
+    /**
+     * @brief Export every slice along an axis (or a strided range of them) in one pass
+     *
+     * Slices are handled in small groups: the group's columns are gathered tile by tile
+     * from each volume row, so YZ slices read contiguous runs instead of striding by the
+     * row length, and the groups are gathered and encoded on separate threads.
+     * Files are named after outputPath with the slice index appended before the
+     * extension, e.g. "out/sag.png" -> "out/sag_0012.png".
+     *
+     * @param vol The 3D volume to slice
+     * @param plane The plane to slice along ("xy", "xz", "yz")
+     * @param first First slice index (clamped to the volume)
+     * @param last Last slice index, or -1 for the last slice along the axis
+     * @param step Distance between exported slices (at least 1)
+     * @param outputPath Path pattern for the output files
+     * @param options Encoder settings
+     * @return The number of slices written
+     */
+    template <typename T>
+    static int exportSlices(const BasicVolume<T>& vol, const std::string& plane, int first, int last, int step,
+                            const std::string& outputPath, const ImageWriteOptions& options = ImageWriteOptions{});
+
+    /**
+     * @brief File name of one exported slice: outputPath with "_<index>" before the extension
+     *
+     * @param outputPath Path pattern, e.g. "out/sag.png"
+     * @param index The slice index
+     * @param digits Minimum number of digits (zero padded)
+     */
+    static std::string slicePath(const std::string& outputPath, int index, int digits = 4);
+
+    /**
+     * @brief Read a centreline from a text file: one "x y z" point per line
+     *
+     * Values may be separated by spaces, tabs or commas; blank lines and lines
+     * starting with '#' are skipped. Coordinates are in voxels.
+     *
+     * @param filename The text file to read
+     * @return The points in file order
+     * @throws std::runtime_error If the file cannot be read or a line is malformed
+     */
+    static std::vector<Vec3> loadPath(const std::string& filename);
+
+    /**
+     * @brief Straightened curved planar reformation (CPR) along a centreline
+     *
+     * The path (optionally smoothed with a Catmull-Rom spline through the points) is
+     * resampled every `spacing` voxels of arc length. A rotation-minimising frame is
+     * precomputed at each sample, and output row i is the line of outWidth samples
+     * through sample i along its frame normal, so the curve runs down the middle of the
+     * image. Rows are sampled in parallel with the oblique slice row sampler.
+     *
+     * @param vol The 3D volume to sample
+     * @param path Centreline points in voxel coordinates (at least two)
+     * @param outWidth Samples across the curve
+     * @param spacing Distance between samples, in voxels, along and across the curve
+     * @param spline True for a Catmull-Rom spline through the points, false for the polyline
+     * @param out Receives outWidth * outHeight * vol.channels interleaved samples
+     * @return outHeight, the number of samples along the curve
+     * @throws std::invalid_argument If the path is too short or the size/spacing is not positive
+     */
+    template <typename T>
+    static int reformatCurved(const BasicVolume<T>& vol, const std::vector<Vec3>& path, int outWidth, double spacing,
+                              bool spline, std::vector<T>& out);
+
+    /**
+     * @brief Curved planar reformation written to an image file
+     *
+     * @param vol The 3D volume to sample
+     * @param path Centreline points in voxel coordinates
+     * @param outWidth Samples across the curve
+     * @param spacing Sample distance in voxels
+     * @param spline True for a Catmull-Rom spline, false for the polyline
+     * @param outputPath The path to save the resulting image
+     * @param options Encoder settings
+     * @return false (after printing the error) if the reformation could not be sampled or written
+     */
+    template <typename T>
+    static bool sliceCurved(const BasicVolume<T>& vol, const std::vector<Vec3>& path, int outWidth, double spacing,
+                            bool spline, const std::string& outputPath,
+                            const ImageWriteOptions& options = ImageWriteOptions{});
+
+private:
+    /**
+     * @brief Extract a slice in the xy plane at a given z-coordinate
+     *
+     * @param vol The 3D volume to slice
+     * @param z The z-coordinate at which to extract the slice
+     * @param outputPath The path to save the resulting image
+     * @param options Encoder settings
+     */
+    template <typename T>
+    static void sliceXY(const BasicVolume<T>& vol, int z, const std::string& outputPath, const ImageWriteOptions& options);
+
+    /**
+     * @brief Extract a slice in the xz plane at a given y-coordinate
+     *
+     * @param vol The 3D volume to slice
+     * @param y The y-coordinate at which to extract the slice
+     * @param outputPath The path to save the resulting image
+     * @param options Encoder settings
+     */
+    template <typename T>
+    static void sliceXZ(const BasicVolume<T>& vol, int y, const std::string& outputPath, const ImageWriteOptions& options);
+
+    /**
+     * @brief Extract a slice in the yz plane at a given x-coordinate
+     *
+     * @param vol The 3D volume to slice
+     * @param x The x-coordinate at which to extract the slice
+     * @param outputPath The path to save the resulting image
+     * @param options Encoder settings
+     */
+    template <typename T>
+    static void sliceYZ(const BasicVolume<T>& vol, int x, const std::string& outputPath, const ImageWriteOptions& options);
+};
+
 #endif // SLICING3D_H
\ No newline at end of file
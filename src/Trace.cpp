@@ -0,0 +1,236 @@
+/*
+ * @file Trace.cpp
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#include "Trace.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <sys/resource.h>
+
+namespace {
+
+std::mutex eventsMutex;
+std::vector<Trace::Event> recorded;
+std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+std::atomic<int> nextThread{ 0 };
+thread_local int threadIndex = -1;
+thread_local int openScopes = 0;
+
+double nowUs() {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+// User + system CPU time of the whole process, in seconds
+double processCpuSeconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+double peakRssMB() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / (1024.0 * 1024.0); // bytes
+#else
+    return usage.ru_maxrss / 1024.0;            // kilobytes
+#endif
+}
+
+int currentThread() {
+    if (threadIndex < 0) {
+        threadIndex = nextThread++;
+    }
+    return threadIndex;
+}
+
+std::string jsonEscape(const std::string &text) {
+    std::string out;
+    out.reserve(text.size());
+    for (char ch : text) {
+        if (ch == '"' || ch == '\\') {
+            out += '\\';
+            out += ch;
+        } else if (static_cast<unsigned char>(ch) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(ch)));
+            out += code;
+        } else {
+            out += ch;
+        }
+    }
+    return out;
+}
+
+// Average busy threads over a stage: CPU time per second of wall time
+double busyThreads(const Trace::Event &e) {
+    return e.durationUs > 0.0 ? e.cpuSeconds / (e.durationUs * 1e-6) : 0.0;
+}
+
+} // namespace
+
+void Trace::Scope::start(const char *cat, const std::string &stage, const std::string &detail) {
+    category = cat;
+    name = detail.empty() ? stage : stage + " " + detail;
+    depth = openScopes++;
+    cpuStart = processCpuSeconds();
+    startUs = nowUs();
+}
+
+void Trace::Scope::finish() {
+    const double endUs = nowUs();
+    --openScopes;
+
+    Event e;
+    e.name = std::move(name);
+    e.category = category;
+    e.startUs = startUs;
+    e.durationUs = endUs - startUs;
+    e.bytes = bytes;
+    e.cpuSeconds = std::max(0.0, processCpuSeconds() - cpuStart);
+    e.peakRssMB = peakRssMB();
+    e.depth = depth;
+    e.thread = currentThread();
+
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    recorded.push_back(std::move(e));
+}
+
+Trace::Session::Session(const std::string &path) : jsonPath(path) {
+    Trace::enable();
+}
+
+Trace::Session::~Session() {
+    Trace::disable();
+    try {
+        if (jsonPath.empty()) {
+            Trace::writeSummary(std::cout);
+        } else {
+            Trace::writeChromeTrace(jsonPath);
+            std::cout << "[Trace] " << jsonPath << "\n";
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << "[WARN] Trace not written: " << e.what() << "\n";
+    }
+}
+
+void Trace::enable() {
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    recorded.clear();
+    epoch = std::chrono::steady_clock::now();
+    // The enabling thread is the main timeline in the Chrome trace
+    threadIndex = -1;
+    nextThread = 0;
+    currentThread();
+    active.store(true, std::memory_order_relaxed);
+}
+
+void Trace::disable() {
+    active.store(false, std::memory_order_relaxed);
+}
+
+std::vector<Trace::Event> Trace::events() {
+    std::vector<Event> sorted;
+    {
+        std::lock_guard<std::mutex> lock(eventsMutex);
+        sorted = recorded;
+    }
+    // Scopes are recorded as they end, so children come before their parents
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Event &a, const Event &b) {
+        return a.startUs != b.startUs ? a.startUs < b.startUs : a.depth < b.depth;
+    });
+    return sorted;
+}
+
+void Trace::writeSummary(std::ostream &out) {
+    const std::vector<Event> list = events();
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+
+    out << std::fixed << std::setprecision(2);
+    out << "[Trace] " << std::left << std::setw(32) << "stage" << std::right << std::setw(11) << "wall ms"
+        << std::setw(10) << "MB" << std::setw(10) << "MB/s" << std::setw(9) << "threads" << std::setw(13)
+        << "peak RSS MB" << "\n";
+
+    double totalUs = 0.0;
+    double totalCpu = 0.0;
+    double peak = 0.0;
+    for (const Event &e : list) {
+        const double mb = e.bytes / 1e6;
+        const double seconds = e.durationUs * 1e-6;
+        std::string label = std::string(2 * e.depth, ' ') + e.name;
+        if (e.thread != 0) {
+            label += " [t" + std::to_string(e.thread) + "]";
+        }
+        out << "[Trace] " << std::left << std::setw(32) << label << std::right << std::setw(11)
+            << e.durationUs / 1000.0 << std::setw(10) << mb << std::setw(10)
+            << (seconds > 0.0 ? mb / seconds : 0.0) << std::setw(9) << busyThreads(e) << std::setw(13)
+            << e.peakRssMB << "\n";
+        if (e.depth == 0 && e.thread == 0) {
+            totalUs += e.durationUs;
+            totalCpu += e.cpuSeconds;
+        }
+        peak = std::max(peak, e.peakRssMB);
+    }
+    out << "[Trace] " << std::left << std::setw(32) << "total" << std::right << std::setw(11) << totalUs / 1000.0
+        << std::setw(10) << "" << std::setw(10) << "" << std::setw(9)
+        << (totalUs > 0.0 ? totalCpu / (totalUs * 1e-6) : 0.0) << std::setw(13) << peak << "\n";
+    out << "[Trace] threads = average busy threads (CPU time / wall time), " << Parallel::threadCount()
+        << " available\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Trace::writeChromeTrace(std::ostream &out) {
+    const std::vector<Event> list = events();
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"threads_available\":" << Parallel::threadCount()
+        << "},\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"APImageFilters\"}}";
+    for (const Event &e : list) {
+        out << ",\n{\"name\":\"" << jsonEscape(e.name) << "\",\"cat\":\"" << jsonEscape(e.category)
+            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread << ",\"ts\":" << e.startUs << ",\"dur\":"
+            << e.durationUs << ",\"args\":{\"bytes\":" << e.bytes << ",\"cpu_ms\":" << e.cpuSeconds * 1000.0
+            << ",\"busy_threads\":" << busyThreads(e) << ",\"peak_rss_mb\":" << e.peakRssMB << "}}";
+        out << ",\n{\"name\":\"peak RSS\",\"ph\":\"C\",\"pid\":1,\"ts\":" << e.startUs + e.durationUs
+            << ",\"args\":{\"MB\":" << e.peakRssMB << "}}";
+    }
+    out << "\n]}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Trace::writeChromeTrace(const std::string &path) {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    writeChromeTrace(file);
+    if (!file.flush()) {
+        throw std::runtime_error("failed writing " + path);
+    }
+}
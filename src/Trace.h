@@ -0,0 +1,153 @@
+/*
+ * @file Trace.h
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @class Trace
+ * @brief Lightweight scoped timing of pipeline stages (load, each operation, write).
+ *
+ * A Trace::Scope placed around a stage records its wall time, the bytes it was told it
+ * touched, the process CPU time spent meanwhile (so CPU / wall is the average number of
+ * busy threads) and the peak resident set size when it ended. Scopes nest: a scope
+ * opened while another is running on the same thread is recorded as its child.
+ *
+ * Tracing is off until enable() is called. While it is off a Scope only tests one
+ * atomic flag, so scopes can stay in hot paths at no measurable cost.
+ *
+ * The recorded events can be printed as a per-stage summary table or written as
+ * Chrome trace-event JSON, which chrome://tracing and https://ui.perfetto.dev open.
+ */
+class Trace {
+public:
+    /**
+     * @brief One finished scope.
+     */
+    struct Event {
+        std::string name;       ///< Stage name, e.g. "load" or "blur Gaussian"
+        std::string category;   ///< Kind of stage ("io", "op", ...)
+        double startUs = 0.0;   ///< Start, in microseconds since enable()
+        double durationUs = 0.0; ///< Wall time in microseconds
+        std::size_t bytes = 0;  ///< Bytes read and written by the stage
+        double cpuSeconds = 0.0; ///< Process CPU time (user + system) spent during the stage
+        double peakRssMB = 0.0; ///< Peak resident set size of the process when the stage ended
+        int depth = 0;          ///< Nesting depth on its thread (0 = outermost)
+        int thread = 0;         ///< Small per-thread index, 0 for the first thread traced
+    };
+
+    /**
+     * @brief Records a stage from construction to destruction if tracing is enabled.
+     */
+    class Scope {
+    public:
+        /**
+         * @param category Kind of stage ("io", "op", ...).
+         * @param name Stage name.
+         * @param detail Optional qualifier appended to the name (e.g. the blur type).
+         */
+        Scope(const char* category, const std::string& name, const std::string& detail = std::string())
+            : live(Trace::enabled()) {
+            if (live) {
+                start(category, name, detail);
+            }
+        }
+        ~Scope() {
+            if (live) {
+                finish();
+            }
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        /**
+         * @brief Adds to the bytes the stage touched (input and output buffers).
+         */
+        void addBytes(std::size_t count) { bytes += count; }
+
+    private:
+        void start(const char* category, const std::string& name, const std::string& detail);
+        void finish();
+
+        bool live;
+        std::size_t bytes = 0;
+        const char* category = "";
+        std::string name;
+        double startUs = 0.0;
+        double cpuStart = 0.0;
+        int depth = 0;
+    };
+
+    /**
+     * @brief Writes the trace when it goes out of scope: as Chrome JSON to jsonPath, or
+     *        as the summary table on std::cout when jsonPath is empty.
+     *
+     * Construction enables tracing; write failures only print a warning.
+     */
+    class Session {
+    public:
+        explicit Session(const std::string& jsonPath);
+        ~Session();
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+
+    private:
+        std::string jsonPath;
+    };
+
+    /**
+     * @brief Starts recording, discarding any earlier events; times are measured from here.
+     */
+    static void enable();
+
+    /**
+     * @brief Stops recording new scopes (scopes already open still finish).
+     */
+    static void disable();
+
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief The finished scopes, in order of their start time.
+     */
+    static std::vector<Event> events();
+
+    /**
+     * @brief Prints one line per scope (children indented) with wall time, data size,
+     *        throughput, busy threads and peak RSS, then the total of the outermost scopes.
+     */
+    static void writeSummary(std::ostream& out);
+
+    /**
+     * @brief Writes the events as Chrome trace-event JSON: one complete ("X") event per
+     *        scope with the measurements as args, plus a "peak RSS" counter track.
+     */
+    static void writeChromeTrace(std::ostream& out);
+
+    /**
+     * @brief writeChromeTrace() to a file.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    static void writeChromeTrace(const std::string& path);
+
+private:
+    inline static std::atomic<bool> active{ false };
+};
+
+#endif // TRACE_H
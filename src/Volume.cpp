@@ -23,8 +23,15 @@
 #include <algorithm>
 #include <dirent.h>
 #include <sys/stat.h>
+#include <cmath>
+#include <type_traits>
+#include "Parallel.h"
 #include "stb_image.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 /**
  * @brief Extracts the slice number from a filename.
  * 
@@ -100,40 +107,17 @@ static std::pair<std::string, std::string> splitDirectoryAndPrefix(const std::st
 }
 
 /**
- * @brief Default constructor for Volume, initializing an empty volume.
- */
-Volume::Volume()
-  : width(0), height(0), depth(0), channels(1)
-{
-    // empty
-}
-
-/**
- * @brief Constructs a Volume with given dimensions and channels.
+ * @brief Collects the slice files selected by a folder path (or folder + prefix).
  * 
- * @param w Width of the volume.
- * @param h Height of the volume.
- * @param d Depth (number of slices) of the volume.
- * @param c Number of channels per voxel.
- */
-Volume::Volume(int w, int h, int d, int c)
-  : width(w), height(h), depth(d), channels(c)
-{
-    data.resize(static_cast<size_t>(w)*h*d*c, 0);
-}
-
-/**
- * @brief Loads a 3D volume from a sequence of 2D image slices.
- * 
- * @param folderPath The path to the folder containing the slice images.
- * @return True if the volume was successfully loaded, false otherwise.
+ * @param folderPath The folder, optionally followed by a filename prefix.
+ * @param firstSlice The first slice number to include.
+ * @param lastSlice The last slice number to include (-1 for all).
+ * @param error If set, receives the reason the folder cannot be read instead of std::cerr.
+ * @return The matching files, sorted by slice number (empty if none or on error).
  */
-bool Volume::loadVolumeFromSlices(const std::string &folderPath)
+static std::vector<std::string> collectSlices(const std::string &folderPath, int firstSlice, int lastSlice,
+                                              std::string *error = nullptr)
 {
-    data.clear();
-    width = height = depth = 0;
-    channels = 1;
-
     // 1) Split into (actualDir, prefix)
     auto parts = splitDirectoryAndPrefix(folderPath);
     const std::string &actualDir = parts.first;   // "Scans/TestVolume"
@@ -142,8 +126,12 @@ bool Volume::loadVolumeFromSlices(const std::string &folderPath)
     // 2) Attempt to open that directory
     DIR* dir = opendir(actualDir.c_str());
     if (!dir) {
-        std::cerr << "Cannot open directory: " << actualDir << std::endl;
-        return false;
+        if (error) {
+            *error = "Cannot open directory: " + actualDir;
+        } else {
+            std::cerr << "Cannot open directory: " << actualDir << std::endl;
+        }
+        return {};
     }
 
     std::vector< std::pair<std::string,int> > filesWithIndex;
@@ -187,11 +175,6 @@ bool Volume::loadVolumeFromSlices(const std::string &folderPath)
     }
     closedir(dir);
 
-    if (filesWithIndex.empty()) {
-        std::cerr << "No slices found in " << folderPath << std::endl;
-        return false;
-    }
-
     // Sort by sliceNumber ascending
     std::sort(filesWithIndex.begin(), filesWithIndex.end(),
         [](const std::pair<std::string,int> &a, const std::pair<std::string,int> &b){
@@ -199,58 +182,171 @@ bool Volume::loadVolumeFromSlices(const std::string &folderPath)
         }
     );
 
-    // 'depth' = number of slices
-    depth = static_cast<int>(filesWithIndex.size());
+    std::vector<std::string> files;
+    files.reserve(filesWithIndex.size());
+    for (const auto &f : filesWithIndex) {
+        files.push_back(f.first);
+    }
+    return files;
+}
 
-    // Load first slice to get width/height
-    {
-        int w, h, c;
-        unsigned char* tempData = stbi_load(filesWithIndex[0].first.c_str(), &w, &h, &c, 1);
-        if (!tempData) {
-            std::cerr << "Failed to load first slice: "
-                      << filesWithIndex[0].first << std::endl;
-            return false;
+/**
+ * @brief Loads one slice as interleaved voxels of type T.
+ * 
+ * 8-bit volumes keep the original stbi_load path. Wider types read 16-bit files with
+ * stbi_load_16 so the extra precision survives; 8-bit files are widened (x257 for
+ * uint16, /255 for float) so every type spans the same intensity range.
+ * 
+ * @param filepath The slice file.
+ * @param channels Channels per voxel; stb converts slices stored differently.
+ * @param w Receives the slice width.
+ * @param h Receives the slice height.
+ * @param out Receives w * h * channels voxels.
+ * @return True on success.
+ */
+template <typename T>
+static bool loadSlice(const std::string &filepath, int channels, int &w, int &h, std::vector<T> &out)
+{
+    int c;
+    if constexpr (std::is_same_v<T, unsigned char>) {
+        unsigned char* pixels = stbi_load(filepath.c_str(), &w, &h, &c, channels);
+        if (!pixels) return false;
+        out.assign(pixels, pixels + static_cast<size_t>(w) * h * channels);
+        stbi_image_free(pixels);
+    }
+    else if (stbi_is_16_bit(filepath.c_str())) {
+        stbi_us* pixels = stbi_load_16(filepath.c_str(), &w, &h, &c, channels);
+        if (!pixels) return false;
+        out.resize(static_cast<size_t>(w) * h * channels);
+        for (size_t i = 0; i < out.size(); ++i) {
+            if constexpr (std::is_floating_point_v<T>) {
+                out[i] = static_cast<T>(pixels[i] / 65535.0);
+            } else {
+                out[i] = static_cast<T>(pixels[i]);
+            }
         }
-        width = w;
-        height = h;
-        stbi_image_free(tempData);
+        stbi_image_free(pixels);
     }
+    else {
+        unsigned char* pixels = stbi_load(filepath.c_str(), &w, &h, &c, channels);
+        if (!pixels) return false;
+        out.resize(static_cast<size_t>(w) * h * channels);
+        for (size_t i = 0; i < out.size(); ++i) {
+            if constexpr (std::is_floating_point_v<T>) {
+                out[i] = static_cast<T>(pixels[i] / 255.0);
+            } else {
+                out[i] = static_cast<T>(pixels[i] * 257);
+            }
+        }
+        stbi_image_free(pixels);
+    }
+    return true;
+}
 
-    // Allocate
-    data.resize(static_cast<size_t>(width)*height*depth, 0);
+/**
+ * @brief Default constructor for Volume, initializing an empty volume.
+ */
+template <typename T>
+BasicVolume<T>::BasicVolume()
+  : width(0), height(0), depth(0), channels(1)
+{
+    // empty
+}
+
+/**
+ * @brief Constructs a Volume with given dimensions and channels.
+ * 
+ * @param w Width of the volume.
+ * @param h Height of the volume.
+ * @param d Depth (number of slices) of the volume.
+ * @param c Number of channels per voxel.
+ */
+template <typename T>
+BasicVolume<T>::BasicVolume(int w, int h, int d, int c)
+  : width(w), height(h), depth(d), channels(c)
+{
+    data.resize(static_cast<size_t>(w)*h*d*c, T(0));
+}
+
+/**
+ * @brief Loads a 3D volume from a sequence of 2D image slices.
+ * 
+ * Voxels are stored interleaved, (x, y, z) holding all its channels back to back,
+ * the same layout as Image and the slice files. `channels` selects how many are
+ * kept (1 = grey, as before); 0 takes the count stored in the first slice.
+ * 
+ * @param folderPath The path to the folder containing the slice images.
+ * @param error If set, the load is silent: nothing goes to std::cout or std::cerr and
+ *              the reason for a failure is stored here (for library callers).
+ * @return True if the volume was successfully loaded, false otherwise.
+ */
+template <typename T>
+bool BasicVolume<T>::loadVolumeFromSlices(const std::string &folderPath, std::string *error)
+{
+    auto failed = [error](const std::string &message) {
+        if (error) {
+            *error = message;
+        } else {
+            std::cerr << message << std::endl;
+        }
+        return false;
+    };
+
+    data.clear();
+    width = height = depth = 0;
+    if (channels < 0 || channels > 4) {
+        if (!error) {
+            std::cerr << "[WARN] Volumes hold 1 to 4 channels; loading the stored count\n";
+        }
+        channels = 0;
+    }
+
+    std::string folderError;
+    std::vector<std::string> files = collectSlices(folderPath, firstSlice, lastSlice, error ? &folderError : nullptr);
+    if (files.empty()) {
+        return failed(folderError.empty() ? "No slices found in " + folderPath : folderError);
+    }
+
+    // 'depth' = number of slices
+    depth = static_cast<int>(files.size());
+
+    if (channels == 0) {
+        int w, h;
+        if (!stbi_info(files[0].c_str(), &w, &h, &channels)) {
+            return failed("Failed to load first slice: " + files[0]);
+        }
+    }
 
-    // Load each slice
+    // Load each slice; the first one fixes width/height
+    std::vector<T> slice;
     for (int z = 0; z < depth; ++z) {
-        const std::string &filepath = filesWithIndex[z].first;
+        const std::string &filepath = files[z];
 
-        int w, h, c;
-        unsigned char* sliceData = stbi_load(filepath.c_str(), &w, &h, &c, 1);
-        if (!sliceData) {
-            std::cerr << "Failed to load slice: " << filepath << std::endl;
-            return false;
+        int w, h;
+        if (!loadSlice(filepath, channels, w, h, slice)) {
+            return failed((z == 0 ? "Failed to load first slice: " : "Failed to load slice: ") + filepath);
         }
-        if (w != width || h != height) {
-            std::cerr << "Slice dimension mismatch at " << filepath << std::endl;
-            stbi_image_free(sliceData);
-            return false;
+        if (z == 0) {
+            width = w;
+            height = h;
+            data.resize(static_cast<size_t>(width)*height*depth*channels, T(0));
+        }
+        else if (w != width || h != height) {
+            return failed("Slice dimension mismatch at " + filepath);
         }
 
         // Copy
-        for (int row = 0; row < height; ++row) {
-            for (int col = 0; col < width; ++col) {
-                size_t idx = col
-                           + static_cast<size_t>(width) *
-                             (row + static_cast<size_t>(height)* z);
-                data[idx] = sliceData[row*width + col];
-            }
-        }
-        stbi_image_free(sliceData);
+        std::copy(slice.begin(), slice.end(), data.begin() + static_cast<size_t>(width)*height*channels*z);
     }
 
+    if (error) {
+        return true;
+    }
     std::cout << "Loaded " << depth 
               << " slices from " << folderPath << std::endl
               << "Volume dimension: "
               << width << " x " << height << " x " << depth
+              << (channels > 1 ? " x " + std::to_string(channels) + " channels" : std::string())
               << std::endl;
 
     return true;
@@ -263,10 +359,11 @@ bool Volume::loadVolumeFromSlices(const std::string &folderPath)
  * @param y The y-coordinate.
  * @param z The z-coordinate.
  * @param c The channel index (default is 0 for grayscale images).
- * @return The voxel value as an unsigned char.
+ * @return The voxel value.
  * @throws std::out_of_range If the coordinates are out of bounds.
  */
-unsigned char Volume::getVoxel(int x, int y, int z, int c) const
+template <typename T>
+T BasicVolume<T>::getVoxel(int x, int y, int z, int c) const
 {
     if (x < 0 || x >= width ||
         y < 0 || y >= height ||
@@ -293,7 +390,8 @@ unsigned char Volume::getVoxel(int x, int y, int z, int c) const
  * @param c The channel index (default is 0 for grayscale images).
  * @throws std::out_of_range If the coordinates are out of bounds.
  */
-void Volume::setVoxel(int x, int y, int z, unsigned char value, int c)
+template <typename T>
+void BasicVolume<T>::setVoxel(int x, int y, int z, T value, int c)
 {
     if (x < 0 || x >= width ||
         y < 0 || y >= height ||
@@ -309,3 +407,348 @@ void Volume::setVoxel(int x, int y, int z, unsigned char value, int c)
                  + static_cast<size_t>(height)*z ) );
     data[idx] = value;
 }
+
+namespace {
+
+// Tile edge for the blocked transpose: 16 rows of 16 voxels fit in L1 on both sides
+constexpr int kTransposeTile = 16;
+
+#if defined(__SSE2__)
+/**
+ * @brief Transposes a 16 x 16 byte tile in registers.
+ *
+ * Each round interleaves row i with row i + 8, which rotates the 8-bit (row, column)
+ * address left by one bit; four rounds swap the row and column nibbles.
+ */
+inline void transposeTile8(const unsigned char* src, size_t srcStride, unsigned char* dst, size_t dstStride) {
+    __m128i r[16], t[16];
+    for (int i = 0; i < 16; ++i) {
+        r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * srcStride));
+    }
+    for (int round = 0; round < 4; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            t[2 * i] = _mm_unpacklo_epi8(r[i], r[i + 8]);
+            t[2 * i + 1] = _mm_unpackhi_epi8(r[i], r[i + 8]);
+        }
+        std::copy(t, t + 16, r);
+    }
+    for (int i = 0; i < 16; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * dstStride), r[i]);
+    }
+}
+
+/**
+ * @brief Transposes an 8 x 8 tile of 16-bit samples in registers (three unpack rounds).
+ */
+inline void transposeTile16(const std::uint16_t* src, size_t srcStride, std::uint16_t* dst, size_t dstStride) {
+    __m128i r[8], t[8];
+    for (int i = 0; i < 8; ++i) {
+        r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * srcStride));
+    }
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            t[2 * i] = _mm_unpacklo_epi16(r[i], r[i + 4]);
+            t[2 * i + 1] = _mm_unpackhi_epi16(r[i], r[i + 4]);
+        }
+        std::copy(t, t + 8, r);
+    }
+    for (int i = 0; i < 8; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * dstStride), r[i]);
+    }
+}
+#endif
+
+/**
+ * @brief Transposes one tile of up to 16 x 16 voxels element by element.
+ */
+template <typename T>
+void transposeTileScalar(const T* src, size_t srcStride, T* dst, size_t dstStride, int rows, int cols, int channels) {
+    for (int c = 0; c < cols; ++c) {
+        T* out = dst + c * dstStride;
+        const T* in = src + static_cast<size_t>(c) * channels;
+        for (int r = 0; r < rows; ++r) {
+            for (int k = 0; k < channels; ++k) {
+                out[static_cast<size_t>(r) * channels + k] = in[r * srcStride + k];
+            }
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Blocked transpose of a rows x cols matrix of interleaved voxels.
+ *
+ * @param src First source voxel; rows are srcStride elements apart.
+ * @param srcStride Source row stride in elements.
+ * @param dst First destination voxel; destination rows (source columns) are dstStride apart.
+ * @param dstStride Destination row stride in elements.
+ * @param rows Source rows (destination columns).
+ * @param cols Source columns (destination rows).
+ * @param channels Interleaved channels per voxel.
+ */
+template <typename T>
+void transposeBlock(const T* src, size_t srcStride, T* dst, size_t dstStride, int rows, int cols, int channels)
+{
+    for (int r0 = 0; r0 < rows; r0 += kTransposeTile) {
+        const int tileRows = std::min(kTransposeTile, rows - r0);
+        for (int c0 = 0; c0 < cols; c0 += kTransposeTile) {
+            const int tileCols = std::min(kTransposeTile, cols - c0);
+            const T* in = src + r0 * srcStride + static_cast<size_t>(c0) * channels;
+            T* out = dst + c0 * dstStride + static_cast<size_t>(r0) * channels;
+#if defined(__SSE2__)
+            if (channels == 1 && tileRows == kTransposeTile && tileCols == kTransposeTile) {
+                if constexpr (std::is_same_v<T, unsigned char>) {
+                    transposeTile8(in, srcStride, out, dstStride);
+                    continue;
+                } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+                    for (int i = 0; i < kTransposeTile; i += 8) {
+                        for (int j = 0; j < kTransposeTile; j += 8) {
+                            transposeTile16(in + i * srcStride + j, srcStride, out + j * dstStride + i, dstStride);
+                        }
+                    }
+                    continue;
+                }
+            }
+#endif
+            transposeTileScalar(in, srcStride, out, dstStride, tileRows, tileCols, channels);
+        }
+    }
+}
+
+/**
+ * @brief Returns a copy of the volume with its axes reordered.
+ *
+ * Orders that keep x only move whole rows. The others are a stack of 2D transposes:
+ * each plane at a fixed value of the axis that stays put (z for YXZ/YZX, y for
+ * ZXY/ZYX) is transposed with transposeBlock() straight into its place in the
+ * output. Planes are spread over threads.
+ *
+ * @param order Source axes that become the new x, y and z.
+ * @return The permuted volume (slice range and extension are copied unchanged).
+ */
+template <typename T>
+BasicVolume<T> BasicVolume<T>::permuted(AxisOrder order) const
+{
+    const int W = width, H = height, D = depth, C = channels;
+    const size_t row = static_cast<size_t>(W) * C;
+    const size_t plane = row * H;
+
+    BasicVolume<T> out;
+    out.channels = C;
+    out.firstSlice = firstSlice;
+    out.lastSlice = lastSlice;
+    out.extension = extension;
+    switch (order) {
+        case AxisOrder::XYZ: out.width = W; out.height = H; out.depth = D; break;
+        case AxisOrder::XZY: out.width = W; out.height = D; out.depth = H; break;
+        case AxisOrder::YXZ: out.width = H; out.height = W; out.depth = D; break;
+        case AxisOrder::YZX: out.width = H; out.height = D; out.depth = W; break;
+        case AxisOrder::ZXY: out.width = D; out.height = W; out.depth = H; break;
+        case AxisOrder::ZYX: out.width = D; out.height = H; out.depth = W; break;
+    }
+    out.data.resize(data.size());
+    if (data.empty()) {
+        return out;
+    }
+
+    const T* src = data.data();
+    T* dst = out.data.data();
+    switch (order) {
+        case AxisOrder::XYZ:
+            out.data = data;
+            break;
+        case AxisOrder::XZY:
+            // Row y of slice z becomes row z of slice y
+            Parallel::forBands(0, H, [&](int yBegin, int yEnd) {
+                for (int y = yBegin; y < yEnd; ++y) {
+                    for (int z = 0; z < D; ++z) {
+                        std::copy(src + z * plane + y * row, src + z * plane + (y + 1) * row,
+                                  dst + (static_cast<size_t>(y) * D + z) * row);
+                    }
+                }
+            });
+            break;
+        case AxisOrder::YXZ:
+        case AxisOrder::YZX:
+            // Per z: the (y, x) plane is transposed; x becomes the new y (YXZ) or z (YZX)
+            Parallel::forBands(0, D, [&](int zBegin, int zEnd) {
+                for (int z = zBegin; z < zEnd; ++z) {
+                    if (order == AxisOrder::YXZ) {
+                        transposeBlock(src + z * plane, row, dst + z * plane, static_cast<size_t>(H) * C, H, W, C);
+                    } else {
+                        transposeBlock(src + z * plane, row, dst + static_cast<size_t>(z) * H * C,
+                                       static_cast<size_t>(D) * H * C, H, W, C);
+                    }
+                }
+            });
+            break;
+        case AxisOrder::ZXY:
+        case AxisOrder::ZYX:
+            // Per y: the (z, x) plane is transposed; x becomes the new y (ZXY) or z (ZYX)
+            Parallel::forBands(0, H, [&](int yBegin, int yEnd) {
+                for (int y = yBegin; y < yEnd; ++y) {
+                    if (order == AxisOrder::ZXY) {
+                        transposeBlock(src + y * row, plane, dst + static_cast<size_t>(y) * W * D * C,
+                                       static_cast<size_t>(D) * C, D, W, C);
+                    } else {
+                        transposeBlock(src + y * row, plane, dst + static_cast<size_t>(y) * D * C,
+                                       static_cast<size_t>(H) * D * C, D, W, C);
+                    }
+                }
+            });
+            break;
+    }
+    return out;
+}
+
+/**
+ * @brief Converts an axis order name to an AxisOrder.
+ * 
+ * @param name Three letters, e.g. "yzx" (case-insensitive).
+ * @return The matching order, or XYZ for unknown names.
+ */
+AxisOrder GetAxisOrder(const std::string &name)
+{
+    std::string upper = name;
+    std::transform(upper.begin(), upper.end(), upper.begin(),
+                   [](unsigned char ch) { return static_cast<char>(std::toupper(ch)); });
+    if (upper == "XYZ") return AxisOrder::XYZ;
+    if (upper == "XZY") return AxisOrder::XZY;
+    if (upper == "YXZ") return AxisOrder::YXZ;
+    if (upper == "YZX") return AxisOrder::YZX;
+    if (upper == "ZXY") return AxisOrder::ZXY;
+    if (upper == "ZYX") return AxisOrder::ZYX;
+    std::cerr << "[WARN] Unknown axis order: " << name << " (defaulting to XYZ)\n";
+    return AxisOrder::XYZ;
+}
+
+/**
+ * @brief Converts a voxel type name to a VoxelType.
+ * 
+ * @param name The type name.
+ * @return The matching type, or Auto for unknown names.
+ */
+VoxelType GetVoxelType(const std::string &name)
+{
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+    if (lower == "auto") return VoxelType::Auto;
+    if (lower == "uint8" || lower == "u8") return VoxelType::UInt8;
+    if (lower == "uint16" || lower == "u16") return VoxelType::UInt16;
+    if (lower == "float" || lower == "float32" || lower == "f32") return VoxelType::Float32;
+    std::cerr << "[WARN] Unknown voxel type: " << name << " (defaulting to auto)\n";
+    return VoxelType::Auto;
+}
+
+/**
+ * @brief Picks the storage type that matches the slices on disk.
+ * 
+ * @param folderPath The folder (or folder + prefix) holding the slices.
+ * @param firstSlice The first slice number to include.
+ * @param lastSlice The last slice number to include (-1 for all).
+ * @return UInt16 if the first selected slice is a 16-bit file, otherwise UInt8.
+ */
+VoxelType probeVoxelType(const std::string &folderPath, int firstSlice, int lastSlice)
+{
+    // Silent: the load that follows reports a folder that cannot be read
+    std::string unreadable;
+    std::vector<std::string> files = collectSlices(folderPath, firstSlice, lastSlice, &unreadable);
+    if (!files.empty() && stbi_is_16_bit(files.front().c_str())) {
+        return VoxelType::UInt16;
+    }
+    return VoxelType::UInt8;
+}
+
+/**
+ * @brief Fingerprint of the selected slice files (FNV-1a over name, size and mtime).
+ * 
+ * @param folderPath Folder (or folder/prefix) of the slices.
+ * @param firstSlice The first slice number to include.
+ * @param lastSlice The last slice number to include (-1 for all).
+ * @return The stamp; a folder with no matching slices gives the stamp of an empty list.
+ */
+std::uint64_t sliceStamp(const std::string &folderPath, int firstSlice, int lastSlice)
+{
+    std::uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](const void *bytes, size_t n) {
+        const unsigned char *p = static_cast<const unsigned char *>(bytes);
+        for (size_t i = 0; i < n; ++i) {
+            hash = (hash ^ p[i]) * 1099511628211ull;
+        }
+    };
+    for (const std::string &file : collectSlices(folderPath, firstSlice, lastSlice)) {
+        struct stat sb;
+        if (stat(file.c_str(), &sb) != 0) {
+            continue;
+        }
+        const std::int64_t size = sb.st_size, mtime = sb.st_mtime;
+        mix(file.data(), file.size());
+        mix(&size, sizeof(size));
+        mix(&mtime, sizeof(mtime));
+    }
+    return hash;
+}
+
+/**
+ * @brief Writes a plane of voxels, picking the file depth from the options and type.
+ * 
+ * @param plane The voxels, w * h * c values.
+ * @param w Width.
+ * @param h Height.
+ * @param c Channels.
+ * @param path Output file; the extension picks the format.
+ * @param options Encoder settings.
+ * @throws std::runtime_error If writing fails.
+ */
+template <typename T>
+void writeVoxelPlane(const T* plane, int w, int h, int c, const std::string &path,
+                     const ImageWriteOptions &options)
+{
+    const size_t count = static_cast<size_t>(w) * h * c;
+    const bool wide = options.bitDepth == 16 ||
+                      (options.bitDepth != 8 && !std::is_same_v<T, unsigned char>);
+
+    if (wide) {
+        std::vector<std::uint16_t> samples(count);
+        for (size_t i = 0; i < count; ++i) {
+            if constexpr (std::is_floating_point_v<T>) {
+                samples[i] = static_cast<std::uint16_t>(std::lround(std::clamp<double>(plane[i], 0.0, 1.0) * 65535.0));
+            } else if constexpr (std::is_same_v<T, unsigned char>) {
+                samples[i] = static_cast<std::uint16_t>(plane[i] * 257);
+            } else {
+                samples[i] = static_cast<std::uint16_t>(plane[i]);
+            }
+        }
+        Image::WriteImage16(samples.data(), w, h, c, path.c_str(), options);
+        return;
+    }
+
+    if constexpr (std::is_same_v<T, unsigned char>) {
+        Image::WriteImage(plane, w, h, c, path.c_str(), options);
+    } else {
+        std::vector<unsigned char> samples(count);
+        for (size_t i = 0; i < count; ++i) {
+            if constexpr (std::is_floating_point_v<T>) {
+                samples[i] = static_cast<unsigned char>(std::lround(std::clamp<double>(plane[i], 0.0, 1.0) * 255.0));
+            } else {
+                samples[i] = static_cast<unsigned char>((plane[i] + 128) / 257);
+            }
+        }
+        Image::WriteImage(samples.data(), w, h, c, path.c_str(), options);
+    }
+}
+
+// The 3D pipeline is instantiated for these voxel types only
+template class BasicVolume<unsigned char>;
+template class BasicVolume<std::uint16_t>;
+template class BasicVolume<float>;
+
+template void writeVoxelPlane<unsigned char>(const unsigned char*, int, int, int, const std::string&, const ImageWriteOptions&);
+template void writeVoxelPlane<std::uint16_t>(const std::uint16_t*, int, int, int, const std::string&, const ImageWriteOptions&);
+template void writeVoxelPlane<float>(const float*, int, int, int, const std::string&, const ImageWriteOptions&);
+
+template void transposeBlock<unsigned char>(const unsigned char*, size_t, unsigned char*, size_t, int, int, int);
+template void transposeBlock<std::uint16_t>(const std::uint16_t*, size_t, std::uint16_t*, size_t, int, int, int);
+template void transposeBlock<float>(const float*, size_t, float*, size_t, int, int, int);
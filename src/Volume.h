@@ -14,35 +14,125 @@
 #ifndef VOLUME_H
 #define VOLUME_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
+#include "Image.h"
 
-class Volume {
+// Voxel storage types. Auto means "whatever the slices hold": 16-bit PNG
+// slices load as UInt16, everything else as UInt8.
+enum class VoxelType {
+    Auto,
+    UInt8,
+    UInt16,
+    Float32
+};
+
+// Axis orders for BasicVolume::permuted(): the letters name the source axes that
+// become the new x, y and z, so YZX turns every YZ plane into a contiguous xy slice.
+enum class AxisOrder {
+    XYZ,
+    XZY,
+    YXZ,
+    YZX,
+    ZXY,
+    ZYX
+};
+
+template <typename T>
+class BasicVolume {
 public:
+    using value_type = T;
+
     int width;
     int height;
     int depth;
-    int channels;  // e.g. 1 for grayscale, 3 for RGB, etc
+    int channels;  // e.g. 1 for grayscale, 3 for RGB, etc (0 before loading = as stored)
 
-    // Raw storage: a single std::vector to hold all voxel data
+    // Raw storage: a single std::vector to hold all voxel data, channels
+    // interleaved: data[((z * height + y) * width + x) * channels + c]
     // Size will be width * height * depth * channels
-    std::vector<unsigned char> data;
+    // uint16 keeps the full range of 16-bit slices; float holds intensities
+    // normalised to [0, 1] (8-bit sources / 255, 16-bit sources / 65535)
+    std::vector<T> data;
 
     int firstSlice = 1;
     int lastSlice  = -1;        // -1 can indicate "not set => load all"
     std::string extension = "png"; // default extension for slices
 
     // Constructors
-    Volume();
-    Volume(int w, int h, int d, int c = 1);
+    BasicVolume();
+    BasicVolume(int w, int h, int d, int c = 1);
 
     // (A) Loading volume data (from a folder of 2D slices, for example)
-    //     This is just a stub; the actual logic can be done by the person in charge of I/O
-    bool loadVolumeFromSlices(const std::string& folderPath);
+    //     8-bit volumes load through stbi_load, the others through stbi_load_16
+    //     when the slices are 16-bit, so no precision is lost on the way in.
+    //     Keeps `channels` channels per voxel (0 = as many as the slices store)
+    //     With `error` set nothing is printed; a failure's reason is stored there
+    bool loadVolumeFromSlices(const std::string& folderPath, std::string* error = nullptr);
 
     // Basic accessors/mutators for voxel data
-    unsigned char getVoxel(int x, int y, int z, int c = 0) const;
-    void setVoxel(int x, int y, int z, unsigned char value, int c = 0);
+    T getVoxel(int x, int y, int z, int c = 0) const;
+    void setVoxel(int x, int y, int z, T value, int c = 0);
+
+    // Copy with the axes reordered, e.g. AxisOrder::YZX gives a volume whose xy
+    // slices are this volume's YZ planes. Built tile by tile with transposeBlock().
+    BasicVolume permuted(AxisOrder order) const;
 };
 
+using Volume   = BasicVolume<unsigned char>;  // 8-bit voxels (default)
+using Volume16 = BasicVolume<std::uint16_t>;  // 16-bit voxels
+using VolumeF  = BasicVolume<float>;          // normalised float voxels
+
+/**
+ * @brief Converts a name ("auto", "uint8", "uint16", "float") to a VoxelType.
+ * @param name The type name (case-insensitive; "u8", "u16", "f32" also accepted).
+ * @return The matching type; unknown names warn and fall back to Auto.
+ */
+VoxelType GetVoxelType(const std::string& name);
+
+/**
+ * @brief Storage type that matches the first slice selected by folderPath.
+ * @return UInt16 for 16-bit slices, otherwise UInt8 (also if nothing is found).
+ */
+VoxelType probeVoxelType(const std::string& folderPath, int firstSlice = 1, int lastSlice = -1);
+
+/**
+ * @brief Fingerprint of the slice files a load of folderPath would read.
+ *
+ * Changes when a selected slice is added, removed, resized or modified, so it can
+ * tell whether data derived from the slices (e.g. a cached BrickGrid) is stale.
+ */
+std::uint64_t sliceStamp(const std::string& folderPath, int firstSlice = 1, int lastSlice = -1);
+
+/**
+ * @brief Converts an axis order name ("xyz", "yzx", ...) to an AxisOrder.
+ * @param name Three letters naming the source axes for the new x, y and z.
+ * @return The matching order; unknown names warn and fall back to XYZ.
+ */
+AxisOrder GetAxisOrder(const std::string& name);
+
+/**
+ * @brief Cache-blocked 2D transpose of interleaved voxels.
+ *
+ * Copies dst[col * dstStride + row * channels + k] = src[row * srcStride + col * channels + k]
+ * for every row < rows, col < cols and channel k, working in 16 x 16 tiles so both sides
+ * stay in cache. Single-channel 8- and 16-bit tiles are transposed in registers with
+ * SSE2 unpack shuffles. Strides are in elements of T.
+ */
+template <typename T>
+void transposeBlock(const T* src, size_t srcStride, T* dst, size_t dstStride, int rows, int cols, int channels = 1);
+
+/**
+ * @brief Writes a plane of voxels (w * h * c values) as an image file.
+ *
+ * The output depth follows options.bitDepth; with 0 it follows the voxel type, so
+ * 8-bit voxels give an 8-bit file and uint16/float voxels a 16-bit PNG.
+ *
+ * @throws std::runtime_error If writing fails.
+ */
+template <typename T>
+void writeVoxelPlane(const T* plane, int w, int h, int c, const std::string& path,
+                     const ImageWriteOptions& options);
+
 #endif // VOLUME_H
@@ -0,0 +1,178 @@
+/*
+ * @file VolumeCache.cpp
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#include "VolumeCache.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[8] = { 'A', 'P', 'V', 'O', 'L', 'U', 'M', '1' };
+
+// Fixed-size entry header; the voxels start right after it, 64-byte aligned
+struct Header {
+    char magic[8];
+    std::uint64_t key;
+    std::int32_t width, height, depth, channels;
+    std::int32_t firstSlice, lastSlice;
+    std::int32_t voxelBytes, isFloat;
+    char reserved[16];
+};
+static_assert(sizeof(Header) == 64, "VolumeCache header must stay 64 bytes");
+
+template <typename T>
+const char *typeTag() {
+    if constexpr (std::is_same_v<T, unsigned char>) {
+        return "u8";
+    } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+        return "u16";
+    } else {
+        return "f32";
+    }
+}
+
+} // namespace
+
+/**
+ * @brief FNV-1a over the slice stamp, the load settings and the recipe.
+ */
+template <typename T>
+std::uint64_t VolumeCache::key(const std::string &folderPath, const BasicVolume<T> &vol, const std::string &recipe)
+{
+    std::uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](const void *bytes, size_t n) {
+        const unsigned char *p = static_cast<const unsigned char *>(bytes);
+        for (size_t i = 0; i < n; ++i) {
+            hash = (hash ^ p[i]) * 1099511628211ull;
+        }
+    };
+    const std::uint64_t stamp = sliceStamp(folderPath, vol.firstSlice, vol.lastSlice);
+    const std::int32_t settings[3] = { vol.firstSlice, vol.lastSlice, vol.channels };
+    mix(&stamp, sizeof(stamp));
+    mix(settings, sizeof(settings));
+    mix(typeTag<T>(), std::strlen(typeTag<T>()) + 1);
+    mix(vol.extension.c_str(), vol.extension.size() + 1);
+    mix(recipe.data(), recipe.size());
+    return hash;
+}
+
+std::string VolumeCache::path(const std::string &cacheDir, std::uint64_t key)
+{
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    std::string dir = cacheDir.empty() ? std::string(".") : cacheDir;
+    if (dir.back() != '/' && dir.back() != '\\') {
+        dir += "/";
+    }
+    return dir + name + ".apvol";
+}
+
+/**
+ * @brief Checks the header against the key and type and the file size against the
+ *        dimensions, then reads the voxels in one go.
+ */
+template <typename T>
+bool VolumeCache::load(const std::string &path, std::uint64_t key, BasicVolume<T> &vol)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return false;
+    }
+    const std::streamoff fileSize = in.tellg();
+    in.seekg(0);
+    Header header;
+    if (fileSize < static_cast<std::streamoff>(sizeof(Header)) ||
+        !in.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+        return false;
+    }
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.key != key ||
+        header.voxelBytes != static_cast<std::int32_t>(sizeof(T)) ||
+        header.isFloat != (std::is_floating_point_v<T> ? 1 : 0) || header.width <= 0 || header.height <= 0 ||
+        header.depth <= 0 || header.channels <= 0) {
+        return false;
+    }
+    const size_t count = static_cast<size_t>(header.width) * header.height * header.depth * header.channels;
+    if (fileSize != static_cast<std::streamoff>(sizeof(Header) + count * sizeof(T))) {
+        return false;
+    }
+
+    std::vector<T> data(count);
+    if (!in.read(reinterpret_cast<char *>(data.data()), count * sizeof(T))) {
+        return false;
+    }
+    vol.width = header.width;
+    vol.height = header.height;
+    vol.depth = header.depth;
+    vol.channels = header.channels;
+    vol.firstSlice = header.firstSlice;
+    vol.lastSlice = header.lastSlice;
+    vol.data.swap(data);
+    return true;
+}
+
+template <typename T>
+void VolumeCache::save(const std::string &path, std::uint64_t key, const BasicVolume<T> &vol)
+{
+    const size_t slash = path.find_last_of("/\\");
+    if (slash != std::string::npos && slash > 0) {
+        mkdir(path.substr(0, slash).c_str(), 0755);  // fails harmlessly if it exists
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.key = key;
+    header.width = vol.width;
+    header.height = vol.height;
+    header.depth = vol.depth;
+    header.channels = vol.channels;
+    header.firstSlice = vol.firstSlice;
+    header.lastSlice = vol.lastSlice;
+    header.voxelBytes = static_cast<std::int32_t>(sizeof(T));
+    header.isFloat = std::is_floating_point_v<T> ? 1 : 0;
+
+    const std::string temp = path + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot write volume cache entry " + temp);
+        }
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(vol.data.data()), vol.data.size() * sizeof(T));
+        if (!out) {
+            out.close();
+            std::remove(temp.c_str());
+            throw std::runtime_error("Failed writing volume cache entry " + temp);
+        }
+    }
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        throw std::runtime_error("Cannot move volume cache entry into place at " + path);
+    }
+}
+
+#define VOLUMECACHE_INSTANTIATE(T)                                                                          \
+    template std::uint64_t VolumeCache::key<T>(const std::string &, const BasicVolume<T> &, const std::string &); \
+    template bool VolumeCache::load<T>(const std::string &, std::uint64_t, BasicVolume<T> &);                 \
+    template void VolumeCache::save<T>(const std::string &, std::uint64_t, const BasicVolume<T> &);
+
+VOLUMECACHE_INSTANTIATE(unsigned char)
+VOLUMECACHE_INSTANTIATE(std::uint16_t)
+VOLUMECACHE_INSTANTIATE(float)
+
+#undef VOLUMECACHE_INSTANTIATE
@@ -0,0 +1,69 @@
+/*
+ * @file VolumeCache.h
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#ifndef VOLUME_CACHE_H
+#define VOLUME_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include "Volume.h"
+
+/**
+ * @class VolumeCache
+ * @brief Content-addressed on-disk cache of preprocessed volumes.
+ *
+ * A cached volume is stored under a key that hashes everything it was made from: the
+ * slice files (sliceStamp()), the load settings (voxel type, slice range, channels,
+ * extension) and a recipe string naming the operations applied since loading. A run
+ * with the same slices and preprocessing can then read the voxels back instead of
+ * decoding the slices and filtering again; changing either gives a new key, so stale
+ * entries are never read and the cache folder can be emptied at any time.
+ *
+ * Each entry is a 64-byte header followed by the raw interleaved voxels, so the file
+ * can be memory-mapped with the data aligned. Instantiated for Volume, Volume16 and
+ * VolumeF.
+ */
+class VolumeCache {
+public:
+    /**
+     * @brief Key of the volume loaded from folderPath with vol's settings, then processed
+     *        as described by recipe.
+     *
+     * vol only supplies the load settings (firstSlice, lastSlice, channels, extension),
+     * so it can be called before loading.
+     */
+    template <typename T>
+    static std::uint64_t key(const std::string &folderPath, const BasicVolume<T> &vol, const std::string &recipe);
+
+    // Entry file for a key: <cacheDir>/<16 hex digits>.apvol
+    static std::string path(const std::string &cacheDir, std::uint64_t key);
+
+    /**
+     * @brief Reads the entry at path into vol if it holds key with voxels of type T.
+     * @return False if there is no such entry (missing, foreign, truncated or another key).
+     */
+    template <typename T>
+    static bool load(const std::string &path, std::uint64_t key, BasicVolume<T> &vol);
+
+    /**
+     * @brief Stores vol under key at path, creating the cache folder if needed.
+     *
+     * The entry is written to a temporary file and renamed into place, so concurrent
+     * runs never see a partial entry.
+     * @throws std::runtime_error If the entry cannot be written.
+     */
+    template <typename T>
+    static void save(const std::string &path, std::uint64_t key, const BasicVolume<T> &vol);
+};
+
+#endif // VOLUME_CACHE_H
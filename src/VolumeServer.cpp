@@ -0,0 +1,454 @@
+/*
+ * @file VolumeServer.cpp
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#include "VolumeServer.h"
+#include "Filters3D.h"
+#include "Projections3D.h"
+#include "RayCaster.h"
+#include "Slicing3D.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;  // a client that hung up must not kill the server
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+// How often blocked accept/recv calls wake up to notice SHUTDOWN
+constexpr int kPollMillis = 100;
+
+std::vector<std::string> splitWords(const std::string& line) {
+    std::istringstream in(line);
+    std::vector<std::string> words;
+    std::string w;
+    while (in >> w) {
+        words.push_back(w);
+    }
+    return words;
+}
+
+double toNumber(const std::string& word, const char* what) {
+    try {
+        size_t used = 0;
+        const double v = std::stod(word, &used);
+        if (used == word.size()) {
+            return v;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument(std::string("expected a number for ") + what + ", got '" + word + "'");
+}
+
+int toInt(const std::string& word, const char* what) {
+    return static_cast<int>(toNumber(word, what));
+}
+
+void needWords(const std::vector<std::string>& words, size_t count, const char* usage) {
+    if (words.size() < count) {
+        throw std::invalid_argument(std::string("usage: ") + usage);
+    }
+}
+
+template <typename T>
+const char* typeName() {
+    if constexpr (std::is_same_v<T, unsigned char>) {
+        return "uint8";
+    } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+        return "uint16";
+    } else {
+        return "float";
+    }
+}
+
+bool sendAll(int fd, const std::string& text) {
+    size_t sent = 0;
+    while (sent < text.size()) {
+        const ssize_t n = ::send(fd, text.data() + sent, text.size() - sent, kSendFlags);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+VolumeServer::VolumeServer(int workers) : workerCount(std::max(1, workers)) {}
+
+std::shared_ptr<VolumeServer::Resident> VolumeServer::find(const std::string& name) {
+    std::lock_guard<std::mutex> guard(registryMutex);
+    auto it = volumes.find(name);
+    if (it == volumes.end()) {
+        throw std::invalid_argument("no volume named '" + name + "'");
+    }
+    return it->second;
+}
+
+/**
+ * @brief Reply text for INFO (or one LIST entry when compact); takes the shared lock.
+ */
+std::string VolumeServer::describe(const std::string& name, Resident& resident, bool compact) {
+    std::shared_lock<std::shared_mutex> reading(resident.lock);
+    return std::visit([&](const auto& vol) {
+        using T = typename std::decay_t<decltype(vol)>::value_type;
+        std::ostringstream out;
+        if (compact) {
+            out << name << ':' << vol.width << 'x' << vol.height << 'x' << vol.depth << 'x' << vol.channels << ':'
+                << typeName<T>();
+        } else {
+            out << vol.width << ' ' << vol.height << ' ' << vol.depth << ' ' << vol.channels << ' ' << typeName<T>();
+        }
+        return out.str();
+    }, resident.volume);
+}
+
+/**
+ * @brief LOAD: decodes the slices with no lock held, then publishes the volume.
+ */
+std::string VolumeServer::load(const std::vector<std::string>& words) {
+    needWords(words, 3, "LOAD <name> <folder> [auto|uint8|uint16|float] [<first> [<last>]]");
+    const std::string& name = words[1];
+    const std::string& folder = words[2];
+    size_t next = 3;
+    VoxelType type = VoxelType::Auto;
+    if (next < words.size() && !std::isdigit(static_cast<unsigned char>(words[next][0]))) {
+        const std::string& t = words[next++];
+        if (t != "auto" && t != "uint8" && t != "uint16" && t != "float") {
+            throw std::invalid_argument("unknown voxel type '" + t + "'");
+        }
+        type = GetVoxelType(t);
+    }
+    const int first = next < words.size() ? std::max(1, toInt(words[next++], "first slice")) : 1;
+    const int last = next < words.size() ? toInt(words[next++], "last slice") : -1;
+    if (type == VoxelType::Auto) {
+        type = probeVoxelType(folder, first, last);
+    }
+
+    auto resident = std::make_shared<Resident>();
+    auto fill = [&](auto vol) {
+        vol.firstSlice = first;
+        vol.lastSlice = last;
+        if (!vol.loadVolumeFromSlices(folder)) {
+            throw std::runtime_error("failed to load volume from " + folder);
+        }
+        resident->volume = std::move(vol);
+    };
+    switch (type) {
+        case VoxelType::UInt16:  fill(Volume16()); break;
+        case VoxelType::Float32: fill(VolumeF()); break;
+        default:                 fill(Volume()); break;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(registryMutex);
+        volumes[name] = resident;
+    }
+    return "OK " + name + " " + describe(name, *resident, false);
+}
+
+/**
+ * @brief Parses one request and runs it; any failure becomes an ERR reply.
+ */
+std::string VolumeServer::handle(const std::string& request) {
+    const std::vector<std::string> words = splitWords(request);
+    if (words.empty()) {
+        return "ERR empty request";
+    }
+    std::string cmd = words[0];
+    std::transform(cmd.begin(), cmd.end(), cmd.begin(), [](unsigned char ch) { return static_cast<char>(std::toupper(ch)); });
+
+    try {
+        if (cmd == "PING") {
+            return "OK pong";
+        }
+        if (cmd == "SHUTDOWN") {
+            stop = true;
+            return "OK bye";
+        }
+        if (cmd == "LOAD") {
+            return load(words);
+        }
+        if (cmd == "UNLOAD") {
+            needWords(words, 2, "UNLOAD <name>");
+            std::lock_guard<std::mutex> guard(registryMutex);
+            if (volumes.erase(words[1]) == 0) {
+                throw std::invalid_argument("no volume named '" + words[1] + "'");
+            }
+            return "OK " + words[1];
+        }
+        if (cmd == "LIST") {
+            std::vector<std::pair<std::string, std::shared_ptr<Resident>>> snapshot;
+            {
+                std::lock_guard<std::mutex> guard(registryMutex);
+                snapshot.assign(volumes.begin(), volumes.end());
+            }
+            std::string reply = "OK";
+            for (auto& entry : snapshot) {
+                reply += " " + describe(entry.first, *entry.second, true);
+            }
+            return reply;
+        }
+        if (cmd == "INFO") {
+            needWords(words, 2, "INFO <name>");
+            return "OK " + describe(words[1], *find(words[1]), false);
+        }
+
+        if (cmd == "BLUR") {
+            needWords(words, 4, "BLUR <name> <Gaussian|Median> <size> [<stdev>]");
+            if (words[2] != "Gaussian" && words[2] != "Median") {
+                throw std::invalid_argument("unknown 3D blur type '" + words[2] + "'");
+            }
+            const float size = static_cast<float>(toNumber(words[3], "kernel size"));
+            const float stdev = words.size() > 4 ? static_cast<float>(toNumber(words[4], "stdev")) : 2.f;
+            std::shared_ptr<Resident> resident = find(words[1]);
+            std::unique_lock<std::shared_mutex> writing(resident->lock);
+            std::visit([&](auto& vol) { Filters3D().apply3DBlur(vol, words[2], size, stdev); }, resident->volume);
+            std::lock_guard<std::mutex> guard(resident->gridMutex);
+            resident->grid = BrickGrid();
+            return "OK " + words[1];
+        }
+
+        // The remaining requests only read the voxels
+        if (cmd != "SLICE" && cmd != "PROJECT" && cmd != "RENDER") {
+            throw std::invalid_argument("unknown request '" + words[0] + "'");
+        }
+        needWords(words, 2, "SLICE|PROJECT|RENDER <name> ...");
+        std::shared_ptr<Resident> resident = find(words[1]);
+        std::shared_lock<std::shared_mutex> reading(resident->lock);
+
+        return std::visit([&](const auto& vol) -> std::string {
+            using T = typename std::decay_t<decltype(vol)>::value_type;
+            auto bricks = [&]() {
+                std::lock_guard<std::mutex> guard(resident->gridMutex);
+                if (!resident->grid.covers(vol)) {
+                    resident->grid = BrickGrid(vol);
+                }
+                return resident->grid;
+            };
+
+            if (cmd == "SLICE") {
+                needWords(words, 5, "SLICE <name> <XY|XZ|YZ> <index> <out>");
+                std::string plane = words[2];
+                std::transform(plane.begin(), plane.end(), plane.begin(),
+                               [](unsigned char ch) { return static_cast<char>(std::toupper(ch)); });
+                const int index = toInt(words[3], "slice index");
+                const int limit = plane == "XY" ? vol.depth : plane == "XZ" ? vol.height : plane == "YZ" ? vol.width : 0;
+                if (limit == 0) {
+                    throw std::invalid_argument("unknown plane '" + words[2] + "'");
+                }
+                if (index < 0 || index >= limit) {
+                    throw std::invalid_argument("slice index " + words[3] + " is outside 0-" + std::to_string(limit - 1));
+                }
+                // Computed in memory and written with the throwing writer, so a failed
+                // write is answered with ERR (slice3D only logs it)
+                std::vector<T> pixels;
+                int w = 0;
+                int h = 0;
+                Slicing3D::extractSlice(vol, plane, index, pixels, w, h);
+                writeVoxelPlane(pixels.data(), w, h, vol.channels, words[4], writeOptions);
+                return "OK " + words[4];
+            }
+
+            if (cmd == "PROJECT") {
+                needWords(words, 4, "PROJECT <name> <MIP|MinIP|AIP|AIPMedian> <out> [x|y|z] [<first> <last>]");
+                const std::string& type = words[2];
+                if (type != "MIP" && type != "MinIP" && type != "AIP" && type != "AIPMedian") {
+                    throw std::invalid_argument("unknown projection '" + type + "'");
+                }
+                size_t next = 4;
+                ProjectionAxis axis = ProjectionAxis::Z;
+                if (next < words.size() && words[next].size() == 1 && std::isalpha(static_cast<unsigned char>(words[next][0]))) {
+                    const std::string& a = words[next++];
+                    if (a != "x" && a != "y" && a != "z" && a != "X" && a != "Y" && a != "Z") {
+                        throw std::invalid_argument("unknown axis '" + a + "'");
+                    }
+                    axis = Projections3D::GetProjectionAxis(a);
+                }
+                const int first = next < words.size() ? toInt(words[next++], "first slice") : -1;
+                const int last = next < words.size() ? toInt(words[next++], "last slice") : -1;
+                BrickGrid grid;
+                if (axis == ProjectionAxis::Z && (type == "MIP" || type == "MinIP")) {
+                    grid = bricks();
+                }
+                std::vector<T> pixels;
+                int w = 0;
+                int h = 0;
+                Projections3D::project(vol, type, first, last, pixels, w, h, axis, grid.empty() ? nullptr : &grid);
+                writeVoxelPlane(pixels.data(), w, h, vol.channels, words[3], writeOptions);
+                return "OK " + words[3];
+            }
+
+            needWords(words, 6, "RENDER <name> <MIP|MinIP|AIP|Composite> <yaw> <pitch> <out> [<width> <height> [<step>]]");
+            const std::string& mode = words[2];
+            if (mode != "MIP" && mode != "MinIP" && mode != "AIP" && mode != "Composite") {
+                throw std::invalid_argument("unknown render mode '" + mode + "'");
+            }
+            if (vol.channels != 1) {
+                throw std::invalid_argument("render needs a single-channel volume");
+            }
+            Camera cam;
+            cam.yaw = toNumber(words[3], "yaw");
+            cam.pitch = toNumber(words[4], "pitch");
+            if (words.size() > 7) {
+                cam.width = toInt(words[6], "width");
+                cam.height = toInt(words[7], "height");
+            }
+            if (words.size() > 8) {
+                cam.step = toNumber(words[8], "step");
+            }
+            RayCaster<T> caster(vol, bricks());
+            caster.renderToFile(cam, RayCaster<T>::GetRenderMode(mode), words[5], writeOptions);
+            return "OK " + words[5];
+        }, resident->volume);
+    } catch (const std::exception& e) {
+        return std::string("ERR ") + e.what();
+    }
+}
+
+/**
+ * @brief Reads request lines from one client and answers each in turn.
+ */
+void VolumeServer::serveConnection(int fd) {
+    std::string pending;
+    char buffer[4096];
+    while (!stop) {
+        pollfd p{ fd, POLLIN, 0 };
+        const int ready = ::poll(&p, 1, kPollMillis);
+        if (ready < 0) {
+            break;
+        }
+        if (ready == 0) {
+            continue;
+        }
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            break;
+        }
+        pending.append(buffer, static_cast<size_t>(n));
+        size_t newline;
+        while ((newline = pending.find('\n')) != std::string::npos) {
+            std::string line = pending.substr(0, newline);
+            pending.erase(0, newline + 1);
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.find_first_not_of(" \t") == std::string::npos) {
+                continue;
+            }
+            if (!sendAll(fd, handle(line) + "\n")) {
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Binds the socket, starts the worker pool and hands accepted connections to it.
+ */
+void VolumeServer::serve(const std::string& socketPath) {
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("socket path must be 1-" + std::to_string(sizeof(addr.sun_path) - 1) + " characters");
+    }
+    std::memcpy(addr.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        throw std::runtime_error("cannot create socket: " + std::string(std::strerror(errno)));
+    }
+    // A socket left behind by an earlier server is replaced; any other file is left alone
+    struct stat existing;
+    if (::lstat(socketPath.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            ::close(listener);
+            throw std::runtime_error("cannot listen on " + socketPath + ": the path exists and is not a socket");
+        }
+        ::unlink(socketPath.c_str());
+    }
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(listener, 64) != 0) {
+        const std::string reason = std::strerror(errno);
+        ::close(listener);
+        throw std::runtime_error("cannot listen on " + socketPath + ": " + reason);
+    }
+    std::cout << "[Server] listening on " << socketPath << " with " << workerCount << " workers\n";
+
+    std::mutex queueMutex;
+    std::condition_variable queued;
+    std::deque<int> clients;
+    std::vector<std::thread> workers;
+    for (int i = 0; i < workerCount; ++i) {
+        workers.emplace_back([&]() {
+            for (;;) {
+                int fd;
+                {
+                    std::unique_lock<std::mutex> guard(queueMutex);
+                    queued.wait(guard, [&]() { return stop || !clients.empty(); });
+                    if (stop) {
+                        return;
+                    }
+                    fd = clients.front();
+                    clients.pop_front();
+                }
+                serveConnection(fd);
+                ::close(fd);
+            }
+        });
+    }
+
+    while (!stop) {
+        pollfd p{ listener, POLLIN, 0 };
+        if (::poll(&p, 1, kPollMillis) <= 0) {
+            continue;
+        }
+        const int fd = ::accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        std::lock_guard<std::mutex> guard(queueMutex);
+        clients.push_back(fd);
+        queued.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(queueMutex);
+        queued.notify_all();
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+    for (int fd : clients) {
+        ::close(fd);
+    }
+    ::close(listener);
+    ::unlink(socketPath.c_str());
+    std::cout << "[Server] stopped\n";
+}
@@ -0,0 +1,106 @@
+/*
+ * @file VolumeServer.h
+ *
+ * Group Members:
+ * - Jiaqi    (GitHub: esemsc-jc1424)
+ * - Daicong  (GitHub: esemsc-c730ef50)
+ * - Ida      (GitHub: esemsc-ifc24)
+ * - Zhuyi    (GitHub: esemsc-zf1124)
+ * - Dany     (GitHub: esemsc-dh324)
+ * - Ethan    (GitHub: edsml-elm224)
+ * - Keyun    (GitHub: esemsc-km824)
+ */
+
+#ifndef VOLUME_SERVER_H
+#define VOLUME_SERVER_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <variant>
+#include <vector>
+#include "BrickGrid.h"
+#include "Image.h"
+#include "Volume.h"
+
+/**
+ * @class VolumeServer
+ * @brief Long-lived process that keeps volumes in memory and answers slice, projection,
+ *        render and filter requests against them.
+ *
+ * Requests are single lines of whitespace-separated words; every request gets exactly
+ * one reply line, "OK ..." or "ERR <message>". Output images are written to the path
+ * given in the request, as the command line tool does.
+ *
+ *   PING                                              -> OK pong
+ *   LOAD <name> <folder> [auto|uint8|uint16|float] [<first> [<last>]]
+ *                                                     -> OK <name> <w> <h> <d> <channels> <type>
+ *   UNLOAD <name>                                     -> OK <name>
+ *   LIST                                              -> OK <name>:<w>x<h>x<d>x<c>:<type> ...
+ *   INFO <name>                                       -> OK <w> <h> <d> <channels> <type>
+ *   SLICE <name> <XY|XZ|YZ> <index> <out>             -> OK <out>
+ *   PROJECT <name> <MIP|MinIP|AIP|AIPMedian> <out> [x|y|z] [<first> <last>]
+ *                                                     -> OK <out>  (slab along the axis)
+ *   RENDER <name> <MIP|MinIP|AIP|Composite> <yaw> <pitch> <out> [<width> <height> [<step>]]
+ *                                                     -> OK <out>
+ *   BLUR <name> <Gaussian|Median> <size> [<stdev>]    -> OK <name>
+ *   SHUTDOWN                                          -> OK bye
+ *
+ * Each resident volume has a reader-writer lock: slices, projections and renders share
+ * it, so they run concurrently, while BLUR (which changes the voxels) takes it
+ * exclusively. LOAD decodes without holding any lock and then swaps the new volume in;
+ * requests already running on the old one finish on it. The BrickGrid used for
+ * rendering and z MIP/MinIP is built on first use and kept until the voxels change.
+ */
+class VolumeServer {
+public:
+    /**
+     * @param workers Connections served at the same time (at least 1).
+     */
+    explicit VolumeServer(int workers = 4);
+
+    /**
+     * @brief Answers one request line (without the newline). Safe to call from any thread.
+     */
+    std::string handle(const std::string& request);
+
+    /**
+     * @brief Listens on a Unix domain socket and serves clients until SHUTDOWN.
+     *
+     * A pool of `workers` threads each serves one connection at a time, reading
+     * requests and replying in order; further clients wait in the accept queue. A
+     * stale socket file at socketPath is replaced, and the file is removed on exit.
+     * @throws std::runtime_error If the socket cannot be created or bound, or if
+     *         socketPath exists and is not a socket (it is not removed).
+     */
+    void serve(const std::string& socketPath);
+
+    bool stopping() const { return stop.load(); }
+
+private:
+    using AnyVolume = std::variant<Volume, Volume16, VolumeF>;
+
+    // A volume kept in memory, with the lock that guards its voxels
+    struct Resident {
+        std::shared_mutex lock;
+        AnyVolume volume;
+        std::mutex gridMutex;  // guards grid, which readers build lazily
+        BrickGrid grid;
+    };
+
+    std::shared_ptr<Resident> find(const std::string& name);
+    std::string load(const std::vector<std::string>& words);
+    std::string describe(const std::string& name, Resident& resident, bool compact);
+    void serveConnection(int fd);
+
+    int workerCount;
+    std::atomic<bool> stop{ false };
+    std::mutex registryMutex;
+    std::map<std::string, std::shared_ptr<Resident>> volumes;
+    ImageWriteOptions writeOptions;
+};
+
+#endif // VOLUME_SERVER_H
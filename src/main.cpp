@@ -5,6 +5,11 @@
  * Usage:
  *   For 2D image: ./Program -i <input_image> [filter options] <output_image>
  *   For 3D volume: ./Program -d <input_volume> [volume options] <output_image>
+ *   "-" as <input_image> reads the image from stdin; "-" as <output_image> writes it to
+ *   stdout (progress messages then go to stderr)
+ *   Server mode:   ./Program --serve <socket> [<workers>]
+ *                  (keeps volumes in memory and answers one-line requests on a Unix
+ *                   domain socket: LOAD, SLICE, PROJECT, RENDER, BLUR, ...; see VolumeServer.h)
  *
  * Filter options for 2D image processing:
  *   Greyscale:      --greyscale or -g
@@ -13,9 +18,45 @@
  *   Blur:           --blur <type> <size> [<stdev>] or -r <type> <size> [<stdev>]
  *                   (e.g., Gaussian 5 2.0, Box 7, Median 3)
  *   Edge Detection: --edge <type> or -e <type> (e.g., Sobel, Prewitt, Scharr, RobertsCross)
- *   Sharpening:     --sharpen or -p
+ *                   --edge Canny [<low> <high>] (e.g., Canny 20 50)
+ *   Sharpening:     --sharpen or -p [<strength>]
+ *   Unsharp Mask:   --unsharp or -u <amount> [<radius> <threshold>]
  *   SaltPepper:     --saltpepper <amount> or -n <amount>
+ *                   (add --seed <n> anywhere for reproducible noise)
  *   Threshold:      --threshold <value> or -t <value> (e.g., 128 , 64 )
+ *   Resize:         --resize <width> <height> [<kernel>] or --scale <factor> [<kernel>]
+ *                   (kernel: Box, Bilinear, Bicubic (default), Lanczos3; also valid for volumes)
+ *   Pyramid Level:  --level <n> (continue on level n of the Gaussian pyramid, 0 = full size)
+ *
+ * Output options (either mode): the output extension selects PNG, JPEG, BMP or TGA.
+ *   --format <png|jpg|bmp|tga> (overrides the extension; "-" as the output defaults to png)
+ *   --quality <1-100> (JPEG), --png-level <0-9>,
+ *   --png-filter <None|Sub|Up|Average|Paeth|Adaptive>,
+ *   --bit-depth <8|16> (default: 8-bit volumes write 8-bit, 16-bit/float volumes 16-bit PNG)
+ *
+ * Profiling (either mode): --trace [<trace.json>]
+ *   (times the load, each operation and the writes, with bytes, busy threads and peak RSS;
+ *    prints a summary, or writes Chrome trace-event JSON when a .json file is given)
+ *
+ * Volume options: --voxel-type <auto|uint8|uint16|float> (auto keeps 16-bit slices 16-bit)
+ *                 --channels <1-4|auto> (auto keeps the channels stored in the slices)
+ *                 --brick-cache (MIP/MinIP and --render skip background bricks using a
+ *                                min/max/mean summary cached next to the slices)
+ *                 --volume-cache <dir> (reuse the volume after the leading blur/resize/scale
+ *                                steps from <dir>, keyed on the slices and those steps)
+ *   Projection:     -p <type> [x|y|z] (project along x or y instead of z)
+ *   Sliding slabs:  --slab <MIP|MinIP|AIP> <thickness> [<step>] [x|y|z]
+ *                   (one slab projection per window, written as <output>_<first slice>.<ext>)
+ *   Batch slices:   --slices <XY|XZ|YZ> [<first> <last> [<step>]]
+ *                   (writes <output>_<index>.<ext> for every selected slice)
+ *   Oblique slice:  --oblique <x> <y> <z> <nx> <ny> <nz> [<width> <height> [<spacing>]]
+ *                   --oblique-points <x1> <y1> <z1> <x2> <y2> <z2> <x3> <y3> <z3> [<width> <height> [<spacing>]]
+ *                   (trilinear MPR through a point + normal or three points, in voxel units)
+ *   Curved (CPR):   --cpr <points.txt> [<width> [<spacing>]] [Spline|Polyline]
+ *                   (straightened reformation along the centreline in points.txt, "x y z" per line)
+ *   Ray casting:    --render <MIP|MinIP|AIP|Composite> [<yaw> [<pitch> [<width> <height> [<step>]]]]
+ *                   --transfer <tf.txt> ("value r g b a" per line, for Composite)
+ *                   --frames <n> (turntable: n views 360/n degrees apart, written as <output>_<frame>.<ext>)
  *
  * Group Members:
  * - Jiaqi    (GitHub: esemsc-jc1424)
@@ -30,7 +71,12 @@
  #include "stb_image.h"
  #include "stb_image_write.h"
  
+ #include <algorithm>
+ #include <cmath>
+ #include <cstdint>
  #include <iostream>
+ #include <memory>
+ #include <sstream>
  #include <string>
  #include <vector>
  #include <sys/stat.h>
@@ -42,6 +88,13 @@
  #include "Filters2D.h"
  #include "Filters3D.h"
  #include "Image.h"
+ #include "Resampler.h"
+ #include "Pyramid.h"
+ #include "RayCaster.h"
+ #include "BrickGrid.h"
+ #include "VolumeCache.h"
+ #include "VolumeServer.h"
+ #include "Trace.h"
  
 /**
  * @brief Helper function to check if a given path is a regular file (not a directory).
@@ -57,6 +110,305 @@
      return (stat(path.c_str(), &sb) == 0 && (sb.st_mode & S_IFMT) == S_IFREG);
  }
 
+/**
+ * @brief True for volume operations that transform the voxels in place (blur, resize,
+ *        scale), as opposed to the slice, projection or render that ends the pipeline.
+ */
+ static bool isPreprocessing(const FilterOption &op) {
+     return op.name == "blur" || op.name == "resize" || op.name == "scale";
+ }
+
+/**
+ * @brief Size of the pixel buffer, for the bytes a traced stage touched.
+ */
+ static std::size_t imageBytes(const Image &img) {
+     return static_cast<std::size_t>(img.getWidth()) * img.getHeight() * img.getChannels();
+ }
+
+/**
+ * @brief Size of the voxel buffer, for the bytes a traced stage touched.
+ */
+ template <typename T>
+ static std::size_t volumeBytes(const BasicVolume<T> &vol) {
+     return vol.data.size() * sizeof(T);
+ }
+
+/**
+ * @brief Canonical text of an operation and its parameters, for the volume cache key.
+ */
+ static std::string describeOperation(const FilterOption &op) {
+     std::ostringstream text;
+     text.precision(9);
+     text << op.name << ' ' << op.subtype;
+     for (float v : op.floats) {
+         text << ' ' << v;
+     }
+     text << ';';
+     return text.str();
+ }
+
+/**
+ * @brief Runs the volume-mode pipeline with voxels of type T.
+ * 
+ * Loads the slices (or the cached result of the preprocessing with --volume-cache),
+ * applies the operations in order and writes the slice or projection that ends the
+ * pipeline.
+ * 
+ * @param opts The parsed command-line options.
+ * @return Process exit code.
+ */
+template <typename T>
+static int runVolume(const CommandOptions &opts) {
+    // Load the volume
+    BasicVolume<T> vol;
+    vol.firstSlice = (opts.firstIndex < 1 ? 1 : opts.firstIndex);
+    vol.lastSlice  = opts.lastIndex;
+    vol.extension  = opts.volumeExt;
+    vol.channels   = opts.volumeChannels;
+
+    // The leading blur/resize/scale steps are preprocessing: with --volume-cache the
+    // volume they produce is cached, keyed on the slices and on these steps
+    size_t prepared = 0;
+    std::string recipe;
+    while (prepared < opts.operations.size() && isPreprocessing(opts.operations[prepared])) {
+        recipe += describeOperation(opts.operations[prepared]);
+        ++prepared;
+    }
+    std::uint64_t cacheKey = 0;
+    std::string cacheFile;
+    bool fromCache = false;
+    {
+        Trace::Scope span("io", "load", opts.inputPath);
+        if (!opts.volumeCacheDir.empty()) {
+            cacheKey = VolumeCache::key(opts.inputPath, vol, recipe);
+            cacheFile = VolumeCache::path(opts.volumeCacheDir, cacheKey);
+            fromCache = VolumeCache::load(cacheFile, cacheKey, vol);
+            std::cout << "[Cache] " << (fromCache ? "hit: " : "miss: ") << cacheFile << "\n";
+        }
+
+        if (!fromCache && !vol.loadVolumeFromSlices(opts.inputPath)) {
+            std::cerr << "Failed to load volume from " << opts.inputPath << "\n";
+            return 1;
+        }
+        span.addBytes(volumeBytes(vol));
+    }
+
+    Filters3D filters3d; // We'll use this for blur & slicing
+
+    // The on-disk brick cache describes the slices as loaded, so it is only used
+    // until an operation changes the voxels
+    bool asLoaded = !fromCache || prepared == 0;
+    bool storePending = !opts.volumeCacheDir.empty() && !fromCache;
+
+    // Process each operation specified on the command line (a cache hit has
+    // already done the preprocessing)
+    for (size_t k = fromCache ? prepared : 0; k <= opts.operations.size(); ++k) {
+        if (k == prepared && storePending) {
+            storePending = false;
+            try {
+                Trace::Scope span("io", "cache store", cacheFile);
+                span.addBytes(volumeBytes(vol));
+                VolumeCache::save(cacheFile, cacheKey, vol);
+            }
+            catch (const std::exception &e) {
+                std::cerr << "[WARN] Volume cache not written: " << e.what() << "\n";
+            }
+        }
+        if (k == opts.operations.size()) {
+            break;
+        }
+        const FilterOption &op = opts.operations[k];
+        const std::string &nm = op.name;
+        const std::string &st = op.subtype;
+        const auto &vals = op.floats;
+
+        // Traced from here until the end of this step (the terminal steps include their
+        // writes); bytes count the volume read, plus the volume written by blur/resize/scale
+        Trace::Scope span("op", nm, st);
+        span.addBytes(volumeBytes(vol));
+
+        if (nm == "blur") {
+            float sz  = vals.size() > 0 ? vals[0] : 3.f;
+            float dev = vals.size() > 1 ? vals[1] : 2.f;
+            filters3d.apply3DBlur(vol, st, sz, dev);
+            span.addBytes(volumeBytes(vol));
+            asLoaded = false;
+        }
+        else if (nm == "resize" || nm == "scale") {
+            // Resamples each xy plane; the slice count is unchanged
+            asLoaded = false;
+            ResizeKernel kernel = st.empty() ? ResizeKernel::Bicubic : Resampler::GetResizeKernel(st);
+            if (nm == "resize") {
+                Resampler::resize(vol, static_cast<int>(vals[0]), static_cast<int>(vals[1]), kernel);
+            } else {
+                Resampler::scale(vol, vals[0], kernel);
+            }
+            span.addBytes(volumeBytes(vol));
+        }
+        /*else if (nm == "slice") {
+            if (vals.empty()) {
+                std::cerr << "ERROR: slice has no param.\n";
+                continue;
+            }
+            float c = vals[0];
+            filters3d.slice3D(vol, st, c, opts.outputPath);
+            std::cout << "[Done] slice => " << opts.outputPath << "\n";
+            return 0;
+        }*/
+        else if (nm == "slice") {
+            if (vals.empty()) {
+                std::cerr << "ERROR: slice has no param.\n";
+                continue;
+            }
+            float c = vals[0];
+        
+            // Instead of filters3d.slice3D(...):
+            // Call the dedicated Slicing3D method and pass c as an integer (if that is desired):
+            Slicing3D::slice3D(vol, st, static_cast<int>(c), opts.outputPath, opts.writeOptions);
+        
+            std::cout << "[Done] slice => " << opts.outputPath << "\n";
+            return 0;
+        }
+        else if (nm == "slab") {
+            // Sliding thick slabs: thickness, optional step (default: the thickness, no overlap)
+            ProjectionAxis axis = op.axis.empty() ? ProjectionAxis::Z : Projections3D::GetProjectionAxis(op.axis);
+            int thickness = static_cast<int>(vals[0]);
+            int step = vals.size() > 1 ? static_cast<int>(vals[1]) : thickness;
+            int written = Projections3D::slidingSlab(vol, st, thickness, step, opts.outputPath,
+                                                     opts.writeOptions, axis);
+            if (written == 0) {
+                return 1;
+            }
+            std::cout << "[Done] " << written << " slabs => " << opts.outputPath << " (indexed)\n";
+            return 0;
+        }
+        else if (nm == "slices") {
+            // Optional first, last and step; by default every slice along the axis
+            int first = vals.size() > 0 ? static_cast<int>(vals[0]) : 0;
+            int last  = vals.size() > 1 ? static_cast<int>(vals[1]) : -1;
+            int step  = vals.size() > 2 ? static_cast<int>(vals[2]) : 1;
+            int written = Slicing3D::exportSlices(vol, st, first, last, step, opts.outputPath, opts.writeOptions);
+            if (written == 0) {
+                return 1;
+            }
+            std::cout << "[Done] " << written << " slices => " << opts.outputPath << " (indexed)\n";
+            return 0;
+        }
+        else if (nm == "cpr") {
+            std::vector<Vec3> path;
+            try {
+                path = Slicing3D::loadPath(op.path);
+            }
+            catch (const std::exception &e) {
+                std::cerr << "ERROR: " << e.what() << "\n";
+                return 1;
+            }
+            const int outW = vals.size() > 0 ? static_cast<int>(vals[0]) : 64;
+            const double spacing = vals.size() > 1 ? vals[1] : 1.0;
+            if (!Slicing3D::sliceCurved(vol, path, outW, spacing, st != "Polyline", opts.outputPath,
+                                        opts.writeOptions)) {
+                return 1;
+            }
+            std::cout << "[Done] curved reformation => " << opts.outputPath << "\n";
+            return 0;
+        }
+        else if (nm == "oblique") {
+            // Floats: the plane (6 or 9 numbers), then optional width, height and spacing
+            const size_t planeLen = (st == "points") ? 9 : 6;
+            ObliquePlane plane;
+            try {
+                if (st == "points") {
+                    plane = ObliquePlane::fromPoints({ vals[0], vals[1], vals[2] }, { vals[3], vals[4], vals[5] },
+                                                     { vals[6], vals[7], vals[8] });
+                } else {
+                    plane = ObliquePlane::fromNormal({ vals[0], vals[1], vals[2] }, { vals[3], vals[4], vals[5] });
+                }
+            }
+            catch (const std::exception &e) {
+                std::cerr << "ERROR: " << e.what() << "\n";
+                return 1;
+            }
+            const int side = std::max({ vol.width, vol.height, vol.depth });
+            const int outW = vals.size() > planeLen ? static_cast<int>(vals[planeLen]) : side;
+            const int outH = vals.size() > planeLen + 1 ? static_cast<int>(vals[planeLen + 1]) : outW;
+            const double spacing = vals.size() > planeLen + 2 ? vals[planeLen + 2] : 1.0;
+            if (!Slicing3D::sliceOblique(vol, plane, outW, outH, spacing, opts.outputPath, opts.writeOptions)) {
+                return 1;
+            }
+            std::cout << "[Done] oblique slice => " << opts.outputPath << "\n";
+            return 0;
+        }
+        else if (nm == "render") {
+            // Floats: optional yaw, pitch, width, height and step
+            if (vol.channels != 1) {
+                std::cerr << "ERROR: render needs a single-channel volume (use --channels 1)\n";
+                return 1;
+            }
+            Camera cam;
+            cam.yaw = vals.size() > 0 ? vals[0] : 0.0;
+            cam.pitch = vals.size() > 1 ? vals[1] : 0.0;
+            cam.width = vals.size() > 3 ? static_cast<int>(vals[2]) : 0;
+            cam.height = vals.size() > 3 ? static_cast<int>(vals[3]) : 0;
+            cam.step = vals.size() > 4 ? vals[4] : 1.0;
+            try {
+                RayCaster<T> caster = (opts.useBrickCache && asLoaded)
+                                          ? RayCaster<T>(vol, BrickGrid::cached(vol, opts.inputPath))
+                                          : RayCaster<T>(vol);
+                if (!opts.transferPath.empty()) {
+                    caster.setTransferFunction(TransferFunction::load(opts.transferPath));
+                }
+                const RenderMode mode = RayCaster<T>::GetRenderMode(st);
+                if (opts.renderFrames <= 1) {
+                    caster.renderToFile(cam, mode, opts.outputPath, opts.writeOptions);
+                } else {
+                    // Size the frames for the widest view so they all match
+                    const double across = std::hypot(static_cast<double>(vol.width), static_cast<double>(vol.depth));
+                    const double tilt = cam.pitch * 3.14159265358979323846 / 180.0;
+                    if (cam.width <= 0) {
+                        cam.width = static_cast<int>(std::ceil(across));
+                    }
+                    if (cam.height <= 0) {
+                        cam.height = static_cast<int>(std::ceil(vol.height * std::abs(std::cos(tilt)) +
+                                                                across * std::abs(std::sin(tilt))));
+                    }
+                    const double start = cam.yaw;
+                    for (int f = 0; f < opts.renderFrames; ++f) {
+                        cam.yaw = start + 360.0 * f / opts.renderFrames;
+                        caster.renderToFile(cam, mode, Slicing3D::slicePath(opts.outputPath, f), opts.writeOptions);
+                    }
+                }
+            }
+            catch (const std::exception &e) {
+                std::cerr << "ERROR: " << e.what() << "\n";
+                return 1;
+            }
+            std::cout << "[Done] render => " << opts.outputPath << "\n";
+            return 0;
+        }
+        else if (nm == "projection") {
+            ProjectionAxis axis = op.axis.empty() ? ProjectionAxis::Z : Projections3D::GetProjectionAxis(op.axis);
+            BrickGrid grid;
+            if (opts.useBrickCache && asLoaded && axis == ProjectionAxis::Z && (st == "MIP" || st == "MinIP")) {
+                grid = BrickGrid::cached(vol, opts.inputPath);
+                const float background = (st == "MIP") ? grid.globalMin() : grid.globalMax();
+                std::cout << "[Bricks] " << std::lround(grid.fractionUniform(background) * 100.0)
+                          << "% of bricks are background\n";
+            }
+            // -f/-l select the slices loaded along z; along x or y the whole axis is projected
+            const bool alongZ = axis == ProjectionAxis::Z;
+            Projections3D::applyProjection3D(vol, st, opts.outputPath,
+                                             alongZ ? opts.firstIndex : -1, alongZ ? opts.lastIndex : -1,
+                                             opts.writeOptions, axis, grid.empty() ? nullptr : &grid);
+            std::cout << "[Done] projection => " << opts.outputPath << "\n";
+            return 0;
+        }
+        else {
+            std::cout << "[WARN] Unimplemented volume op: " << nm << "\n";
+        }
+    }
+    return 0;
+}
+
 /**
  * @brief Main entry point of the program.
  * 
@@ -72,15 +424,38 @@
     // Parse command line arguments into opts.
     CommandOptions opts = CommandLine::parseArgs(argc, argv);
 
+    // With "-" as the output the encoded image owns standard output, so progress
+    // messages go to standard error instead
+    if (opts.outputPath == "-") {
+        std::cout.rdbuf(std::cerr.rdbuf());
+    }
+
+    // With --trace, time the load, each operation and the writes; the summary (or the
+    // Chrome trace file) is written when main returns
+    std::unique_ptr<Trace::Session> trace;
+    if (opts.trace) {
+        trace = std::make_unique<Trace::Session>(opts.tracePath);
+    }
+
     // ------------------- 2D image mode -------------------
     if (opts.isImage) {
-        if (!isRegularFile(opts.inputPath)) {
+        if (opts.inputPath != "-" && !isRegularFile(opts.inputPath)) {
             std::cerr << "ERROR: Input file not found: " << opts.inputPath << "\n";
             return 1;
         }
 
-        // Load the 2D image
-        Image img(opts.inputPath.c_str());
+        // Load the 2D image ("-" decodes it from standard input)
+        std::unique_ptr<Image> loaded;
+        try {
+            Trace::Scope span("io", "load", opts.inputPath);
+            loaded = std::make_unique<Image>(opts.inputPath.c_str());
+            span.addBytes(imageBytes(*loaded));
+        }
+        catch (const std::exception &e) {
+            std::cerr << "ERROR: " << e.what() << "\n";
+            return 1;
+        }
+        Image &img = *loaded;
         Filters2D filter2d;
 
         // Process each operation specified on the command line
@@ -89,6 +464,10 @@
             const std::string &st = op.subtype;
             const auto &vals = op.floats;
 
+            // Bytes count the image before and after the step
+            Trace::Scope span("op", nm, st);
+            span.addBytes(imageBytes(img));
+
             if (nm == "greyscale") {
                 filter2d.apply_Greyscale(img);
             }
@@ -122,16 +501,52 @@
                 }
             }
             else if (nm == "edge") {
-                filter2d.apply_Greyscale(img);
+                // DetectEdges/CannyEdges convert colour input to greyscale themselves
                 EdgeDetectorType edgeType = filter2d.GetEdgeDetectorType(st);
-                filter2d.DetectEdges(img, edgeType);
+                if (edgeType == EdgeDetectorType::Canny) {
+                    float lo = vals.size() > 0 ? vals[0] : 20.f;
+                    float hi = vals.size() > 1 ? vals[1] : 50.f;
+                    filter2d.CannyEdges(img, lo, hi);
+                } else {
+                    filter2d.DetectEdges(img, edgeType);
+                }
             }
             else if (nm == "sharpen") {
-                filter2d.Sharpen(img);
+                float strength = vals.empty() ? 1.f : vals[0];
+                filter2d.Sharpen(img, strength);
+            }
+            else if (nm == "unsharp") {
+                float amount = vals.size() > 0 ? vals[0] : 1.f;
+                float radius = vals.size() > 1 ? vals[1] : 1.f;
+                int thr      = vals.size() > 2 ? static_cast<int>(vals[2]) : 0;
+                filter2d.unsharpMask(img, amount, radius, thr);
             }
             else if (nm == "saltpepper") {
                 float amt = vals.empty() ? 5.f : vals[0];
-                filter2d.apply_Salt_and_Pepper_Noise(img, amt);
+                if (opts.hasSeed) {
+                    filter2d.apply_Salt_and_Pepper_Noise(img, amt, opts.seed);
+                } else {
+                    filter2d.apply_Salt_and_Pepper_Noise(img, amt);
+                }
+            }
+            else if (nm == "resize" || nm == "scale") {
+                ResizeKernel kernel = st.empty() ? ResizeKernel::Bicubic : Resampler::GetResizeKernel(st);
+                if (nm == "resize") {
+                    Resampler::resize(img, static_cast<int>(vals[0]), static_cast<int>(vals[1]), kernel);
+                } else {
+                    Resampler::scale(img, vals[0], kernel);
+                }
+            }
+            else if (nm == "level") {
+                // Only the levels up to the requested one are built
+                int lvl = std::max(0, static_cast<int>(vals[0]));
+                Pyramid pyramid(img, lvl + 1);
+                if (lvl >= pyramid.levels()) {
+                    std::cerr << "[WARN] Pyramid has only " << pyramid.levels()
+                              << " levels; using level " << pyramid.levels() - 1 << "\n";
+                    lvl = pyramid.levels() - 1;
+                }
+                pyramid.copyLevelTo(lvl, img);
             }
             else if (nm == "threshold") {
                 float thr = vals.empty() ? 127.f : vals[0];
@@ -145,74 +560,47 @@
             else {
                 std::cerr << "[WARN] Unimplemented 2D op: " << nm << "\n";
             }
+            span.addBytes(imageBytes(img));
         }
 
-        // Save the final 2D result
-        Image::WriteImage(img, opts.outputPath.c_str());
+        // Save the final 2D result ("-" encodes it to standard output)
+        try {
+            Image::WriteImage(img, opts.outputPath.c_str(), opts.writeOptions);
+        }
+        catch (const std::exception &e) {
+            std::cerr << "ERROR: " << e.what() << "\n";
+            return 1;
+        }
         return 0;
     }
 
-    // ------------------- 3D volume mode -------------------
-    else if (opts.isVolume) {
-        // Load the volume
-        Volume vol;
-        vol.firstSlice = (opts.firstIndex < 1 ? 1 : opts.firstIndex);
-        vol.lastSlice  = opts.lastIndex;
-        vol.extension  = opts.volumeExt;
-
-        if (!vol.loadVolumeFromSlices(opts.inputPath)) {
-            std::cerr << "Failed to load volume from " << opts.inputPath << "\n";
+    // ------------------- server mode -------------------
+    else if (opts.isServer) {
+        try {
+            VolumeServer server(opts.serverWorkers);
+            server.serve(opts.serverSocket);
+        }
+        catch (const std::exception &e) {
+            std::cerr << "ERROR: " << e.what() << "\n";
             return 1;
         }
+        return 0;
+    }
 
-        Filters3D filters3d; // We'll use this for blur & slicing
-
-        // Process each operation specified on the command line
-        for (auto &op : opts.operations) {
-            const std::string &nm = op.name;
-            const std::string &st = op.subtype;
-            const auto &vals = op.floats;
+    // ------------------- 3D volume mode -------------------
+    else if (opts.isVolume) {
+        // Pick the voxel type: 16-bit slices stay 16-bit unless told otherwise
+        const int firstSlice = (opts.firstIndex < 1 ? 1 : opts.firstIndex);
+        VoxelType type = opts.voxelType;
+        if (type == VoxelType::Auto) {
+            type = probeVoxelType(opts.inputPath, firstSlice, opts.lastIndex);
+        }
 
-            if (nm == "blur") {
-                float sz  = vals.size() > 0 ? vals[0] : 3.f;
-                float dev = vals.size() > 1 ? vals[1] : 2.f;
-                filters3d.apply3DBlur(vol, st, sz, dev);
-            }
-            /*else if (nm == "slice") {
-                if (vals.empty()) {
-                    std::cerr << "ERROR: slice has no param.\n";
-                    continue;
-                }
-                float c = vals[0];
-                filters3d.slice3D(vol, st, c, opts.outputPath);
-                std::cout << "[Done] slice => " << opts.outputPath << "\n";
-                return 0;
-            }*/
-            else if (nm == "slice") {
-                if (vals.empty()) {
-                    std::cerr << "ERROR: slice has no param.\n";
-                    continue;
-                }
-                float c = vals[0];
-            
-                // Instead of filters3d.slice3D(...):
-                // Call the dedicated Slicing3D method and pass c as an integer (if that is desired):
-                Slicing3D::slice3D(vol, st, static_cast<int>(c), opts.outputPath);
-            
-                std::cout << "[Done] slice => " << opts.outputPath << "\n";
-                return 0;
-            }
-            else if (nm == "projection") {
-                Projections3D::applyProjection3D(vol, st, opts.outputPath,
-                                                 opts.firstIndex, opts.lastIndex);
-                std::cout << "[Done] projection => " << opts.outputPath << "\n";
-                return 0;
-            }
-            else {
-                std::cout << "[WARN] Unimplemented volume op: " << nm << "\n";
-            }
+        switch (type) {
+            case VoxelType::UInt16:  return runVolume<std::uint16_t>(opts);
+            case VoxelType::Float32: return runVolume<float>(opts);
+            default:                 return runVolume<unsigned char>(opts);
         }
-        return 0;
     }
 
     std::cerr << "ERROR: Neither image nor volume.\n";
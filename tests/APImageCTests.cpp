@@ -0,0 +1,214 @@
+#include "APImageCTests.h"
+#include "../src/Filters2D.h"
+#include "../src/Image.h"
+#include "../src/Volume.h"
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+namespace {
+
+std::vector<unsigned char> gradientPixels(int w, int h, int c) {
+    std::vector<unsigned char> pixels(static_cast<size_t>(w) * h * c);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<unsigned char>((i * 37) % 251);
+    }
+    return pixels;
+}
+
+void expectStatus(apimage_status got, apimage_status want, const std::string& what) {
+    if (got != want) {
+        throw std::runtime_error(what + ": expected status " + std::to_string(want) + ", got " +
+                                 std::to_string(got) + " (" + apimage_last_error() + ")");
+    }
+}
+
+} // namespace
+
+void APImageCTests::testImageFilters() {
+    if (apimage_abi_version() != APIMAGE_ABI_VERSION) {
+        throw std::runtime_error("Library and header ABI versions differ.");
+    }
+
+    // Results on the caller's buffer match the C++ filters on an Image
+    std::vector<unsigned char> pixels = gradientPixels(12, 9, 3);
+    apimage_image image = { pixels.data(), 12, 9, 3 };
+    expectStatus(apimage_blur(&image, "Gaussian", 5, 1.5f), APIMAGE_OK, "Gaussian blur");
+
+    std::vector<unsigned char> source = gradientPixels(12, 9, 3);
+    Image reference(source.data(), 12, 9, 3);
+    Filters2D filters;
+    filters.gaussianBlur(reference, 5, 1.5f);
+    if (std::memcmp(pixels.data(), reference.getData(), pixels.size()) != 0) {
+        throw std::runtime_error("C blur differs from Filters2D::gaussianBlur.");
+    }
+
+    // Edge detection shrinks the image to one channel and reports it
+    std::vector<float> orientation(12 * 9, -100.0f);
+    expectStatus(apimage_detect_edges(&image, "Sobel", 0, orientation.data()), APIMAGE_OK, "Sobel");
+    filters.DetectEdges(reference, EdgeDetectorType::Sobel);
+    if (image.channels != 1 || std::memcmp(pixels.data(), reference.getData(), 12 * 9) != 0) {
+        throw std::runtime_error("C Sobel should match DetectEdges and leave one channel.");
+    }
+    if (orientation[0] < -4.0f) {
+        throw std::runtime_error("Sobel orientation was not written.");
+    }
+
+    std::vector<unsigned char> grey = gradientPixels(8, 8, 4);
+    apimage_image rgba = { grey.data(), 8, 8, 4 };
+    expectStatus(apimage_greyscale(&rgba), APIMAGE_OK, "greyscale");
+    expectStatus(apimage_threshold(&rgba, 128, "HSV"), APIMAGE_OK, "threshold");
+    for (int i = 0; i < 64; ++i) {
+        if (grey[i] != 0 && grey[i] != 255) {
+            throw std::runtime_error("Threshold should leave only 0 and 255.");
+        }
+    }
+}
+
+void APImageCTests::testVolumeBuffers() {
+    apimage_volume* volume = nullptr;
+    expectStatus(apimage_volume_create(APIMAGE_VOXEL_UINT16, 4, 3, 5, 1, &volume), APIMAGE_OK, "create");
+
+    // Filled in place through the exposed storage: voxel (x, y, z) = 100z + 10y + x
+    std::uint16_t* voxels = static_cast<std::uint16_t*>(apimage_volume_data(volume));
+    for (int z = 0; z < 5; ++z)
+        for (int y = 0; y < 3; ++y)
+            for (int x = 0; x < 4; ++x)
+                voxels[(z * 3 + y) * 4 + x] = static_cast<std::uint16_t>(100 * z + 10 * y + x);
+
+    apimage_voxel_type type = APIMAGE_VOXEL_AUTO;
+    int w = 0, h = 0, d = 0, c = 0;
+    expectStatus(apimage_volume_info(volume, &type, &w, &h, &d, &c), APIMAGE_OK, "info");
+    if (type != APIMAGE_VOXEL_UINT16 || w != 4 || h != 3 || d != 5 || c != 1) {
+        throw std::runtime_error("Volume info does not match the created volume.");
+    }
+
+    // Two-call pattern: ask for the size, then fill
+    int outW = 0, outH = 0;
+    expectStatus(apimage_project(volume, "MIP", 'z', 1, 3, nullptr, 0, &outW, &outH), APIMAGE_ERROR_BUFFER_TOO_SMALL,
+                 "MIP size query");
+    if (outW != 4 || outH != 3) {
+        throw std::runtime_error("The size query should report the projection size.");
+    }
+    std::vector<std::uint16_t> plane(static_cast<size_t>(outW) * outH);
+    expectStatus(apimage_project(volume, "MIP", 'z', 1, 3, plane.data(), plane.size() * 2, &outW, &outH), APIMAGE_OK,
+                 "MIP");
+    if (plane[0] != 300 || plane[11] != 323) {
+        throw std::runtime_error("MIP of slab 1..3 should take slice 3.");
+    }
+    expectStatus(apimage_project(volume, "AIP", 'z', -1, -1, plane.data(), plane.size() * 2, &outW, &outH),
+                 APIMAGE_OK, "AIP");
+    if (plane[5] != 211) {
+        throw std::runtime_error("AIP should average all slices.");
+    }
+
+    std::vector<std::uint16_t> slice(4 * 5);
+    expectStatus(apimage_slice(volume, "xz", 2, slice.data(), slice.size() * 2, &outW, &outH), APIMAGE_OK, "XZ slice");
+    if (outW != 4 || outH != 5 || slice[4 * 3 + 1] != 321) {
+        throw std::runtime_error("XZ slice at y=2 has the wrong size or values.");
+    }
+
+    // An oblique plane along z through a voxel centre reproduces the XY slice
+    const double point[3] = { 1.5, 1.0, 2.0 };
+    const double normal[3] = { 0.0, 0.0, 1.0 };
+    std::vector<std::uint16_t> oblique(4 * 3);
+    expectStatus(apimage_slice_oblique(volume, point, normal, 4, 3, 1.0, oblique.data(), oblique.size() * 2),
+                 APIMAGE_OK, "oblique");
+    if (oblique[0] != 200 || oblique[11] != 223) {
+        throw std::runtime_error("Axial oblique slice should match slice z=2.");
+    }
+
+    expectStatus(apimage_volume_blur(volume, "Median", 3, 0.0f), APIMAGE_OK, "3D median");
+    apimage_volume_free(volume);
+}
+
+void APImageCTests::testErrors() {
+    std::vector<unsigned char> pixels = gradientPixels(4, 4, 1);
+    apimage_image image = { pixels.data(), 4, 4, 1 };
+    expectStatus(apimage_blur(&image, "Bilateral", 3, 1.0f), APIMAGE_ERROR_INVALID_ARGUMENT, "unknown blur");
+    if (std::string(apimage_last_error()).empty()) {
+        throw std::runtime_error("A failed call should leave an error message.");
+    }
+    expectStatus(apimage_sharpen(nullptr, 1.0f), APIMAGE_ERROR_INVALID_ARGUMENT, "null image");
+
+    // Grey + alpha is valid image data, but not an input of the colour-space kernels
+    std::vector<unsigned char> greyAlpha = gradientPixels(4, 4, 2);
+    const std::vector<unsigned char> untouched = greyAlpha;
+    apimage_image twoChannel = { greyAlpha.data(), 4, 4, 2 };
+    expectStatus(apimage_histogram_equalise(&twoChannel, "HSV"), APIMAGE_ERROR_INVALID_ARGUMENT,
+                 "2-channel histogram");
+    expectStatus(apimage_threshold(&twoChannel, 100, "HSL"), APIMAGE_ERROR_INVALID_ARGUMENT, "2-channel threshold");
+    if (std::string(apimage_last_error()).empty() || greyAlpha != untouched) {
+        throw std::runtime_error("A rejected image should be left as it was, with an error message.");
+    }
+    expectStatus(apimage_brightness(&image, 10), APIMAGE_OK, "brightness");
+    if (!std::string(apimage_last_error()).empty()) {
+        throw std::runtime_error("A successful call should clear the error message.");
+    }
+
+    apimage_volume* volume = nullptr;
+    expectStatus(apimage_volume_create(APIMAGE_VOXEL_AUTO, 2, 2, 2, 1, &volume), APIMAGE_ERROR_INVALID_ARGUMENT,
+                 "AUTO create");
+    expectStatus(apimage_volume_load("no/such/folder", APIMAGE_VOXEL_UINT8, 1, -1, 0, &volume), APIMAGE_ERROR_IO,
+                 "missing folder");
+    if (volume != nullptr) {
+        throw std::runtime_error("A failed load should not return a volume.");
+    }
+
+    expectStatus(apimage_volume_create(APIMAGE_VOXEL_FLOAT32, 3, 3, 3, 1, &volume), APIMAGE_OK, "create");
+    float small[4];
+    int w = 0, h = 0;
+    expectStatus(apimage_slice(volume, "YZ", 7, small, sizeof(small), &w, &h), APIMAGE_ERROR_INVALID_ARGUMENT,
+                 "slice out of range");
+    expectStatus(apimage_slice(volume, "YZ", 1, small, sizeof(small), &w, &h), APIMAGE_ERROR_BUFFER_TOO_SMALL,
+                 "small buffer");
+    expectStatus(apimage_project(volume, "Sum", 'z', -1, -1, small, sizeof(small), &w, &h),
+                 APIMAGE_ERROR_INVALID_ARGUMENT, "unknown projection");
+    const double point[3] = { 1.0, 1.0, 1.0 };
+    const double zero[3] = { 0.0, 0.0, 0.0 };
+    expectStatus(apimage_slice_oblique(volume, point, zero, 2, 2, 1.0, small, sizeof(small)),
+                 APIMAGE_ERROR_INVALID_ARGUMENT, "zero normal");
+    apimage_volume_free(volume);
+}
+
+void APImageCTests::testQuietLoad() {
+    const std::string folder = "capiLoadTest";
+    mkdir(folder.c_str(), 0755);
+    std::vector<unsigned char> plane = gradientPixels(6, 5, 1);
+    for (int z = 1; z <= 3; ++z) {
+        writeVoxelPlane(plane.data(), 6, 5, 1, folder + "/slice" + std::to_string(z) + ".png", ImageWriteOptions{});
+    }
+
+    // The host owns the process streams: neither a load nor a failed load may print
+    std::ostringstream captured;
+    std::streambuf* oldCout = std::cout.rdbuf(captured.rdbuf());
+    std::streambuf* oldCerr = std::cerr.rdbuf(captured.rdbuf());
+    apimage_volume* volume = nullptr;
+    apimage_volume* missing = nullptr;
+    const apimage_status loaded = apimage_volume_load(folder.c_str(), APIMAGE_VOXEL_AUTO, 1, -1, 0, &volume);
+    const apimage_status failed = apimage_volume_load("no/such/folder", APIMAGE_VOXEL_UINT8, 1, -1, 0, &missing);
+    const std::string message = apimage_last_error();
+    std::cout.rdbuf(oldCout);
+    std::cerr.rdbuf(oldCerr);
+
+    expectStatus(loaded, APIMAGE_OK, "load");
+    expectStatus(failed, APIMAGE_ERROR_IO, "missing folder");
+    apimage_voxel_type type;
+    int w = 0, h = 0, d = 0, c = 0;
+    expectStatus(apimage_volume_info(volume, &type, &w, &h, &d, &c), APIMAGE_OK, "info");
+    apimage_volume_free(volume);
+    if (w != 6 || h != 5 || d != 3 || c != 1) {
+        throw std::runtime_error("Loaded volume should be 6 x 5 x 3 with one channel.");
+    }
+    if (!captured.str().empty()) {
+        throw std::runtime_error("Volume load printed: " + captured.str());
+    }
+    if (message.find("Cannot open directory") == std::string::npos) {
+        throw std::runtime_error("Load error should give the reason, got: " + message);
+    }
+}
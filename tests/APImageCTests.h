@@ -0,0 +1,16 @@
+#ifndef APIMAGE_C_TESTS_H
+#define APIMAGE_C_TESTS_H
+
+#include "../src/APImageC.h"
+#include <iostream>
+#include <cassert>
+
+class APImageCTests {
+public:
+    void testImageFilters();
+    void testVolumeBuffers();
+    void testErrors();
+    void testQuietLoad();
+};
+
+#endif // APIMAGE_C_TESTS_H
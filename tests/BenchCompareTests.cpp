@@ -0,0 +1,125 @@
+#include "BenchCompareTests.h"
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool near(double a, double b, double tolerance) {
+    return std::fabs(a - b) <= tolerance;
+}
+
+// n run times around `seconds`, with a small spread and no ties
+std::vector<double> samples(double seconds, int n, double spread = 0.02) {
+    std::vector<double> out;
+    for (int i = 0; i < n; ++i) {
+        out.push_back(seconds * (1.0 + spread * ((i * 7 % n) - n / 2.0) / n));
+    }
+    return out;
+}
+
+BenchResult result(const std::string& kernel, const std::vector<double>& seconds) {
+    BenchResult r;
+    r.kernel = kernel;
+    r.variant = "k5";
+    r.shape = "1024x1024x3";
+    r.items = 1024 * 1024;
+    r.bytes = 2 * 3 * 1024 * 1024;
+    r.seconds = seconds;
+    return r;
+}
+
+} // namespace
+
+void BenchCompareTests::testMannWhitney() {
+    // Exact tails: all C(6, 3) = 20 orderings equally likely, C(10, 5) = 252
+    if (!near(BenchCompare::mannWhitneyGreater({ 4, 5, 6 }, { 1, 2, 3 }), 1.0 / 20.0, 1e-12) ||
+        !near(BenchCompare::mannWhitneyGreater({ 1, 2, 3 }, { 4, 5, 6 }), 1.0, 1e-12) ||
+        !near(BenchCompare::mannWhitneyGreater({ 1, 3 }, { 2 }), 2.0 / 3.0, 1e-12) ||
+        !near(BenchCompare::mannWhitneyGreater({ 6, 7, 8, 9, 10 }, { 1, 2, 3, 4, 5 }), 1.0 / 252.0, 1e-12)) {
+        throw std::runtime_error("Exact Mann-Whitney p-values are wrong.");
+    }
+
+    // Ties switch to the normal approximation: identical samples are not significant,
+    // a clear shift is
+    const std::vector<double> flat(40, 1.0);
+    std::vector<double> shifted(40, 1.0);
+    for (size_t i = 20; i < shifted.size(); ++i) {
+        shifted[i] = 2.0;
+    }
+    std::vector<double> high(40, 3.0);
+    if (BenchCompare::mannWhitneyGreater(flat, flat) < 0.4 || BenchCompare::mannWhitneyGreater(high, shifted) > 1e-6 ||
+        BenchCompare::mannWhitneyGreater(shifted, high) < 0.99) {
+        throw std::runtime_error("Approximate Mann-Whitney p-values are wrong.");
+    }
+}
+
+void BenchCompareTests::testVerdicts() {
+    const std::vector<BenchResult> baseline = { result("slower", samples(0.010, 10)),
+                                                result("same", samples(0.010, 10)),
+                                                result("faster", samples(0.010, 10)),
+                                                result("small", samples(0.010, 10)),
+                                                result("dropped", samples(0.010, 10)) };
+    const std::vector<BenchResult> current = { result("slower", samples(0.015, 10)),
+                                               result("same", samples(0.010, 10, 0.03)),
+                                               result("faster", samples(0.005, 10)),
+                                               result("small", samples(0.0105, 10)),
+                                               result("new", samples(0.010, 10)) };
+    const std::vector<BenchComparison> c = BenchCompare::compare(baseline, current, 0.01, 0.10);
+    if (c.size() != 4) {
+        throw std::runtime_error("Only cases in both runs should be compared.");
+    }
+    if (c[0].verdict != BenchComparison::Verdict::Slower || !near(c[0].ratio, 1.5, 0.02) || c[0].pSlower > 0.01 ||
+        c[0].ratioLow <= 1.0 || c[0].ratioHigh < c[0].ratioLow) {
+        throw std::runtime_error("A 50% slowdown should be flagged.");
+    }
+    if (c[1].verdict != BenchComparison::Verdict::Unchanged) {
+        throw std::runtime_error("Equal timings should not be flagged.");
+    }
+    if (c[2].verdict != BenchComparison::Verdict::Faster) {
+        throw std::runtime_error("A 2x speedup should be reported.");
+    }
+    // Significant but below the 10% threshold
+    if (c[3].pSlower > 0.01 || c[3].verdict != BenchComparison::Verdict::Unchanged) {
+        throw std::runtime_error("A 5% slowdown should stay under a 10% threshold.");
+    }
+}
+
+void BenchCompareTests::testJsonRoundTrip() {
+    const std::vector<BenchResult> written = { result("Filters2D::boxBlur", { 0.0125, 0.0131, 0.0119 }),
+                                               result("Projections3D::project", { 1.5e-4 }) };
+    std::stringstream json;
+    BenchRunner::writeJson(written, json);
+    const std::vector<BenchResult> read = BenchRunner::readJson(json);
+    if (read.size() != written.size()) {
+        throw std::runtime_error("Every result should be read back.");
+    }
+    for (size_t i = 0; i < read.size(); ++i) {
+        if (read[i].key() != written[i].key() || read[i].items != written[i].items ||
+            read[i].bytes != written[i].bytes || read[i].seconds.size() != written[i].seconds.size()) {
+            throw std::runtime_error("Result " + std::to_string(i) + " was not read back.");
+        }
+        for (size_t k = 0; k < read[i].seconds.size(); ++k) {
+            if (!near(read[i].seconds[k], written[i].seconds[k], 1e-12)) {
+                throw std::runtime_error("Run times should survive the round trip.");
+            }
+        }
+    }
+
+    for (const char* broken : { "", "{\"results\": [", "{\"threads\": 4}", "{\"results\": [{\"kernel\": 1}]}" }) {
+        std::istringstream in(broken);
+        bool threw = false;
+        try {
+            BenchRunner::readJson(in);
+        }
+        catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) {
+            throw std::runtime_error(std::string("Malformed baseline was accepted: ") + broken);
+        }
+    }
+}
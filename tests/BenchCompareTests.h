@@ -0,0 +1,15 @@
+#ifndef BENCH_COMPARE_TESTS_H
+#define BENCH_COMPARE_TESTS_H
+
+#include "../bench/BenchCompare.h"
+#include <iostream>
+#include <cassert>
+
+class BenchCompareTests {
+public:
+    void testMannWhitney();
+    void testVerdicts();
+    void testJsonRoundTrip();
+};
+
+#endif // BENCH_COMPARE_TESTS_H
@@ -0,0 +1,138 @@
+#include "BrickGridTests.h"
+#include "TestVolumes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+void BrickGridTests::testMinMax() {
+    Volume vol = noiseVolume(37, 20, 18, 1, 7u);
+    BrickGrid grid(vol, 8);
+    if (grid.bricksX() != 5 || grid.bricksY() != 3 || grid.bricksZ() != 3) {
+        throw std::runtime_error("Unexpected brick counts.");
+    }
+    for (int bz = 0; bz < grid.bricksZ(); ++bz) {
+        for (int by = 0; by < grid.bricksY(); ++by) {
+            for (int bx = 0; bx < grid.bricksX(); ++bx) {
+                // Each brick also covers the first voxel of its neighbour
+                int mn = 255, mx = 0;
+                for (int z = bz * 8; z <= std::min(bz * 8 + 8, vol.depth - 1); ++z) {
+                    for (int y = by * 8; y <= std::min(by * 8 + 8, vol.height - 1); ++y) {
+                        for (int x = bx * 8; x <= std::min(bx * 8 + 8, vol.width - 1); ++x) {
+                            mn = std::min<int>(mn, vol.getVoxel(x, y, z));
+                            mx = std::max<int>(mx, vol.getVoxel(x, y, z));
+                        }
+                    }
+                }
+                if (grid.minAt(bx, by, bz) != mn || grid.maxAt(bx, by, bz) != mx) {
+                    throw std::runtime_error("Wrong range for brick (" + std::to_string(bx) + ", " +
+                                             std::to_string(by) + ", " + std::to_string(bz) + ").");
+                }
+            }
+        }
+    }
+    const auto [lo, hi] = std::minmax_element(vol.data.begin(), vol.data.end());
+    if (grid.globalMin() != *lo || grid.globalMax() != *hi) {
+        throw std::runtime_error("Wrong global range.");
+    }
+}
+
+void BrickGridTests::testMeansAndRange() {
+    Volume vol = noiseVolume(20, 9, 17, 1, 11u);
+    BrickGrid grid(vol, 8);
+
+    // The mean covers the voxels the brick owns, without the apron
+    for (int bz = 0; bz < grid.bricksZ(); ++bz) {
+        for (int bx = 0; bx < grid.bricksX(); ++bx) {
+            double sum = 0.0;
+            int count = 0;
+            for (int z = bz * 8; z < std::min(bz * 8 + 8, vol.depth); ++z) {
+                for (int y = 0; y < std::min(8, vol.height); ++y) {
+                    for (int x = bx * 8; x < std::min(bx * 8 + 8, vol.width); ++x) {
+                        sum += vol.getVoxel(x, y, z);
+                        ++count;
+                    }
+                }
+            }
+            if (std::abs(grid.meanAt(bx, 0, bz) - sum / count) > 1e-3) {
+                throw std::runtime_error("Wrong mean for brick (" + std::to_string(bx) + ", 0, " +
+                                         std::to_string(bz) + ").");
+            }
+        }
+    }
+
+    // A range query is the union of the overlapping bricks
+    BrickGrid::Range r = grid.rangeOver(3, 2, 9, 12, 4, 10);
+    float mn = grid.minAt(0, 0, 1), mx = grid.maxAt(0, 0, 1);
+    mn = std::min(mn, grid.minAt(1, 0, 1));
+    mx = std::max(mx, grid.maxAt(1, 0, 1));
+    if (r.min != mn || r.max != mx) {
+        throw std::runtime_error("rangeOver should combine the bricks it touches.");
+    }
+
+    Volume empty(16, 16, 16, 1);
+    if (BrickGrid(empty, 8).fractionUniform(0.0f) != 1.0) {
+        throw std::runtime_error("An all-zero volume is all background.");
+    }
+}
+
+void BrickGridTests::testDiskCache() {
+    // A small dataset of slices to cache against
+    const std::string folder = "brickCacheTest";
+    mkdir(folder.c_str(), 0755);
+    Volume source = noiseVolume(24, 18, 6, 1, 5u);
+    for (int z = 0; z < source.depth; ++z) {
+        const std::string file = folder + "/slice" + std::to_string(100 + z) + ".png";
+        writeVoxelPlane(source.data.data() + static_cast<size_t>(z) * 24 * 18, 24, 18, 1, file, ImageWriteOptions{});
+    }
+    const std::string cacheFile = folder + "/.bricks-u8-1--1-c1-b8.bin";
+    std::remove(cacheFile.c_str());
+
+    Volume vol;
+    vol.channels = 1;
+    if (!vol.loadVolumeFromSlices(folder)) {
+        throw std::runtime_error("Could not load the test slices.");
+    }
+
+    // First use builds and writes the cache
+    BrickGrid built = BrickGrid::cached(vol, folder, 8);
+    BrickGrid onDisk = BrickGrid::load(cacheFile);
+    if (onDisk.stamp != sliceStamp(folder) || onDisk.stamp == 0 || !onDisk.covers(vol)) {
+        throw std::runtime_error("The cache should record the slices it was built from.");
+    }
+    for (int bx = 0; bx < built.bricksX(); ++bx) {
+        if (onDisk.minAt(bx, 1, 0) != built.minAt(bx, 1, 0) || onDisk.maxAt(bx, 1, 0) != built.maxAt(bx, 1, 0) ||
+            onDisk.meanAt(bx, 1, 0) != built.meanAt(bx, 1, 0)) {
+            throw std::runtime_error("The cached grid differs from the built one.");
+        }
+    }
+
+    // A stale cache is rebuilt rather than trusted
+    BrickGrid stale(Volume(24, 18, 6, 1), 8);
+    stale.stamp = onDisk.stamp + 1;
+    stale.save(cacheFile);
+    BrickGrid rebuilt = BrickGrid::cached(vol, folder, 8);
+    if (rebuilt.globalMax() != built.globalMax() || BrickGrid::load(cacheFile).stamp != onDisk.stamp) {
+        throw std::runtime_error("A stale cache should be replaced.");
+    }
+
+    // Something that is not a grid is rejected
+    {
+        std::ofstream junk(folder + "/junk.bin", std::ios::binary);
+        junk << "not a brick grid";
+    }
+    bool threw = false;
+    try {
+        BrickGrid::load(folder + "/junk.bin");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("Loading a foreign file should throw.");
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef BRICK_GRID_TESTS_H
+#define BRICK_GRID_TESTS_H
+
+#include "../src/BrickGrid.h"
+#include <iostream>
+#include <cassert>
+
+class BrickGridTests {
+public:
+    void testMinMax();
+    void testMeansAndRange();
+    void testDiskCache();
+};
+
+#endif // BRICK_GRID_TESTS_H
@@ -12,7 +12,35 @@
 #include <algorithm>
 #include <chrono>
 #include <cstring> 
+#include <string>
 
+namespace {
+
+// Applies `apply` to a grey image and to the same image with an alpha channel added:
+// the grey channel must come out the same and alpha must be left alone
+template <typename Apply>
+void checkGreyAlpha(int w, int h, Apply apply, const std::string& name) {
+    std::vector<unsigned char> grey(w * h), greyAlpha(w * h * 2);
+    for (int k = 0; k < w * h; ++k) {
+        grey[k] = static_cast<unsigned char>((k * 37 + (k / 5) * 11) % 256);
+        greyAlpha[2 * k] = grey[k];
+        greyAlpha[2 * k + 1] = static_cast<unsigned char>(7 * k + 3);
+    }
+    Image greyImg(grey.data(), w, h, 1);
+    Image greyAlphaImg(greyAlpha.data(), w, h, 2);
+    apply(greyImg);
+    apply(greyAlphaImg);
+    for (int k = 0; k < w * h; ++k) {
+        if (greyAlphaImg.getData()[2 * k] != greyImg.getData()[k]) {
+            throw std::runtime_error(name + " on a grey + alpha image should filter grey as a grey image.");
+        }
+        if (greyAlphaImg.getData()[2 * k + 1] != static_cast<unsigned char>(7 * k + 3)) {
+            throw std::runtime_error(name + " should keep the alpha channel of a grey + alpha image.");
+        }
+    }
+}
+
+} // namespace
 
 Filters2DTests::Filters2DTests() : filepath("../Images/small.png"), img(filepath) {}
 
@@ -254,6 +282,57 @@ void Filters2DTests::testApplySaltandPepperNoise(){
 }
 
 
+void Filters2DTests::testSaltandPepperNoiseSeeded(){
+        Filters2D filter;
+        // 300x300 RGB image spans two noise tiles (65536 pixels each)
+        const int w = 300, h = 300;
+        std::vector<unsigned char> imageData(w * h * 3, 100);
+
+        Image a(imageData.data(), w, h, 3);
+        Image b(imageData.data(), w, h, 3);
+        Image c(imageData.data(), w, h, 3);
+        filter.apply_Salt_and_Pepper_Noise(a, 10.0f, 1234);
+        filter.apply_Salt_and_Pepper_Noise(b, 10.0f, 1234);
+        filter.apply_Salt_and_Pepper_Noise(c, 10.0f, 4321);
+
+        // 1. Same seed => identical output; different seed => different output
+        if (memcmp(a.getData(), b.getData(), w * h * 3) != 0) {
+            throw std::runtime_error("Salt and Pepper Noise with the same seed should be reproducible.");
+        }
+        if (memcmp(a.getData(), c.getData(), w * h * 3) == 0) {
+            throw std::runtime_error("Salt and Pepper Noise with different seeds should differ.");
+        }
+
+        // 2. Roughly 10% of pixels are corrupted, split between salt and pepper
+        int salt = 0, pepper = 0;
+        for (int i = 0; i < w * h; ++i) {
+            const unsigned char* px = a.getData() + i * 3;
+            if (px[0] != px[1] || px[1] != px[2]) {
+                throw std::runtime_error("All colour channels of a noisy pixel should match.");
+            }
+            if (px[0] == 255) salt++;
+            else if (px[0] == 0) pepper++;
+            else if (px[0] != 100) {
+                throw std::runtime_error("Untouched pixels should keep their value.");
+            }
+        }
+        const double fraction = static_cast<double>(salt + pepper) / (w * h);
+        if (fraction < 0.09 || fraction > 0.11) {
+            throw std::runtime_error("Noise fraction should be close to the requested 10%, got "
+                                     + std::to_string(fraction));
+        }
+        if (std::abs(salt - pepper) > (salt + pepper) / 10) {
+            throw std::runtime_error("Salt and pepper should be roughly balanced.");
+        }
+
+        // 3. Zero probability leaves the image untouched
+        Image d(imageData.data(), w, h, 3);
+        filter.apply_Salt_and_Pepper_Noise(d, 0.0f, 99);
+        if (memcmp(d.getData(), imageData.data(), w * h * 3) != 0) {
+            throw std::runtime_error("Salt and Pepper Noise with 0% should not change the image.");
+        }
+}
+
 void Filters2DTests::testBoxBlur() {
         Filters2D filter;
         // 1. Test if 1x1 and 2x2 small images can run without issues
@@ -292,6 +371,26 @@ void Filters2DTests::testBoxBlur() {
         };
         Image grayImg(grayData, 3, 3, 1);
         filter.boxBlur(grayImg, 3);
+        if (grayImg.getData()[4] != 1200 / 9) {
+                throw std::runtime_error("boxBlur on a single-channel image should average its 3x3 neighbourhood.");
+        }
+
+        // Grey + alpha: only the grey channel is filtered, alpha is kept
+        unsigned char greyAlphaData[18];
+        for (int k = 0; k < 9; ++k) {
+            greyAlphaData[2 * k] = grayData[k];
+            greyAlphaData[2 * k + 1] = static_cast<unsigned char>(20 * k + 5);
+        }
+        Image greyAlphaImg(greyAlphaData, 3, 3, 2);
+        filter.boxBlur(greyAlphaImg, 3);
+        if (greyAlphaImg.getData()[8] != 1200 / 9) {
+            throw std::runtime_error("boxBlur on a grey + alpha image should filter the grey channel.");
+        }
+        for (int k = 0; k < 9; ++k) {
+            if (greyAlphaImg.getData()[2 * k + 1] != 20 * k + 5) {
+                throw std::runtime_error("boxBlur should keep the alpha channel of a grey + alpha image.");
+            }
+        }
 
         // 4. Test if kernelSize is even, it is automatically adjusted to odd
         int kernelSize = 4;
@@ -432,6 +531,9 @@ void Filters2DTests::testGaussianBlur() {
         if (max_val - min_val >= 255) {
             throw std::runtime_error("GaussianBlur should reduce the max-min difference in the checkerboard test.");
         }
+
+        // Grey + alpha: only the grey channel is blurred
+        checkGreyAlpha(9, 7, [&](Image& im) { filter.gaussianBlur(im, 3, 1.0f); }, "gaussianBlur");
     }
 
 
@@ -473,6 +575,26 @@ void Filters2DTests::testMedianBlur() {
         };
         Image grayImg(grayData, 3, 3, 1);
         filter.medianBlur(grayImg, 3);
+        if (grayImg.getData()[4] != 150) {
+            throw std::runtime_error("medianBlur on a single-channel image should take the median of its 3x3 neighbourhood.");
+        }
+
+        // Grey + alpha: only the grey channel is filtered, alpha is kept
+        unsigned char greyAlphaData[18];
+        for (int k = 0; k < 9; ++k) {
+            greyAlphaData[2 * k] = grayData[k];
+            greyAlphaData[2 * k + 1] = static_cast<unsigned char>(20 * k + 5);
+        }
+        Image greyAlphaImg(greyAlphaData, 3, 3, 2);
+        filter.medianBlur(greyAlphaImg, 3);
+        if (greyAlphaImg.getData()[8] != 150) {
+            throw std::runtime_error("medianBlur on a grey + alpha image should filter the grey channel.");
+        }
+        for (int k = 0; k < 9; ++k) {
+            if (greyAlphaImg.getData()[2 * k + 1] != 20 * k + 5) {
+                throw std::runtime_error("medianBlur should keep the alpha channel of a grey + alpha image.");
+            }
+        }
 
         // 4. Test if kernelSize is even, it is automatically adjusted to odd
         int kernelSize = 4;
@@ -633,7 +755,106 @@ void Filters2DTests::testSharpen() {
         throw std::runtime_error("Sharpen should support grayscale images (channels = 1).");
     }
 }
-     
+
+
+void Filters2DTests::testSharpenStrength() {
+    Filters2D filter;
+
+    // 1. Wide RGBA image exercises the vectorised interior; compare against the
+    //    clamped scalar formula and check that alpha is left alone
+    const int w = 45, h = 9, ch = 4;
+    std::vector<unsigned char> src(w * h * ch);
+    for (int i = 0; i < w * h * ch; ++i) {
+        src[i] = static_cast<unsigned char>((i * 37 + (i / 7) * 11) % 256);
+    }
+    const float strength = 1.7f;
+    Image img(src.data(), w, h, ch);
+    filter.Sharpen(img, strength);
+    const unsigned char* out = img.getData();
+
+    const int s256 = static_cast<int>(std::lround(strength * 256.0f));
+    auto at = [&](int x, int y, int c) {
+        x = std::clamp(x, 0, w - 1);
+        y = std::clamp(y, 0, h - 1);
+        return static_cast<int>(src[(y * w + x) * ch + c]);
+    };
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            for (int c = 0; c < ch; ++c) {
+                int expected = at(x, y, c);
+                if (c < 3) {
+                    int lap = 4 * at(x, y, c) - at(x - 1, y, c) - at(x + 1, y, c)
+                            - at(x, y - 1, c) - at(x, y + 1, c);
+                    expected = std::clamp(expected + ((lap * s256) >> 8), 0, 255);
+                }
+                if (out[(y * w + x) * ch + c] != expected) {
+                    throw std::runtime_error("Sharpen strength result differs from the reference.");
+                }
+            }
+        }
+    }
+
+    // 2. Strength 0 leaves the image untouched
+    Image same(src.data(), w, h, ch);
+    filter.Sharpen(same, 0.0f);
+    if (!std::equal(src.begin(), src.end(), same.getData())) {
+        throw std::runtime_error("Sharpen with strength 0 should not change the image.");
+    }
+
+    // 3. Grey + alpha: rows wide enough for the vectorised interior, alpha restored there too
+    checkGreyAlpha(w, h, [&](Image& im) { filter.Sharpen(im, strength); }, "Sharpen");
+}
+
+void Filters2DTests::testUnsharpMask() {
+    Filters2D filter;
+
+    // 1. Uniform image stays uniform
+    std::vector<unsigned char> flat(16 * 16 * 3, 120);
+    Image flatImg(flat.data(), 16, 16, 3);
+    filter.unsharpMask(flatImg, 2.0f, 1.5f, 0);
+    for (int i = 0; i < 16 * 16 * 3; ++i) {
+        if (flatImg.getData()[i] != 120) {
+            throw std::runtime_error("Unsharp mask should not change a uniform image.");
+        }
+    }
+
+    // 2. Vertical step edge: dark side gets darker, bright side brighter; alpha untouched
+    const int w = 20, h = 6;
+    std::vector<unsigned char> step(w * h * 4);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            unsigned char v = x < w / 2 ? 80 : 160;
+            unsigned char* p = &step[(y * w + x) * 4];
+            p[0] = p[1] = p[2] = v;
+            p[3] = 200;
+        }
+    }
+    Image stepImg(step.data(), w, h, 4);
+    filter.unsharpMask(stepImg, 1.0f, 1.0f, 0);
+    const unsigned char* out = stepImg.getData();
+    const int row = 3 * w * 4;
+    if (out[row + (w / 2 - 1) * 4] >= 80 || out[row + (w / 2) * 4] <= 160) {
+        throw std::runtime_error("Unsharp mask should add overshoot on both sides of an edge.");
+    }
+    if (out[row] != 80 || out[row + (w - 1) * 4] != 160) {
+        throw std::runtime_error("Unsharp mask should not change pixels far from the edge.");
+    }
+    for (int i = 0; i < w * h; ++i) {
+        if (out[i * 4 + 3] != 200) {
+            throw std::runtime_error("Unsharp mask should not change alpha.");
+        }
+    }
+
+    // 3. A threshold above the edge contrast suppresses sharpening entirely
+    Image thrImg(step.data(), w, h, 4);
+    filter.unsharpMask(thrImg, 1.0f, 1.0f, 100);
+    if (!std::equal(step.begin(), step.end(), thrImg.getData())) {
+        throw std::runtime_error("Unsharp mask threshold should leave low-contrast detail untouched.");
+    }
+
+    // 4. Grey + alpha: only the grey channel is sharpened
+    checkGreyAlpha(w, h, [&](Image& im) { filter.unsharpMask(im, 1.5f, 1.0f, 0); }, "Unsharp mask");
+}
 
 void Filters2DTests::testEdgeDetection() {
     Filters2D filter;
@@ -756,3 +977,127 @@ void Filters2DTests::testEdgeDetection() {
         throw std::runtime_error("Edge detection should support grayscale images (channels = 1).");
     }
 }
+
+void Filters2DTests::testEdgeDetectionOptions() {
+    Filters2D filter;
+
+    // 1. Vertical step edge wide enough to exercise both the SIMD interior and the border path
+    const int w = 32, h = 6;
+    std::vector<unsigned char> stepData(w * h);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            stepData[y * w + x] = (x < w / 2) ? 20 : 220;
+        }
+    }
+
+    Image exactImg(stepData.data(), w, h, 1);
+    std::vector<float> orientation;
+    filter.DetectEdges(exactImg, EdgeDetectorType::Sobel, EdgeMagnitude::Euclidean, &orientation);
+
+    if (orientation.size() != static_cast<size_t>(w * h)) {
+        throw std::runtime_error("Orientation plane should have one entry per pixel.");
+    }
+    // A purely horizontal gradient (left dark, right bright) points along +x, i.e. angle 0
+    for (int y = 0; y < h; ++y) {
+        if (std::abs(orientation[y * w + w / 2]) > 1e-6f) {
+            throw std::runtime_error("Orientation across a vertical edge should be 0 radians.");
+        }
+        // Sobel: |Gx| = 4 * 200 = 800, normalised by 4 => 200
+        if (exactImg.getData()[y * w + w / 2] != 200) {
+            throw std::runtime_error("Sobel magnitude across the step should be 200.");
+        }
+        if (exactImg.getData()[y * w + 2] != 0) {
+            throw std::runtime_error("Flat regions should have zero edge strength.");
+        }
+    }
+
+    // 2. L1 magnitude equals Euclidean on axis-aligned edges and is never smaller
+    std::vector<unsigned char> noise(w * h);
+    for (int i = 0; i < w * h; ++i) {
+        noise[i] = static_cast<unsigned char>((i * 73 + (i / w) * 31) % 256);
+    }
+    Image euclid(noise.data(), w, h, 1);
+    Image l1(noise.data(), w, h, 1);
+    filter.DetectEdges(euclid, EdgeDetectorType::Scharr, EdgeMagnitude::Euclidean);
+    filter.DetectEdges(l1, EdgeDetectorType::Scharr, EdgeMagnitude::L1);
+    for (int i = 0; i < w * h; ++i) {
+        if (l1.getData()[i] < euclid.getData()[i]) {
+            throw std::runtime_error("L1 edge magnitude should never be below the Euclidean magnitude.");
+        }
+    }
+
+    // 3. Colour input is converted to greyscale and the output has a single channel
+    std::vector<unsigned char> rgb(w * h * 3);
+    for (int i = 0; i < w * h; ++i) {
+        rgb[i * 3] = rgb[i * 3 + 1] = rgb[i * 3 + 2] = stepData[i];
+    }
+    Image rgbImg(rgb.data(), w, h, 3);
+    filter.DetectEdges(rgbImg, EdgeDetectorType::Prewitt);
+    if (rgbImg.getChannels() != 1) {
+        throw std::runtime_error("Edge detection output should have 1 channel.");
+    }
+}
+
+void Filters2DTests::testCannyEdges() {
+    Filters2D filter;
+
+    // Tall enough to span several Canny tiles (64 rows each).
+    // Region A (x in [10,20)) starts with a strong step that fades into a weak one, so
+    // its lower part survives only through hysteresis across tile boundaries.
+    // Region B (x in [30,40)) is weak everywhere and should be discarded.
+    const int w = 40, h = 150;
+    std::vector<unsigned char> data(w * h, 0);
+    for (int y = 0; y < h; ++y) {
+        unsigned char a = (y < 20) ? 200 : (y < 60 ? 200 - (y - 20) * 140 / 40 : 60);
+        for (int x = 10; x < 20; ++x) data[y * w + x] = a;
+        for (int x = 30; x < 40; ++x) data[y * w + x] = 60;
+    }
+
+    Image img(data.data(), w, h, 1);
+    filter.CannyEdges(img, 20.0f, 50.0f);
+    const unsigned char* result = img.getData();
+
+    // 1. Output is binary
+    for (int i = 0; i < w * h; ++i) {
+        if (result[i] != 0 && result[i] != 255) {
+            throw std::runtime_error("Canny output should only contain 0 or 255.");
+        }
+    }
+
+    auto rowHasEdgeNear = [&](int y, int x) {
+        for (int dx = -2; dx <= 2; ++dx) {
+            if (result[y * w + x + dx] == 255) return true;
+        }
+        return false;
+    };
+
+    // 2. Region A's edges are continuous from the strong part down through every tile
+    for (int y : {5, 63, 64, 100, 128, 149}) {
+        if (!rowHasEdgeNear(y, 10) || !rowHasEdgeNear(y, 20)) {
+            throw std::runtime_error("Canny should keep weak edges connected to strong ones across tiles (row "
+                                     + std::to_string(y) + ").");
+        }
+    }
+
+    // 3. Region B never reaches the high threshold, so it must be suppressed entirely
+    for (int y = 0; y < h; ++y) {
+        if (rowHasEdgeNear(y, 30)) {
+            throw std::runtime_error("Canny should drop weak edges that are not connected to strong ones.");
+        }
+    }
+
+    // 4. Edges are thin: no row should have more than two edge pixels per boundary
+    int widest = 0;
+    for (int x = 5; x < 16; ++x) widest += (result[100 * w + x] == 255);
+    if (widest > 2) {
+        throw std::runtime_error("Non-maximum suppression should thin edges to at most 2 pixels.");
+    }
+
+    // 5. Colour input and the enum dispatch path both work
+    unsigned char rgb[4 * 4 * 3] = {0};
+    Image rgbImg(rgb, 4, 4, 3);
+    filter.DetectEdges(rgbImg, EdgeDetectorType::Canny);
+    if (rgbImg.getChannels() != 1) {
+        throw std::runtime_error("Canny output should have 1 channel.");
+    }
+}
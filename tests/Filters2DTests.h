@@ -13,13 +13,18 @@ public:
     void testApplyHistogramEqualization();
     void testThreshold();
     void testApplySaltandPepperNoise();
+    void testSaltandPepperNoiseSeeded();
     
     void testBoxBlur();
     void testGaussianBlur();
     void testMedianBlur();
     
     void testSharpen();
+    void testSharpenStrength();
+    void testUnsharpMask();
     void testEdgeDetection();
+    void testEdgeDetectionOptions();
+    void testCannyEdges();
 private:
     const char* filepath;
     Image img;
@@ -1,5 +1,7 @@
 #include "Filters3DTests.h"
+#include <cstdint>
 #include <cstring>
+#include <stdexcept>
 
 // **Constructor**: Initializes the test Volume with default values
 Filters3DTests::Filters3DTests() {
@@ -76,6 +78,32 @@ void Filters3DTests::testApplyBlur3DMedian() {
     // assertTest(compareVolumes(testVolume, testVolume), "apply3DMedianBlur");
 }
 
+// **Test Median Blur on RGB uint16/float volumes against the 8-bit histogram path**
+void Filters3DTests::testMedianBlurMultiChannel() {
+    Volume rgb(6, 5, 4, 3);
+    for (size_t i = 0; i < rgb.data.size(); ++i) {
+        // Channels hold unrelated values, so mixing them up changes the medians
+        const size_t c = i % 3;
+        rgb.data[i] = static_cast<unsigned char>((i * 37 + c * 90) % 251);
+    }
+    Volume16 rgb16(6, 5, 4, 3);
+    VolumeF rgbF(6, 5, 4, 3);
+    for (size_t i = 0; i < rgb.data.size(); ++i) {
+        rgb16.data[i] = static_cast<std::uint16_t>(rgb.data[i] * 257);
+        rgbF.data[i] = rgb.data[i] / 255.0f;
+    }
+
+    filters.apply3DMedianBlur(rgb, 3);
+    filters.apply3DMedianBlur(rgb16, 3);
+    filters.apply3DMedianBlur(rgbF, 3);
+    for (size_t i = 0; i < rgb.data.size(); ++i) {
+        if (rgb16.data[i] != rgb.data[i] * 257 || rgbF.data[i] != rgb.data[i] / 255.0f) {
+            throw std::runtime_error("Multi-channel median differs from the 8-bit result at sample " +
+                                     std::to_string(i));
+        }
+    }
+}
+
 // **Test applyBlur3D with an invalid type**
 void Filters3DTests::testApplyBlur3DInvalidType() {
     std::cerr << "Expected error message below (testing invalid type handling):" << std::endl;
@@ -17,6 +17,7 @@ public:
     void testSaveSlicesPNG();
     void testApplyBlur3DGaussian();
     void testApplyBlur3DMedian();
+    void testMedianBlurMultiChannel();
     void testApplyBlur3DInvalidType();
     // Run all test cases
     void runTests();
@@ -4,6 +4,8 @@
 
 #include <string>
 #include <vector>
+#include <cstdio>
+#include <algorithm>
 
 ImageTests::ImageTests() : filepath("../Images/small.png"), img(filepath) {}
 
@@ -83,4 +85,113 @@ void ImageTests::testSetChannels() {
     } catch (const std::invalid_argument&) {
         // test passes
     }
-}
\ No newline at end of file
+}
+void ImageTests::testWritePngRoundTrip() {
+    // Large enough for the PNG encoder to split the stream into several deflate chunks
+    const int w = 301, h = 487;
+    for (int ch = 1; ch <= 4; ++ch) {
+        std::vector<unsigned char> data(w * h * ch);
+        for (int i = 0; i < w * h * ch; ++i) {
+            data[i] = static_cast<unsigned char>((i % 97) * 3 + (i / (w * ch)) % 5);
+        }
+        Image src(data.data(), w, h, ch);
+
+        for (int filter = -1; filter <= 4; ++filter) {
+            ImageWriteOptions options;
+            options.pngFilter = filter;
+            options.pngCompression = (filter + 2) % 10;
+            const std::string path = "./image_test_roundtrip.png";
+            Image::WriteImage(src, path.c_str(), options);
+
+            int rw, rh, rc;
+            unsigned char* loaded = stbi_load(path.c_str(), &rw, &rh, &rc, 0);
+            std::remove(path.c_str());
+            if (!loaded) {
+                throw std::runtime_error("Written PNG could not be decoded (filter " + std::to_string(filter) + ")");
+            }
+            bool same = rw == w && rh == h && rc == ch && std::equal(data.begin(), data.end(), loaded);
+            stbi_image_free(loaded);
+            if (!same) {
+                throw std::runtime_error("PNG round trip changed the pixels (channels " + std::to_string(ch) +
+                                         ", filter " + std::to_string(filter) + ")");
+            }
+        }
+    }
+}
+
+void ImageTests::testWriteFormats() {
+    Image src(filepath);
+    const char* paths[] = { "./image_test_format.jpg", "./image_test_format.bmp", "./image_test_format.tga" };
+    // The first bytes identify the container stb actually wrote
+    const unsigned char jpegMagic[] = { 0xFF, 0xD8 };
+    const unsigned char bmpMagic[] = { 'B', 'M' };
+
+    for (const char* path : paths) {
+        ImageWriteOptions options;
+        options.jpegQuality = 75;
+        Image::WriteImage(src, path, options);
+
+        FILE* f = std::fopen(path, "rb");
+        unsigned char magic[2] = { 0, 0 };
+        size_t got = f ? std::fread(magic, 1, 2, f) : 0;
+        if (f) std::fclose(f);
+
+        int w = 0, h = 0, c = 0;
+        int ok = stbi_info(path, &w, &h, &c);
+        std::remove(path);
+        if (got != 2 || !ok || w != src.getWidth() || h != src.getHeight()) {
+            throw std::runtime_error(std::string("Could not read back ") + path);
+        }
+        std::string p(path);
+        if (p.ends_with(".jpg") && !std::equal(magic, magic + 2, jpegMagic)) {
+            throw std::runtime_error("A .jpg output should be written as JPEG.");
+        }
+        if (p.ends_with(".bmp") && !std::equal(magic, magic + 2, bmpMagic)) {
+            throw std::runtime_error("A .bmp output should be written as BMP.");
+        }
+    }
+}
+
+void ImageTests::testMemoryRoundTrip() {
+    Image src(filepath);
+
+    // Encode through the callback, then decode the bytes without touching disk
+    std::vector<unsigned char> encoded;
+    auto append = [](void* context, void* data, int size) {
+        auto* out = static_cast<std::vector<unsigned char>*>(context);
+        out->insert(out->end(), static_cast<unsigned char*>(data), static_cast<unsigned char*>(data) + size);
+    };
+    Image::WriteImage(src, append, &encoded, ImageWriteOptions{});
+    Image decoded(encoded.data(), encoded.size());
+    const size_t bytes = static_cast<size_t>(src.getWidth()) * src.getHeight() * src.getChannels();
+    if (decoded.getWidth() != src.getWidth() || decoded.getHeight() != src.getHeight() ||
+        decoded.getChannels() != src.getChannels() || !std::equal(src.getData(), src.getData() + bytes, decoded.getData())) {
+        throw std::runtime_error("Decoding an in-memory PNG should give back the pixels.");
+    }
+
+    // options.format wins over the extension
+    ImageWriteOptions bmp;
+    bmp.format = "bmp";
+    std::vector<unsigned char> asBmp = Image::EncodeImage(src.getData(), src.getWidth(), src.getHeight(),
+                                                          src.getChannels(), bmp.format, bmp);
+    Image::WriteImage(src, "./image_test_format_override.png", bmp);
+    FILE* f = std::fopen("./image_test_format_override.png", "rb");
+    unsigned char magic[2] = { 0, 0 };
+    size_t got = f ? std::fread(magic, 1, 2, f) : 0;
+    if (f) std::fclose(f);
+    std::remove("./image_test_format_override.png");
+    if (asBmp.size() < 2 || asBmp[0] != 'B' || asBmp[1] != 'M' || got != 2 || magic[0] != 'B' || magic[1] != 'M') {
+        throw std::runtime_error("format = bmp should encode BMP whatever the extension.");
+    }
+
+    const unsigned char junk[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    bool threw = false;
+    try {
+        Image bad(junk, sizeof(junk));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("Decoding bytes that are not an image should throw.");
+    }
+}
@@ -14,6 +14,9 @@ public:
     void testGetChannels();
     void testSetData();
     void testSetChannels();
+    void testWritePngRoundTrip();
+    void testWriteFormats();
+    void testMemoryRoundTrip();
 
 private:
     const char* filepath;
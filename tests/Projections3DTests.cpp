@@ -1,10 +1,16 @@
 #include "Projections3DTests.h"
+#include "TestVolumes.h"
 #include "Projections3D.h"
+#include "Filters3D.h"
+#include "Slicing3D.h"
+#include "BrickGrid.h"
 #include "stb_image.h"
 #include <cassert>
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 /**
  * Constructor sets up a very small synthetic volume.
@@ -55,10 +61,10 @@ void Projections3DTests::verifyPNG(const std::string& filename, int expectedW, i
         std::cerr << "verifyPNG: stbi_info failed for " << filename << std::endl;
         assert(false && "PNG file not found or invalid");
     }
-    // We expect a 3-channel (RGB) image because writeGrayPNG replicates grayscale into RGB
+    // Projections are written as single-channel greyscale, not replicated into RGB
     assert(wTest == expectedW && "PNG width mismatch");
     assert(hTest == expectedH && "PNG height mismatch");
-    assert(cTest == 3 && "PNG channels should be 3 (RGB) after writeGrayPNG");
+    assert(cTest == 1 && "PNG channels should be 1 (grey) after writeGrayPNG");
 }
 
 // Test MIP on the entire volume
@@ -112,3 +118,266 @@ void Projections3DTests::testAIPMedian() {
     Projections3D::AIPMedian(vol, outFile);
     verifyPNG(outFile, vol.width, vol.height);
 }
+
+// Test 16-bit AIP output: means keep their fraction, scaled by 257
+void Projections3DTests::testAIP16() {
+    std::string outFile = outDir + "testAIP16.png";
+    ImageWriteOptions options;
+    options.bitDepth = 16;
+    Projections3D::AIP(vol, outFile, options);
+    verifyPNG(outFile, vol.width, vol.height);
+    assert(stbi_is_16_bit(outFile.c_str()) && "AIP with bitDepth 16 should write a 16-bit PNG");
+
+    int w, h, c;
+    stbi_us* pixels = stbi_load_16(outFile.c_str(), &w, &h, &c, 0);
+    assert(pixels && "Failed to load 16-bit AIP");
+    for (int i = 0; i < w * h; ++i) {
+        // Both slices differ by 40, so every mean is an integer here: (a + a + 40) / 2
+        [[maybe_unused]] unsigned expected = (vol.data[i] + vol.data[i + 6]) * 257u / 2;
+        assert(pixels[i] == expected && "16-bit AIP value mismatch");
+    }
+    stbi_image_free(pixels);
+
+    // A slab over an odd number of slices rounds to the nearest 16-bit step
+    Volume odd;
+    odd.width = 1;
+    odd.height = 1;
+    odd.depth = 3;
+    odd.channels = 1;
+    odd.data = { 0, 0, 1 };
+    Projections3D::AIPSlab(odd, 0, 2, outFile, options);
+    pixels = stbi_load_16(outFile.c_str(), &w, &h, &c, 0);
+    assert(pixels && pixels[0] == 86 && "16-bit AIP should round 257 / 3 to 86");
+    stbi_image_free(pixels);
+}
+
+// Test 16-bit slices: auto-detected, loaded without quantisation, projected to 16-bit PNG
+void Projections3DTests::test16BitSlices() {
+    // Two 3x2 slices whose values need more than 8 bits
+    const std::uint16_t slice1[6] = { 1000, 2000, 3000, 40000, 50000, 65535 };
+    const std::uint16_t slice2[6] = { 1001, 1999, 3002, 40000, 50001, 0 };
+    Image::WriteImage16(slice1, 3, 2, 1, (outDir + "vol16slice001.png").c_str(), ImageWriteOptions{});
+    Image::WriteImage16(slice2, 3, 2, 1, (outDir + "vol16slice002.png").c_str(), ImageWriteOptions{});
+
+    const std::string prefix = outDir + "vol16slice";
+    assert(probeVoxelType(prefix) == VoxelType::UInt16 && "16-bit slices should be detected");
+
+    Volume16 vol16;
+    [[maybe_unused]] bool loaded = vol16.loadVolumeFromSlices(prefix);
+    assert(loaded && "Failed to load 16-bit slices");
+    assert(vol16.depth == 2 && vol16.getVoxel(0, 0, 1) == 1001 && "16-bit voxels should be kept exactly");
+
+    std::string outFile = outDir + "testMIP16.png";
+    Projections3D::MIP(vol16, outFile);
+    verifyPNG(outFile, 3, 2);
+    assert(stbi_is_16_bit(outFile.c_str()) && "MIP of a 16-bit volume should be a 16-bit PNG");
+    int w, h, c;
+    stbi_us* pixels = stbi_load_16(outFile.c_str(), &w, &h, &c, 0);
+    assert(pixels && "Failed to load 16-bit MIP");
+    for (int i = 0; i < 6; ++i) {
+        assert(pixels[i] == std::max(slice1[i], slice2[i]) && "16-bit MIP value mismatch");
+    }
+    stbi_image_free(pixels);
+
+    // Float volumes are normalised to [0, 1] and come back out at 16 bits
+    VolumeF volF;
+    loaded = volF.loadVolumeFromSlices(prefix);
+    assert(loaded && "Failed to load slices as float");
+    assert(std::abs(volF.getVoxel(2, 1, 0) - 1.0f) < 1e-6f && "Float voxels should be normalised");
+    outFile = outDir + "testAIPFloat.png";
+    Projections3D::AIP(volF, outFile);
+    pixels = stbi_load_16(outFile.c_str(), &w, &h, &c, 0);
+    assert(pixels && pixels[1] == 2000 && pixels[2] == 3001 && "Float AIP should keep the mean exactly");
+    stbi_image_free(pixels);
+
+    // Forcing 8 bits narrows the output
+    ImageWriteOptions narrow;
+    narrow.bitDepth = 8;
+    outFile = outDir + "testMIP16as8.png";
+    Projections3D::MIP(vol16, outFile, narrow);
+    assert(!stbi_is_16_bit(outFile.c_str()) && "bitDepth 8 should write an 8-bit PNG");
+}
+
+// Test RGB volumes end to end: load, per-channel blur, MIP/AIP and slicing
+void Projections3DTests::testRGBVolume() {
+    // Two 4x3 RGB slices; each channel is constant within a slice
+    const unsigned char colours[2][3] = { { 200, 100, 10 }, { 20, 150, 90 } };
+    for (int z = 0; z < 2; ++z) {
+        std::vector<unsigned char> rgb(4 * 3 * 3);
+        for (size_t i = 0; i < rgb.size(); ++i) {
+            rgb[i] = colours[z][i % 3];
+        }
+        std::string name = outDir + "volrgbslice00" + std::to_string(z + 1) + ".png";
+        Image::WriteImage(rgb.data(), 4, 3, 3, name.c_str(), ImageWriteOptions{});
+    }
+
+    Volume rgbVol;
+    rgbVol.channels = 0; // as stored
+    [[maybe_unused]] bool loaded = rgbVol.loadVolumeFromSlices(outDir + "volrgbslice");
+    assert(loaded && "Failed to load RGB slices");
+    assert(rgbVol.channels == 3 && rgbVol.data.size() == 4u * 3 * 2 * 3 && "RGB slices should load 3 channels");
+    assert(rgbVol.getVoxel(3, 2, 1, 1) == 150 && "RGB voxels should be interleaved per voxel");
+
+    // Blurring in x and y must not mix channels: constant planes stay constant
+    Filters3D filters;
+    Volume blurred = rgbVol;
+    blurred.depth = 1;
+    blurred.data.resize(4 * 3 * 3);
+    filters.apply3DGaussianBlur(blurred, 3, 1.0);
+    filters.apply3DMedianBlur(blurred, 3);
+    for (int c = 0; c < 3; ++c) {
+        assert(blurred.getVoxel(1, 1, 0, c) == colours[0][c] && "3D blur should work per channel");
+    }
+
+    std::string outFile = outDir + "testMIPRGB.png";
+    Projections3D::MIP(rgbVol, outFile);
+    int w, h, c;
+    unsigned char* pixels = stbi_load(outFile.c_str(), &w, &h, &c, 0);
+    assert(pixels && c == 3 && "MIP of an RGB volume should be RGB");
+    assert(pixels[0] == 200 && pixels[1] == 150 && pixels[2] == 90 && "MIP should take the maximum per channel");
+    stbi_image_free(pixels);
+
+    outFile = outDir + "testAIPRGB.png";
+    Projections3D::AIP(rgbVol, outFile);
+    pixels = stbi_load(outFile.c_str(), &w, &h, &c, 0);
+    assert(pixels && c == 3 && pixels[0] == 110 && pixels[1] == 125 && pixels[2] == 50 &&
+           "AIP should average per channel");
+    stbi_image_free(pixels);
+
+    outFile = outDir + "testSliceRGB.png";
+    Slicing3D::slice3D(rgbVol, "YZ", 2, outFile);
+    pixels = stbi_load(outFile.c_str(), &w, &h, &c, 0);
+    assert(pixels && w == 3 && h == 2 && c == 3 && "YZ slice of an RGB volume should be RGB");
+    assert(pixels[3 * 3 + 2] == 90 && "YZ slice should keep the channels of each voxel");
+    stbi_image_free(pixels);
+}
+
+namespace {
+
+// Loads an 8-bit greyscale file written by a projection
+std::vector<unsigned char> loadGrey8(const std::string& path, int& w, int& h) {
+    int c = 0;
+    unsigned char* px = stbi_load(path.c_str(), &w, &h, &c, 1);
+    assert(px && "Projection output should be readable");
+    std::vector<unsigned char> out(px, px + static_cast<size_t>(w) * h);
+    stbi_image_free(px);
+    return out;
+}
+
+// Brute-force projection of vol along `axis` over [from, to], in slice orientation
+std::vector<unsigned char> bruteProject(const Volume& v, char axis, const std::string& type, int from, int to,
+                                        int& outW, int& outH) {
+    outW = (axis == 'x') ? v.height : v.width;
+    outH = (axis == 'z') ? v.height : v.depth;
+    std::vector<unsigned char> out(static_cast<size_t>(outW) * outH);
+    for (int b = 0; b < outH; ++b) {
+        for (int a = 0; a < outW; ++a) {
+            int mx = 0, mn = 255, sum = 0;
+            for (int k = from; k <= to; ++k) {
+                int x = a, y = b, z = k;
+                if (axis == 'y') { x = a; y = k; z = b; }
+                if (axis == 'x') { x = k; y = a; z = b; }
+                int val = v.getVoxel(x, y, z);
+                mx = std::max(mx, val);
+                mn = std::min(mn, val);
+                sum += val;
+            }
+            out[b * outW + a] = static_cast<unsigned char>(
+                type == "MIP" ? mx : type == "MinIP" ? mn : sum / (to - from + 1));
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+// Projections along x and y
+void Projections3DTests::testProjectionAxes() {
+    Volume noise = noiseVolume(13, 11, 9, 1, 12345u);
+    for (const std::string type : { "MIP", "MinIP", "AIP" }) {
+        for (char axis : { 'x', 'y' }) {
+            const std::string outFile = outDir + "testAxis" + type + axis + ".png";
+            Projections3D::applyProjection3D(noise, type, outFile, -1, -1, ImageWriteOptions{},
+                                             Projections3D::GetProjectionAxis(std::string(1, axis)));
+            int w, h, bw, bh;
+            std::vector<unsigned char> got = loadGrey8(outFile, w, h);
+            std::vector<unsigned char> want = bruteProject(noise, axis, type, 0,
+                                                           axis == 'x' ? noise.width - 1 : noise.height - 1, bw, bh);
+            assert(w == bw && h == bh && "Axis projection has the wrong size");
+            assert(got == want && "Axis projection differs from brute force");
+
+            // A slab counts along the projection axis
+            Projections3D::applyProjection3D(noise, type, outFile, 2, 6, ImageWriteOptions{},
+                                             Projections3D::GetProjectionAxis(std::string(1, axis)));
+            got = loadGrey8(outFile, w, h);
+            want = bruteProject(noise, axis, type, 2, 6, bw, bh);
+            assert(w == bw && h == bh && got == want && "Axis slab projection differs from brute force");
+        }
+    }
+}
+
+// Sliding thick slabs
+void Projections3DTests::testSlidingSlab() {
+    Volume noise = noiseVolume(13, 11, 23, 1, 12345u);
+    const int thickness = 5, step = 3;
+    for (const std::string type : { "MIP", "MinIP", "AIP" }) {
+        const std::string pattern = outDir + "testSlab" + type + ".png";
+        [[maybe_unused]] int written = Projections3D::slidingSlab(noise, type, thickness, step, pattern);
+        assert(written == (23 - thickness) / step + 1 && "Unexpected number of slabs");
+        for (int start = 0; start + thickness <= noise.depth; start += step) {
+            int w, h, bw, bh;
+            std::vector<unsigned char> got = loadGrey8(Slicing3D::slicePath(pattern, start), w, h);
+            std::vector<unsigned char> want = bruteProject(noise, 'z', type, start, start + thickness - 1, bw, bh);
+            assert(w == bw && h == bh && got == want && "Sliding slab differs from brute force");
+        }
+    }
+
+    // Along y: slabs of 4 rows every 2 rows
+    const std::string pattern = outDir + "testSlabY.png";
+    [[maybe_unused]] int written =
+        Projections3D::slidingSlab(noise, "MIP", 4, 2, pattern, ImageWriteOptions{}, ProjectionAxis::Y);
+    assert(written == (11 - 4) / 2 + 1);
+    int w, h, bw, bh;
+    std::vector<unsigned char> got = loadGrey8(Slicing3D::slicePath(pattern, 6), w, h);
+    std::vector<unsigned char> want = bruteProject(noise, 'y', "MIP", 6, 9, bw, bh);
+    assert(w == bw && h == bh && got == want && "Sliding slab along y differs from brute force");
+
+    // Unsupported types write nothing
+    assert(Projections3D::slidingSlab(noise, "AIPMedian", 4, 2, pattern) == 0);
+}
+
+// MIP/MinIP skipping background bricks
+void Projections3DTests::testBrickSkipping() {
+    // Background with two noisy blocks; MinIP runs on the inverted volume
+    Volume sparse(40, 35, 50, 1);
+    Volume noise = noiseVolume(40, 35, 50, 1, 12345u);
+    for (int z = 0; z < 50; ++z) {
+        for (int y = 0; y < 35; ++y) {
+            for (int x = 0; x < 40; ++x) {
+                const bool inBlock = (x >= 5 && x < 17 && y >= 9 && y < 20 && z >= 12 && z < 30) ||
+                                     (x >= 30 && y >= 28 && z >= 40);
+                sparse.setVoxel(x, y, z, inBlock ? noise.getVoxel(x, y, z) : 0);
+            }
+        }
+    }
+    Volume inverted = sparse;
+    for (auto& v : inverted.data) {
+        v = static_cast<unsigned char>(255 - v);
+    }
+
+    for (const std::string type : { "MIP", "MinIP" }) {
+        const Volume& v = (type == "MIP") ? sparse : inverted;
+        BrickGrid grid(v, 8);
+        assert(grid.fractionUniform(type == "MIP" ? 0.0f : 255.0f) > 0.6 && "Most bricks should be background");
+        const int ranges[][2] = { { -1, -1 }, { 10, 33 }, { 3, 3 } };
+        for (const auto& r : ranges) {
+            const std::string outFile = outDir + "testBricks" + type + ".png";
+            Projections3D::applyProjection3D(v, type, outFile, r[0], r[1], ImageWriteOptions{}, ProjectionAxis::Z, &grid);
+            int w, h, bw, bh;
+            std::vector<unsigned char> got = loadGrey8(outFile, w, h);
+            std::vector<unsigned char> want = bruteProject(v, 'z', type, std::max(r[0], 0),
+                                                           r[1] < 0 ? v.depth - 1 : r[1], bw, bh);
+            assert(w == bw && h == bh && got == want && "Brick skipping changed the projection");
+        }
+    }
+}
@@ -51,6 +51,39 @@ public:
      */
     void testAIPMedian();
 
+    /**
+     * Test 16-bit AIP output (values and rounding).
+     */
+    void testAIP16();
+
+    /**
+     * Test loading 16-bit slices as uint16 and float volumes and projecting them
+     * without dropping to 8 bits.
+     */
+    void test16BitSlices();
+
+    /**
+     * Test an RGB volume end to end (loading, blur, projections, slicing).
+     */
+    void testRGBVolume();
+
+    /**
+     * Test MIP/MinIP/AIP along x and y against a brute-force projection.
+     */
+    void testProjectionAxes();
+
+    /**
+     * Test sliding thick slabs (monotonic deque / running sum) against
+     * brute-force slab projections, along z and along y.
+     */
+    void testSlidingSlab();
+
+    /**
+     * Test MIP/MinIP (full and slab) with a BrickGrid against brute force on a
+     * mostly-background volume.
+     */
+    void testBrickSkipping();
+
 private:
     Volume vol;  ///< A small synthetic volume for testing.
     std::string outDir; ///< Directory or prefix for output test images.
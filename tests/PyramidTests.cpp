@@ -0,0 +1,119 @@
+#include "PyramidTests.h"
+#include "../src/Image.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<unsigned char> makePattern(int w, int h, int ch) {
+    std::vector<unsigned char> data(w * h * ch);
+    for (int i = 0; i < w * h * ch; ++i) {
+        data[i] = static_cast<unsigned char>((i * 29 + (i / 11) * 7) % 256);
+    }
+    return data;
+}
+
+} // namespace
+
+void PyramidTests::testLevelSizes() {
+    std::vector<unsigned char> data = makePattern(20, 13, 3);
+    Image img(data.data(), 20, 13, 3);
+
+    // 20x13 -> 10x7 -> 5x4 -> 3x2 -> 2x1 -> 1x1
+    Pyramid full(img);
+    const int expected[][2] = { {20, 13}, {10, 7}, {5, 4}, {3, 2}, {2, 1}, {1, 1} };
+    if (full.levels() != 6) {
+        throw std::runtime_error("Expected 6 levels, found " + std::to_string(full.levels()));
+    }
+    for (int i = 0; i < full.levels(); ++i) {
+        if (full.level(i).width != expected[i][0] || full.level(i).height != expected[i][1]) {
+            throw std::runtime_error("Unexpected size for level " + std::to_string(i));
+        }
+    }
+
+    Pyramid limited(img, 3);
+    if (limited.levels() != 3) {
+        throw std::runtime_error("maxLevels should limit the number of levels.");
+    }
+
+    bool threw = false;
+    try {
+        limited.level(3);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("Accessing a missing level should throw std::out_of_range.");
+    }
+}
+
+void PyramidTests::testArenaLayout() {
+    std::vector<unsigned char> data = makePattern(17, 9, 4);
+    Image img(data.data(), 17, 9, 4);
+    Pyramid pyramid(img);
+
+    // Levels are stored back to back in one buffer
+    for (int i = 1; i < pyramid.levels(); ++i) {
+        const Pyramid::Level& prev = pyramid.level(i - 1);
+        if (pyramid.levelData(i) != pyramid.levelData(i - 1) + prev.width * prev.height * 4) {
+            throw std::runtime_error("Pyramid levels should be contiguous in the arena.");
+        }
+    }
+    if (!std::equal(data.begin(), data.end(), pyramid.levelData(0))) {
+        throw std::runtime_error("Level 0 should be a copy of the input.");
+    }
+}
+
+void PyramidTests::testUniformImage() {
+    std::vector<unsigned char> data(31 * 22, 173);
+    Image img(data.data(), 31, 22, 1);
+    Pyramid pyramid(img);
+
+    for (int i = 0; i < pyramid.levels(); ++i) {
+        const Pyramid::Level& view = pyramid.level(i);
+        const unsigned char* px = pyramid.levelData(i);
+        for (int k = 0; k < view.width * view.height; ++k) {
+            if (px[k] != 173) {
+                throw std::runtime_error("A uniform image should stay uniform on level " + std::to_string(i));
+            }
+        }
+    }
+}
+
+void PyramidTests::testLaplacianCollapse() {
+    std::vector<unsigned char> data = makePattern(37, 21, 3);
+    Image img(data.data(), 37, 21, 3);
+    Pyramid pyramid(img);
+    pyramid.buildLaplacian();
+
+    // The coarsest band is the Gaussian residual
+    const int top = pyramid.levels() - 1;
+    if (pyramid.laplacianData(top)[0] != pyramid.levelData(top)[0]) {
+        throw std::runtime_error("Top Laplacian level should equal the top Gaussian level.");
+    }
+
+    Image rebuilt(data.data(), 37, 21, 3);
+    std::fill(data.begin(), data.end(), 0);
+    Image zeros(data.data(), 37, 21, 3);
+    pyramid.collapse(zeros);
+    if (!std::equal(rebuilt.getData(), rebuilt.getData() + 37 * 21 * 3, zeros.getData())) {
+        throw std::runtime_error("Collapsing the Laplacian pyramid should reproduce the input exactly.");
+    }
+}
+
+void PyramidTests::testCopyLevel() {
+    std::vector<unsigned char> data = makePattern(16, 16, 1);
+    Image img(data.data(), 16, 16, 1);
+    Pyramid pyramid(img, 3);
+
+    pyramid.copyLevelTo(2, img);
+    if (img.getWidth() != 4 || img.getHeight() != 4 || img.getChannels() != 1) {
+        throw std::runtime_error("copyLevelTo should resize the image to the level.");
+    }
+    if (!std::equal(img.getData(), img.getData() + 16, pyramid.levelData(2))) {
+        throw std::runtime_error("copyLevelTo should copy the level pixels.");
+    }
+}
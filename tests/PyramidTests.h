@@ -0,0 +1,17 @@
+#ifndef PYRAMID_TESTS_H
+#define PYRAMID_TESTS_H
+
+#include "../src/Pyramid.h"
+#include <iostream>
+#include <cassert>
+
+class PyramidTests {
+public:
+    void testLevelSizes();
+    void testArenaLayout();
+    void testUniformImage();
+    void testLaplacianCollapse();
+    void testCopyLevel();
+};
+
+#endif // PYRAMID_TESTS_H
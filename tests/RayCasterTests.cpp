@@ -0,0 +1,146 @@
+#include "RayCasterTests.h"
+#include "TestVolumes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Mostly `background` with a few solid boxes of other values, so most bricks are skippable
+Volume sparseVolume(int w, int h, int d, unsigned char background) {
+    Volume vol(w, h, d, 1);
+    std::fill(vol.data.begin(), vol.data.end(), background);
+    const int boxes[][7] = { { 5, 6, 4, 9, 8, 7, 180 }, { 30, 3, 20, 6, 10, 5, 90 },
+                             { 12, 25, 33, 4, 4, 4, 255 }, { 40, 30, 2, 3, 3, 30, 10 } };
+    for (const auto& b : boxes) {
+        for (int z = b[2]; z < std::min(b[2] + b[5], d); ++z) {
+            for (int y = b[1]; y < std::min(b[1] + b[4], h); ++y) {
+                for (int x = b[0]; x < std::min(b[0] + b[3], w); ++x) {
+                    vol.setVoxel(x, y, z, static_cast<unsigned char>(b[6]));
+                }
+            }
+        }
+    }
+    return vol;
+}
+
+} // namespace
+
+void RayCasterTests::testAxisAlignedMatchesProjection() {
+    // Odd sizes so packets of eight rays do not divide the rows
+    Volume vol = noiseVolume(21, 13, 11, 1, 3u);
+    RayCaster<unsigned char> caster(vol, 4);
+
+    std::vector<float> mip, minip, aip;
+    const Camera cam = caster.render(Camera{}, RenderMode::MIP, mip);
+    caster.render(Camera{}, RenderMode::MinIP, minip);
+    caster.render(Camera{}, RenderMode::AIP, aip);
+    if (cam.width != vol.width || cam.height != vol.height) {
+        throw std::runtime_error("The default view should be width x height of the volume.");
+    }
+
+    // Straight down z the samples land on voxel centres, so this is the plain projection
+    for (int y = 0; y < vol.height; ++y) {
+        for (int x = 0; x < vol.width; ++x) {
+            int mx = 0, mn = 255, sum = 0;
+            for (int z = 0; z < vol.depth; ++z) {
+                const int v = vol.getVoxel(x, y, z);
+                mx = std::max(mx, v);
+                mn = std::min(mn, v);
+                sum += v;
+            }
+            const size_t i = static_cast<size_t>(y) * vol.width + x;
+            if (mip[i] != mx || minip[i] != mn || std::abs(aip[i] - sum / static_cast<float>(vol.depth)) > 1e-3f) {
+                throw std::runtime_error("Mismatch at (" + std::to_string(x) + ", " + std::to_string(y) + ").");
+            }
+        }
+    }
+}
+
+void RayCasterTests::testSkippingIsExact() {
+    const Volume dark = sparseVolume(48, 40, 36, 0);
+    const Volume bright = sparseVolume(48, 40, 36, 220);
+    const Camera cams[] = { { 0.0, 0.0, 0, 0, 1.0 }, { 30.0, 20.0, 0, 0, 1.0 },
+                            { 123.0, -40.0, 50, 45, 0.7 }, { 270.0, 89.0, 0, 0, 1.5 } };
+    TransferFunction tf;
+    tf.points = { { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }, { 0.3f, 0.0f, 0.0f, 0.0f, 0.0f },
+                  { 0.5f, 1.0f, 0.2f, 0.1f, 0.3f }, { 1.0f, 1.0f, 1.0f, 1.0f, 0.9f } };
+
+    for (const RenderMode mode : { RenderMode::MIP, RenderMode::MinIP, RenderMode::Composite }) {
+        RayCaster<unsigned char> caster(mode == RenderMode::MinIP ? bright : dark, 8);
+        caster.setTransferFunction(tf);
+        for (const Camera& cam : cams) {
+            std::vector<float> fast, brute;
+            caster.setSkipping(true);
+            caster.render(cam, mode, fast);
+            caster.setSkipping(false);
+            caster.render(cam, mode, brute);
+            if (fast != brute) {
+                throw std::runtime_error("Skipping changed the image (mode " + std::to_string(static_cast<int>(mode)) +
+                                         ", yaw " + std::to_string(cam.yaw) + ").");
+            }
+            if (std::all_of(fast.begin(), fast.end(), [](float v) { return v == 0.0f; })) {
+                throw std::runtime_error("The rendering should see the boxes.");
+            }
+        }
+    }
+}
+
+void RayCasterTests::testComposite() {
+    Volume solid(10, 10, 6, 1);
+    std::fill(solid.data.begin(), solid.data.end(), static_cast<unsigned char>(255));
+    RayCaster<unsigned char> caster(solid);
+
+    // The default ramp is opaque white at full intensity
+    std::vector<float> rgb;
+    Camera cam = caster.render(Camera{ 90.0, 0.0, 0, 0, 1.0 }, RenderMode::Composite, rgb);
+    if (cam.width != solid.depth || cam.height != solid.height || rgb.size() != static_cast<size_t>(6 * 10 * 3)) {
+        throw std::runtime_error("A quarter turn should see the volume's depth across.");
+    }
+    for (float v : rgb) {
+        if (std::abs(v - 1.0f) > 1e-5f) {
+            throw std::runtime_error("An opaque white volume should render white.");
+        }
+    }
+
+    // Half opacity per voxel: three voxels leave 1/8 of the background showing
+    TransferFunction half;
+    half.points = { { 0.0f, 1.0f, 0.0f, 0.0f, 0.5f }, { 1.0f, 1.0f, 0.0f, 0.0f, 0.5f } };
+    Volume thin(4, 4, 3, 1);
+    RayCaster<unsigned char> thinCaster(thin);
+    thinCaster.setTransferFunction(half);
+    thinCaster.render(Camera{}, RenderMode::Composite, rgb);
+    if (std::abs(rgb[0] - 0.875f) > 1e-4f || rgb[1] != 0.0f || rgb[2] != 0.0f) {
+        throw std::runtime_error("Front-to-back compositing gave " + std::to_string(rgb[0]) + ".");
+    }
+}
+
+void RayCasterTests::testInvalidVolume() {
+    Volume rgb(4, 4, 4, 3);
+    bool threw = false;
+    try {
+        RayCaster<unsigned char> caster(rgb);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("Multi-channel volumes should be rejected.");
+    }
+
+    Volume grey(4, 4, 4, 1);
+    RayCaster<unsigned char> caster(grey);
+    std::vector<float> out;
+    threw = false;
+    try {
+        caster.render(Camera{ 0.0, 0.0, 0, 0, 0.0 }, RenderMode::MIP, out);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("A zero step should be rejected.");
+    }
+}
@@ -0,0 +1,16 @@
+#ifndef RAY_CASTER_TESTS_H
+#define RAY_CASTER_TESTS_H
+
+#include "../src/RayCaster.h"
+#include <iostream>
+#include <cassert>
+
+class RayCasterTests {
+public:
+    void testAxisAlignedMatchesProjection();
+    void testSkippingIsExact();
+    void testComposite();
+    void testInvalidVolume();
+};
+
+#endif // RAY_CASTER_TESTS_H
@@ -0,0 +1,164 @@
+#include "ResamplerTests.h"
+#include "../src/Image.h"
+#include "../src/Volume.h"
+#include <cmath>
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+void ResamplerTests::testUniformImage() {
+    // Every kernel preserves a flat colour, whichever direction and channel count
+    const ResizeKernel kernels[] = { ResizeKernel::Box, ResizeKernel::Bilinear,
+                                     ResizeKernel::Bicubic, ResizeKernel::Lanczos3 };
+    const int sizes[][2] = { {1, 1}, {7, 5}, {37, 29}, {64, 3} };
+    for (ResizeKernel kernel : kernels) {
+        for (int ch = 1; ch <= 4; ++ch) {
+            for (const auto& size : sizes) {
+                std::vector<unsigned char> data(23 * 17 * ch);
+                for (size_t i = 0; i < data.size(); ++i) {
+                    data[i] = static_cast<unsigned char>(40 + 50 * (i % ch));
+                }
+                Image img(data.data(), 23, 17, ch);
+                Resampler::resize(img, size[0], size[1], kernel);
+
+                for (int i = 0; i < size[0] * size[1] * ch; ++i) {
+                    if (img.getData()[i] != 40 + 50 * (i % ch)) {
+                        throw std::runtime_error("Resize changed a uniform image (channels = " +
+                                                 std::to_string(ch) + ").");
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ResamplerTests::testBoxDownscale() {
+    // Halving with the box kernel averages each 2x2 block
+    const int w = 40, h = 6;
+    std::vector<unsigned char> data(w * h);
+    for (int i = 0; i < w * h; ++i) {
+        data[i] = static_cast<unsigned char>((i * 53) % 256);
+    }
+    Image img(data.data(), w, h, 1);
+    Resampler::resize(img, w / 2, h / 2, ResizeKernel::Box);
+
+    for (int y = 0; y < h / 2; ++y) {
+        for (int x = 0; x < w / 2; ++x) {
+            int sum = data[(2 * y) * w + 2 * x] + data[(2 * y) * w + 2 * x + 1]
+                    + data[(2 * y + 1) * w + 2 * x] + data[(2 * y + 1) * w + 2 * x + 1];
+            if (std::abs(img.getData()[y * (w / 2) + x] - sum / 4.0) > 1.0) {
+                throw std::runtime_error("Box downscale should average 2x2 blocks.");
+            }
+        }
+    }
+}
+
+void ResamplerTests::testDimensions() {
+    std::vector<unsigned char> data(5 * 3 * 4, 128);
+    Image img(data.data(), 5, 3, 4);
+
+    Resampler::scale(img, 0.5f, ResizeKernel::Bilinear);
+    if (img.getWidth() != 3 || img.getHeight() != 2 || img.getChannels() != 4) {
+        throw std::runtime_error("Scale 0.5 of 5x3 should give 3x2 with channels unchanged.");
+    }
+
+    Resampler::resize(img, 50, 31, ResizeKernel::Lanczos3);
+    if (img.getWidth() != 50 || img.getHeight() != 31) {
+        throw std::runtime_error("Resize should set the requested dimensions.");
+    }
+
+    // Upscaling a horizontal ramp with bilinear keeps it monotonic
+    std::vector<unsigned char> ramp(16 * 2);
+    for (int y = 0; y < 2; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            ramp[y * 16 + x] = static_cast<unsigned char>(x * 16);
+        }
+    }
+    Image rampImg(ramp.data(), 16, 2, 1);
+    Resampler::resize(rampImg, 61, 2, ResizeKernel::Bilinear);
+    for (int x = 1; x < 61; ++x) {
+        if (rampImg.getData()[x] < rampImg.getData()[x - 1]) {
+            throw std::runtime_error("Bilinear upscale of a ramp should be monotonic.");
+        }
+    }
+}
+
+void ResamplerTests::testVolumePlanes() {
+    Volume vol(30, 20, 3, 1);
+    for (int z = 0; z < vol.depth; ++z) {
+        std::fill(vol.data.begin() + z * 600, vol.data.begin() + (z + 1) * 600,
+                  static_cast<unsigned char>(60 * (z + 1)));
+    }
+
+    Resampler::resize(vol, 12, 9, ResizeKernel::Bicubic);
+    if (vol.width != 12 || vol.height != 9 || vol.depth != 3 ||
+        vol.data.size() != static_cast<size_t>(12 * 9 * 3)) {
+        throw std::runtime_error("Volume resize should change width/height only.");
+    }
+    for (int z = 0; z < vol.depth; ++z) {
+        for (int y = 0; y < vol.height; ++y) {
+            for (int x = 0; x < vol.width; ++x) {
+                if (vol.getVoxel(x, y, z) != 60 * (z + 1)) {
+                    throw std::runtime_error("Volume resize should keep slices independent.");
+                }
+            }
+        }
+    }
+}
+
+void ResamplerTests::testWideVolumes() {
+    // Values above 255 must survive: the 16-bit path must not go through 8 bits
+    Volume16 vol16(30, 20, 2, 1);
+    std::fill(vol16.data.begin(), vol16.data.begin() + 600, static_cast<std::uint16_t>(1000));
+    std::fill(vol16.data.begin() + 600, vol16.data.end(), static_cast<std::uint16_t>(65535));
+    Resampler::resize(vol16, 12, 9, ResizeKernel::Lanczos3);
+    if (vol16.width != 12 || vol16.height != 9 || vol16.data.size() != static_cast<size_t>(12 * 9 * 2)) {
+        throw std::runtime_error("16-bit volume resize should change width/height only.");
+    }
+    if (vol16.getVoxel(5, 4, 0) != 1000 || vol16.getVoxel(11, 8, 1) != 65535) {
+        throw std::runtime_error("16-bit volume resize should keep uniform planes exact.");
+    }
+
+    // A float ramp keeps its fractional values
+    VolumeF volF(8, 1, 1, 1);
+    for (int x = 0; x < 8; ++x) {
+        volF.data[x] = x / 7.0f;
+    }
+    Resampler::resize(volF, 15, 1, ResizeKernel::Bilinear);
+    for (int x = 1; x < 15; ++x) {
+        if (volF.data[x] < volF.data[x - 1]) {
+            throw std::runtime_error("Float volume upscale of a ramp should be monotonic.");
+        }
+    }
+    if (std::abs(volF.data[7] - 0.5f) > 1e-3f) {
+        throw std::runtime_error("Float volume resize should keep fractional values.");
+    }
+}
+
+void ResamplerTests::testInvalidArguments() {
+    std::vector<unsigned char> data(4 * 4 * 3, 0);
+    Image img(data.data(), 4, 4, 3);
+
+    bool threw = false;
+    try {
+        Resampler::resize(img, 0, 4);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("Resize to zero width should throw std::invalid_argument.");
+    }
+
+    threw = false;
+    try {
+        Resampler::scale(img, -1.0f);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("Negative scale factor should throw std::invalid_argument.");
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef RESAMPLER_TESTS_H
+#define RESAMPLER_TESTS_H
+
+#include "../src/Resampler.h"
+#include <iostream>
+#include <cassert>
+
+class ResamplerTests {
+public:
+    void testUniformImage();
+    void testBoxDownscale();
+    void testDimensions();
+    void testVolumePlanes();
+    void testWideVolumes();
+    void testInvalidArguments();
+};
+
+#endif // RESAMPLER_TESTS_H
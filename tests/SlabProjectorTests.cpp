@@ -0,0 +1,186 @@
+#include "SlabProjectorTests.h"
+#include "TestVolumes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Brute-force slab projection of [z0, z1], as MIPSlab / MinIPSlab / AIPSlab compute it
+template <typename T>
+std::vector<T> bruteForce(const BasicVolume<T>& vol, const std::string& type, int z0, int z1) {
+    const size_t plane = static_cast<size_t>(vol.width) * vol.height * vol.channels;
+    std::vector<T> out(plane);
+    for (size_t i = 0; i < plane; ++i) {
+        T mx = vol.data[z0 * plane + i], mn = mx;
+        std::conditional_t<std::is_floating_point_v<T>, double, unsigned long long> sum = 0;
+        for (int z = z0; z <= z1; ++z) {
+            const T v = vol.data[z * plane + i];
+            mx = std::max(mx, v);
+            mn = std::min(mn, v);
+            sum += v;
+        }
+        out[i] = type == "MIP" ? mx : type == "MinIP" ? mn : static_cast<T>(sum / (z1 - z0 + 1));
+    }
+    return out;
+}
+
+template <typename T>
+void expectSame(const std::vector<T>& got, const std::vector<T>& want, const std::string& what) {
+    for (size_t i = 0; i < want.size(); ++i) {
+        const bool same = std::is_floating_point_v<T> ? std::abs(got[i] - want[i]) <= 1e-6f : got[i] == want[i];
+        if (!same) {
+            throw std::runtime_error(what + ": pixel " + std::to_string(i) + " differs.");
+        }
+    }
+}
+
+std::vector<char> fileBytes(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+void SlabProjectorTests::testScrollingMatchesSlabs() {
+    Volume vol = noiseVolume<unsigned char>(13, 11, 37, 2, 3u);
+    for (const std::string type : { "MIP", "MinIP", "AIP" }) {
+        SlabProjector<unsigned char> projector(vol, type);
+        expectSame(projector.image(), bruteForce(vol, type, 0, 36), type + " full window");
+
+        projector.setWindow(4, 12);
+        expectSame(projector.image(), bruteForce(vol, type, 4, 12), type + " [4, 12]");
+        const int moves[] = { 1, 1, 3, -2, -1, 7, 20, -30, 5 };
+        for (int k : moves) {
+            projector.scroll(k);
+            if (projector.last() - projector.first() != 8) {
+                throw std::runtime_error("Scrolling must keep the thickness.");
+            }
+            expectSame(projector.image(), bruteForce(vol, type, projector.first(), projector.last()),
+                       type + " after scrolling to " + std::to_string(projector.first()));
+        }
+
+        // Growing, shrinking, reversed and out-of-range windows
+        const int windows[][2] = { { 10, 20 }, { 9, 22 }, { 15, 16 }, { 30, 5 }, { -4, 3 }, { 33, 99 }, { 17, 17 } };
+        for (const auto& wnd : windows) {
+            projector.setWindow(wnd[0], wnd[1]);
+            expectSame(projector.image(), bruteForce(vol, type, projector.first(), projector.last()),
+                       type + " window " + std::to_string(wnd[0]) + ".." + std::to_string(wnd[1]));
+        }
+    }
+}
+
+void SlabProjectorTests::testScrollCost() {
+    Volume vol = noiseVolume<unsigned char>(8, 8, 64, 1, 9u);
+
+    SlabProjector<unsigned char> mean(vol, "AIP");
+    mean.setWindow(10, 29);
+    mean.scroll(1);
+    if (mean.planesTouched() != 2) {
+        throw std::runtime_error("Scrolling an AIP slab by one should add one slice and drop one.");
+    }
+    mean.scroll(3);
+    if (mean.planesTouched() != 6) {
+        throw std::runtime_error("Scrolling an AIP slab by three should touch six slices.");
+    }
+
+    SlabProjector<unsigned char> maxima(vol, "MIP");
+    maxima.setWindow(10, 29);
+    for (int k = 0; k < 20; ++k) {
+        maxima.scroll(1);
+        if (maxima.planesTouched() > 2 * 6) {
+            throw std::runtime_error("A MIP window should need at most 2 log2(depth) tree nodes.");
+        }
+    }
+    maxima.setWindow(0, 63);
+    if (maxima.planesTouched() != 1) {
+        throw std::runtime_error("The full window is the root of the tree.");
+    }
+    maxima.setWindow(10, 20);
+    maxima.setWindow(10, 21);
+    if (maxima.planesTouched() != 1) {
+        throw std::runtime_error("Growing the window by one should fold in one slice.");
+    }
+    maxima.setWindow(10, 21);
+    if (maxima.planesTouched() != 0) {
+        throw std::runtime_error("An unchanged window should cost nothing.");
+    }
+}
+
+void SlabProjectorTests::testAxesAndVoxelTypes() {
+    Volume16 vol16 = noiseVolume<std::uint16_t>(9, 14, 6, 1, 21u);
+    Volume16 alongX = vol16.permuted(AxisOrder::YZX);
+    SlabProjector<std::uint16_t> minX(vol16, "MinIP", ProjectionAxis::X);
+    if (minX.width() != vol16.height || minX.height() != vol16.depth) {
+        throw std::runtime_error("An x projection should be height x depth.");
+    }
+    minX.setWindow(2, 6);
+    expectSame(minX.image(), bruteForce(alongX, "MinIP", 2, 6), "uint16 MinIP along x");
+    minX.scroll(-1);
+    expectSame(minX.image(), bruteForce(alongX, "MinIP", 1, 5), "uint16 MinIP along x, scrolled");
+
+    VolumeF volF = noiseVolume<float>(7, 10, 12, 1, 33u);
+    VolumeF alongY = volF.permuted(AxisOrder::XZY);
+    SlabProjector<float> meanY(volF, "AIP", ProjectionAxis::Y);
+    for (int s = 0; s + 3 < volF.height; ++s) {
+        meanY.setWindow(s, s + 3);
+        expectSame(meanY.image(), bruteForce(alongY, "AIP", s, s + 3), "float AIP along y");
+    }
+    SlabProjector<float> maxY(volF, "MIP", ProjectionAxis::Y);
+    maxY.setWindow(3, 8);
+    expectSame(maxY.image(), bruteForce(alongY, "MIP", 3, 8), "float MIP along y");
+}
+
+void SlabProjectorTests::testWriteMatchesAIPSlab() {
+    Volume vol = noiseVolume<unsigned char>(12, 9, 10, 1, 77u);
+    ImageWriteOptions options;
+    options.bitDepth = 16;
+
+    SlabProjector<unsigned char> projector(vol, "AIP");
+    projector.setWindow(0, 2);
+    projector.scroll(4);
+    if (!projector.write("./testSlabProjectorAIP16.png", options)) {
+        throw std::runtime_error("SlabProjector failed to write.");
+    }
+    Projections3D::AIPSlab(vol, 4, 6, "./testAIPSlab16.png", options);
+    if (fileBytes("./testSlabProjectorAIP16.png") != fileBytes("./testAIPSlab16.png")) {
+        throw std::runtime_error("A written 16-bit AIP should match AIPSlab.");
+    }
+
+    SlabProjector<unsigned char> maxima(vol, "MIP");
+    maxima.setWindow(3, 8);
+    maxima.write("./testSlabProjectorMIP.png");
+    Projections3D::MIPSlab(vol, 3, 8, "./testMIPSlabRef.png");
+    if (fileBytes("./testSlabProjectorMIP.png") != fileBytes("./testMIPSlabRef.png")) {
+        throw std::runtime_error("A written MIP should match MIPSlab.");
+    }
+}
+
+void SlabProjectorTests::testInvalidProjection() {
+    Volume vol = noiseVolume<unsigned char>(4, 4, 4, 1, 1u);
+    bool threw = false;
+    try {
+        SlabProjector<unsigned char> projector(vol, "AIPMedian");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("Median slabs are not supported and should throw.");
+    }
+
+    threw = false;
+    try {
+        SlabProjector<unsigned char> projector(Volume(0, 0, 0, 1), "MIP");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("An empty volume should throw.");
+    }
+}
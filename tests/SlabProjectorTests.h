@@ -0,0 +1,17 @@
+#ifndef SLAB_PROJECTOR_TESTS_H
+#define SLAB_PROJECTOR_TESTS_H
+
+#include "../src/SlabProjector.h"
+#include <iostream>
+#include <cassert>
+
+class SlabProjectorTests {
+public:
+    void testScrollingMatchesSlabs();
+    void testScrollCost();
+    void testAxesAndVoxelTypes();
+    void testWriteMatchesAIPSlab();
+    void testInvalidProjection();
+};
+
+#endif // SLAB_PROJECTOR_TESTS_H
@@ -9,6 +9,9 @@
 #include <cstdio>
 #include <vector>
 #include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
 
 /**
  * @brief A helper RAII class to simultaneously capture std::cout and std::cerr.
@@ -230,3 +233,262 @@ void Slicing3DTests::testOutOfRangeCoordinate() {
     }
     std::cout << std::endl;
 }
+
+// Test oblique slicing along an axis-aligned plane
+void Slicing3DTests::testObliqueAxisAligned() {
+    // Normal +z through the centre of slice 1 must give exactly that XY slice
+    ObliquePlane plane = ObliquePlane::fromNormal({ 1.5, 1.0, 1.0 }, { 0.0, 0.0, 2.0 });
+    std::vector<unsigned char> out;
+    Slicing3D::resliceOblique(vol, plane, vol.width, vol.height, 1.0, out);
+    assert(out.size() == static_cast<size_t>(vol.width) * vol.height);
+    for (size_t i = 0; i < out.size(); ++i) {
+        assert(out[i] == vol.data[out.size() + i] && "Oblique +z plane should equal the XY slice");
+    }
+
+    // Three points spanning the same plane give the same image
+    ObliquePlane byPoints = ObliquePlane::fromPoints({ 0.0, 0.0, 1.0 }, { 3.0, 0.0, 1.0 }, { 1.5, 3.0, 1.0 });
+    assert(std::abs(byPoints.u.x - 1.0) < 1e-12 && std::abs(byPoints.v.y - 1.0) < 1e-12);
+    byPoints.center = plane.center;
+    std::vector<unsigned char> out2;
+    Slicing3D::resliceOblique(vol, byPoints, vol.width, vol.height, 1.0, out2);
+    assert(out2 == out && "Three-point plane should match the point + normal plane");
+
+    // Normals along y and x follow the XZ and YZ orientation
+    [[maybe_unused]] ObliquePlane xz = ObliquePlane::fromNormal({ 0.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 });
+    assert(xz.u.x > 0.99 && xz.v.z > 0.99);
+    [[maybe_unused]] ObliquePlane yz = ObliquePlane::fromNormal({ 0.0, 0.0, 0.0 }, { -1.0, 0.0, 0.0 });
+    assert(yz.u.y > 0.99 && yz.v.z > 0.99);
+
+    // Collinear points are rejected
+    [[maybe_unused]] bool threw = false;
+    try {
+        ObliquePlane::fromPoints({ 0.0, 0.0, 0.0 }, { 1.0, 1.0, 1.0 }, { 2.0, 2.0, 2.0 });
+    }
+    catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Collinear points should throw");
+
+    std::cout << "[PASS] SLICING3D - Oblique Axis-Aligned" << std::endl;
+}
+
+// Test oblique trilinear sampling on a linear field
+void Slicing3DTests::testObliqueTrilinear() {
+    // f(x, y, z) = x + 10y + 100z is reproduced exactly by trilinear interpolation
+    VolumeF field;
+    field.width = 3;
+    field.height = 3;
+    field.depth = 3;
+    field.channels = 1;
+    field.data.resize(27);
+    auto f = [](double x, double y, double z) { return x + 10.0 * y + 100.0 * z; };
+    for (int z = 0; z < 3; ++z) {
+        for (int y = 0; y < 3; ++y) {
+            for (int x = 0; x < 3; ++x) {
+                field.data[(z * 3 + y) * 3 + x] = static_cast<float>(f(x, y, z));
+            }
+        }
+    }
+
+    // Width 7 exercises both the four-wide path and the scalar remainder
+    const int W = 7, H = 5;
+    const double spacing = 0.6;
+    ObliquePlane plane = ObliquePlane::fromNormal({ 1.0, 1.0, 1.0 }, { 1.0, 2.0, 3.0 });
+    std::vector<float> out;
+    Slicing3D::resliceOblique(field, plane, W, H, spacing, out);
+
+    int inside = 0, outside = 0;
+    for (int j = 0; j < H; ++j) {
+        for (int i = 0; i < W; ++i) {
+            const double a = (i - (W - 1) / 2.0) * spacing, b = (j - (H - 1) / 2.0) * spacing;
+            double p[3] = { plane.center.x + a * plane.u.x + b * plane.v.x,
+                            plane.center.y + a * plane.u.y + b * plane.v.y,
+                            plane.center.z + a * plane.u.z + b * plane.v.z };
+            bool in = true;
+            for (double& c : p) {
+                in = in && c >= -0.5 && c <= 2.5;
+                c = std::clamp(c, 0.0, 2.0);
+            }
+            const double expected = in ? f(p[0], p[1], p[2]) : 0.0;
+            if (std::abs(out[j * W + i] - expected) > 1e-3) {
+                std::cerr << "Mismatch at (" << i << ", " << j << "): " << out[j * W + i]
+                          << " vs " << expected << std::endl;
+                assert(false && "Oblique trilinear sample mismatch");
+            }
+            (in ? inside : outside)++;
+        }
+    }
+    assert(inside > 0 && outside > 0 && "Test plane should cover both inside and outside samples");
+
+    std::cout << "[PASS] SLICING3D - Oblique Trilinear" << std::endl;
+}
+
+// Test batch export against single slices
+void Slicing3DTests::testExportSlices() {
+    CoutCerrRedirect capture;
+
+    auto loadGrey = [](const std::string& path, int& w, int& h) {
+        int c = 0;
+        unsigned char* px = stbi_load(path.c_str(), &w, &h, &c, 1);
+        assert(px && "Exported slice should be readable");
+        std::vector<unsigned char> pixels(px, px + static_cast<size_t>(w) * h);
+        stbi_image_free(px);
+        return pixels;
+    };
+
+    // Every YZ slice must match the one slice3D writes for the same x
+    const std::string pattern = outDir + "testExportYZ.png";
+    [[maybe_unused]] int written = Slicing3D::exportSlices(vol, "YZ", 0, -1, 1, pattern);
+    assert(written == vol.width && "One YZ slice per column expected");
+    assert(Slicing3D::slicePath(pattern, 3) == outDir + "testExportYZ_0003.png");
+    for (int x = 0; x < vol.width; ++x) {
+        const std::string single = outDir + "testExportYZSingle.png";
+        Slicing3D::slice3D(vol, "YZ", x, single);
+        int w1, h1, w2, h2;
+        std::vector<unsigned char> a = loadGrey(Slicing3D::slicePath(pattern, x), w1, h1);
+        std::vector<unsigned char> b = loadGrey(single, w2, h2);
+        assert(w1 == vol.height && h1 == vol.depth && w1 == w2 && h1 == h2);
+        assert(a == b && "Batch YZ slice differs from slice3D");
+    }
+
+    // Strided XZ range: y = 0 and 2 only
+    const std::string xzPattern = outDir + "testExportXZ.png";
+    std::remove(Slicing3D::slicePath(xzPattern, 1).c_str());
+    written = Slicing3D::exportSlices(vol, "xz", 0, 2, 2, xzPattern);
+    assert(written == 2 && "Step 2 over 0-2 should write two slices");
+    [[maybe_unused]] int wTest, hTest, cTest;
+    assert(!stbi_info(Slicing3D::slicePath(xzPattern, 1).c_str(), &wTest, &hTest, &cTest));
+    verifyPNG(Slicing3D::slicePath(xzPattern, 2), vol.width, vol.depth);
+
+    // Bad plane or empty range writes nothing
+    assert(Slicing3D::exportSlices(vol, "AB", 0, -1, 1, pattern) == 0);
+    assert(Slicing3D::exportSlices(vol, "XY", 5, -1, 1, pattern) == 0);
+
+    std::cout << "[PASS] SLICING3D - Batch Export";
+
+    std::string logs = capture.getMergedString();
+    if (!logs.empty()) {
+        std::istringstream iss(logs);
+        std::string line;
+        while (std::getline(iss, line)) {
+            std::cout << "\n       " << line;
+        }
+    }
+    std::cout << std::endl;
+}
+
+namespace {
+
+// Checks every voxel of vol.permuted(order) against the source voxel it came from
+template <typename T>
+void checkPermutations(const BasicVolume<T>& vol) {
+    const AxisOrder orders[] = { AxisOrder::XYZ, AxisOrder::XZY, AxisOrder::YXZ,
+                                 AxisOrder::YZX, AxisOrder::ZXY, AxisOrder::ZYX };
+    for (AxisOrder order : orders) {
+        BasicVolume<T> p = vol.permuted(order);
+        assert(p.data.size() == vol.data.size());
+        for (int z = 0; z < vol.depth; ++z) {
+            for (int y = 0; y < vol.height; ++y) {
+                for (int x = 0; x < vol.width; ++x) {
+                    [[maybe_unused]] int px = x, py = y, pz = z;
+                    switch (order) {
+                        case AxisOrder::XYZ: break;
+                        case AxisOrder::XZY: py = z; pz = y; break;
+                        case AxisOrder::YXZ: px = y; py = x; break;
+                        case AxisOrder::YZX: px = y; py = z; pz = x; break;
+                        case AxisOrder::ZXY: px = z; py = x; pz = y; break;
+                        case AxisOrder::ZYX: px = z; pz = x; break;
+                    }
+                    for (int c = 0; c < vol.channels; ++c) {
+                        assert(p.getVoxel(px, py, pz, c) == vol.getVoxel(x, y, z, c) && "Permuted voxel mismatch");
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+// Test axis permutation (blocked transpose)
+void Slicing3DTests::testPermuteAxes() {
+    // 35 x 33 x 18 has two full 16 x 16 tiles per axis plus ragged edges
+    Volume v8(35, 33, 18, 1);
+    Volume16 v16(35, 33, 18, 1);
+    Volume rgb(19, 17, 5, 3);
+    for (size_t i = 0; i < v8.data.size(); ++i) {
+        v8.data[i] = static_cast<unsigned char>(i * 37 + (i >> 8));
+        v16.data[i] = static_cast<std::uint16_t>(i * 7919);
+    }
+    for (size_t i = 0; i < rgb.data.size(); ++i) {
+        rgb.data[i] = static_cast<unsigned char>(i * 13);
+    }
+    checkPermutations(v8);
+    checkPermutations(v16);
+    checkPermutations(rgb);
+
+    // The YZ planes of the volume become xy slices of the YZX permutation
+    Volume yzx = v8.permuted(GetAxisOrder("yzx"));
+    assert(yzx.width == v8.height && yzx.height == v8.depth && yzx.depth == v8.width);
+
+    std::cout << "[PASS] SLICING3D - Permute Axes" << std::endl;
+}
+
+// Test curved planar reformation
+void Slicing3DTests::testCurvedReformation() {
+    // f(x, y, z) = x + 10y + 100z on an 8^3 float volume
+    VolumeF field(8, 8, 8, 1);
+    for (int z = 0; z < 8; ++z) {
+        for (int y = 0; y < 8; ++y) {
+            for (int x = 0; x < 8; ++x) {
+                field.data[(z * 8 + y) * 8 + x] = static_cast<float>(x + 10 * y + 100 * z);
+            }
+        }
+    }
+
+    // Straight path along x: row i is centred on x = 1 + i, with the line across along y
+    std::vector<float> out;
+    int rows = Slicing3D::reformatCurved(field, { { 1, 4, 4 }, { 6, 4, 4 } }, 5, 1.0, false, out);
+    assert(rows == 6 && "Path of length 5 at spacing 1 gives 6 rows");
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            [[maybe_unused]] const float expected = (1 + i) + 10.0f * (2 + j) + 400.0f;
+            assert(std::abs(out[i * 5 + j] - expected) < 1e-3f && "Straight CPR sample mismatch");
+        }
+    }
+
+    // A bent path in the plane z = 4 must keep every cross line in that plane
+    VolumeF zField(8, 8, 8, 1);
+    for (size_t k = 0; k < zField.data.size(); ++k) {
+        zField.data[k] = static_cast<float>(k / 64) * 0.1f;
+    }
+    rows = Slicing3D::reformatCurved(zField, { { 1, 1, 4 }, { 6, 1, 4 }, { 6, 6, 4 } }, 3, 0.5, true, out);
+    assert(rows > 10);
+    for ([[maybe_unused]] float v : out) {
+        assert(std::abs(v - 0.4f) < 1e-4f && "Planar CPR twisted out of its plane");
+    }
+
+    // Path files: comments, blank lines and commas are accepted, junk is not
+    const std::string pathFile = outDir + "testCurvedPath.txt";
+    {
+        std::ofstream f(pathFile);
+        f << "# centreline\n1 2 3\n\n4.5,5,6\n";
+    }
+    std::vector<Vec3> pts = Slicing3D::loadPath(pathFile);
+    assert(pts.size() == 2 && pts[1].x == 4.5 && pts[1].z == 6.0);
+    {
+        std::ofstream f(pathFile);
+        f << "1 2\n";
+    }
+    [[maybe_unused]] bool threw = false;
+    try {
+        Slicing3D::loadPath(pathFile);
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw && "A line with two values should be rejected");
+    std::remove(pathFile.c_str());
+
+    std::cout << "[PASS] SLICING3D - Curved Reformation" << std::endl;
+}
@@ -47,6 +47,35 @@ public:
      */
     void testOutOfRangeCoordinate();
 
+    /**
+     * Test that an oblique plane with normal +z reproduces the XY slice,
+     * and that the three-point form builds the same plane.
+     */
+    void testObliqueAxisAligned();
+
+    /**
+     * Test oblique trilinear sampling on a linear field (exact up to rounding),
+     * including the edge clamp and the zero fill outside the volume.
+     */
+    void testObliqueTrilinear();
+
+    /**
+     * Test batch export of YZ and strided XZ slices against the single-slice output.
+     */
+    void testExportSlices();
+
+    /**
+     * Test Volume::permuted for every axis order (8-bit, 16-bit and RGB voxels)
+     * against getVoxel, with sizes that mix full and partial transpose tiles.
+     */
+    void testPermuteAxes();
+
+    /**
+     * Test curved planar reformation: a straight path against the exact linear
+     * field, a bent planar path that must not twist out of its plane, and path files.
+     */
+    void testCurvedReformation();
+
 private:
     Volume vol;           ///< A small synthetic volume for testing.
     std::string outDir;   ///< Directory for output test images.
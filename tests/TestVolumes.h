@@ -0,0 +1,24 @@
+#ifndef TEST_VOLUMES_H
+#define TEST_VOLUMES_H
+
+#include "../src/Volume.h"
+#include <type_traits>
+
+// Deterministic pseudo-random volume (LCG), values spread over the type's range;
+// floats lie in [0, 1)
+template <typename T = unsigned char>
+inline BasicVolume<T> noiseVolume(int w, int h, int d, int c, unsigned seed) {
+    BasicVolume<T> vol(w, h, d, c);
+    unsigned state = seed;
+    for (auto& v : vol.data) {
+        state = state * 1664525u + 1013904223u;
+        if constexpr (std::is_floating_point_v<T>) {
+            v = static_cast<T>(state >> 8) / static_cast<T>(1u << 24);
+        } else {
+            v = static_cast<T>(state >> (32 - 8 * sizeof(T)));
+        }
+    }
+    return vol;
+}
+
+#endif // TEST_VOLUMES_H
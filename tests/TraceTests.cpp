@@ -0,0 +1,84 @@
+#include "TraceTests.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+void TraceTests::testDisabledRecordsNothing() {
+    Trace::enable();
+    Trace::disable();
+    {
+        Trace::Scope span("op", "ignored");
+        span.addBytes(10);
+    }
+    if (Trace::enabled() || !Trace::events().empty()) {
+        throw std::runtime_error("Scopes should not be recorded while tracing is off.");
+    }
+}
+
+void TraceTests::testNestedScopes() {
+    Trace::enable();
+    {
+        Trace::Scope outer("op", "outer");
+        outer.addBytes(100);
+        {
+            Trace::Scope inner("io", "inner", "detail");
+            inner.addBytes(5);
+            std::vector<int> work(1 << 16, 1);
+        }
+        // A scope on another thread is its own timeline, outermost there
+        std::thread worker([]() { Trace::Scope span("op", "worker"); });
+        worker.join();
+    }
+    Trace::disable();
+
+    const std::vector<Trace::Event> events = Trace::events();
+    if (events.size() != 3) {
+        throw std::runtime_error("Expected 3 events, got " + std::to_string(events.size()));
+    }
+    const Trace::Event &outer = events[0];
+    const Trace::Event &inner = events[1];
+    const Trace::Event &worker = events[2];
+    if (outer.name != "outer" || outer.category != "op" || outer.depth != 0 || outer.bytes != 100 ||
+        outer.thread != 0) {
+        throw std::runtime_error("The outer scope was recorded wrongly.");
+    }
+    if (inner.name != "inner detail" || inner.category != "io" || inner.depth != 1 || inner.bytes != 5) {
+        throw std::runtime_error("The nested scope was recorded wrongly.");
+    }
+    if (inner.startUs < outer.startUs || inner.startUs + inner.durationUs > outer.startUs + outer.durationUs) {
+        throw std::runtime_error("The nested scope should lie inside its parent.");
+    }
+    if (worker.name != "worker" || worker.depth != 0 || worker.thread == 0) {
+        throw std::runtime_error("A scope on another thread should get its own thread index.");
+    }
+    if (outer.peakRssMB <= 0.0) {
+        throw std::runtime_error("Peak RSS should be measured.");
+    }
+}
+
+void TraceTests::testOutputs() {
+    Trace::enable();
+    {
+        Trace::Scope span("op", "blur", "say \"hi\"");
+        span.addBytes(2000000);
+    }
+    Trace::disable();
+
+    std::ostringstream summary;
+    Trace::writeSummary(summary);
+    if (summary.str().find("blur say \"hi\"") == std::string::npos || summary.str().find("total") == std::string::npos) {
+        throw std::runtime_error("The summary should list each stage and the total.");
+    }
+
+    std::ostringstream chrome;
+    Trace::writeChromeTrace(chrome);
+    const std::string json = chrome.str();
+    if (json.find("\"traceEvents\":[") == std::string::npos || json.find("\"ph\":\"X\"") == std::string::npos ||
+        json.find("\"name\":\"blur say \\\"hi\\\"\"") == std::string::npos ||
+        json.find("\"bytes\":2000000") == std::string::npos) {
+        throw std::runtime_error("Unexpected Chrome trace: " + json);
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef TRACE_TESTS_H
+#define TRACE_TESTS_H
+
+#include "../src/Trace.h"
+#include <iostream>
+#include <cassert>
+
+class TraceTests {
+public:
+    void testDisabledRecordsNothing();
+    void testNestedScopes();
+    void testOutputs();
+};
+
+#endif // TRACE_TESTS_H
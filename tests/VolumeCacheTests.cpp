@@ -0,0 +1,119 @@
+#include "VolumeCacheTests.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+namespace {
+
+// Small 8-bit dataset on disk for the key to fingerprint
+const std::string kFolder = "volumeCacheTest";
+
+void writeSlices(int count, unsigned char base) {
+    mkdir(kFolder.c_str(), 0755);
+    std::vector<unsigned char> plane(10 * 6);
+    for (int z = 0; z < count; ++z) {
+        for (size_t i = 0; i < plane.size(); ++i) {
+            plane[i] = static_cast<unsigned char>(base + z * 7 + i);
+        }
+        writeVoxelPlane(plane.data(), 10, 6, 1, kFolder + "/slice" + std::to_string(10 + z) + ".png",
+                        ImageWriteOptions{});
+    }
+}
+
+} // namespace
+
+void VolumeCacheTests::testRoundTrip() {
+    Volume16 vol(5, 4, 3, 2);
+    for (size_t i = 0; i < vol.data.size(); ++i) {
+        vol.data[i] = static_cast<std::uint16_t>(i * 977);
+    }
+    vol.firstSlice = 4;
+    vol.lastSlice = 6;
+
+    const std::string path = VolumeCache::path("volumeCacheTest/entries", 0x1234abcdull);
+    if (path != "volumeCacheTest/entries/000000001234abcd.apvol") {
+        throw std::runtime_error("Unexpected cache entry path: " + path);
+    }
+    mkdir(kFolder.c_str(), 0755);
+    VolumeCache::save(path, 0x1234abcdull, vol);
+
+    Volume16 back;
+    if (!VolumeCache::load(path, 0x1234abcdull, back)) {
+        throw std::runtime_error("A saved entry should load.");
+    }
+    if (back.width != 5 || back.height != 4 || back.depth != 3 || back.channels != 2 || back.firstSlice != 4 ||
+        back.lastSlice != 6 || back.data != vol.data) {
+        throw std::runtime_error("The loaded volume differs from the saved one.");
+    }
+
+    struct stat sb;
+    if (stat(path.c_str(), &sb) != 0 || sb.st_size != static_cast<off_t>(64 + vol.data.size() * 2)) {
+        throw std::runtime_error("An entry should be a 64-byte header plus the raw voxels.");
+    }
+}
+
+void VolumeCacheTests::testKeyTracksInputs() {
+    writeSlices(4, 20);
+    Volume settings;
+    const std::uint64_t base = VolumeCache::key(kFolder, settings, "blur Gaussian 3 1;");
+    if (VolumeCache::key(kFolder, settings, "blur Gaussian 3 1;") != base) {
+        throw std::runtime_error("The key should be deterministic.");
+    }
+    if (VolumeCache::key(kFolder, settings, "blur Gaussian 5 1;") == base ||
+        VolumeCache::key(kFolder, settings, "") == base) {
+        throw std::runtime_error("The key should change with the preprocessing.");
+    }
+    Volume16 wide;
+    if (VolumeCache::key(kFolder, wide, "blur Gaussian 3 1;") == base) {
+        throw std::runtime_error("The key should change with the voxel type.");
+    }
+    Volume partial;
+    partial.lastSlice = 12;
+    if (VolumeCache::key(kFolder, partial, "blur Gaussian 3 1;") == base) {
+        throw std::runtime_error("The key should change with the slice range.");
+    }
+    writeSlices(5, 20);
+    if (VolumeCache::key(kFolder, settings, "blur Gaussian 3 1;") == base) {
+        throw std::runtime_error("The key should change when a slice is added.");
+    }
+}
+
+void VolumeCacheTests::testRejectsMismatches() {
+    VolumeF vol(3, 3, 2, 1);
+    vol.data.assign(vol.data.size(), 0.25f);
+    const std::string path = kFolder + "/mismatch.apvol";
+    mkdir(kFolder.c_str(), 0755);
+    VolumeCache::save(path, 42, vol);
+
+    VolumeF other;
+    if (VolumeCache::load(path, 43, other)) {
+        throw std::runtime_error("An entry must not load under another key.");
+    }
+    Volume narrow;
+    if (VolumeCache::load(path, 42, narrow)) {
+        throw std::runtime_error("An entry must not load as another voxel type.");
+    }
+    if (VolumeCache::load(kFolder + "/missing.apvol", 42, other)) {
+        throw std::runtime_error("A missing entry is a miss.");
+    }
+
+    // Truncated entries are misses, not errors
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(kFolder + "/truncated.apvol", std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 4));
+    }
+    if (VolumeCache::load(kFolder + "/truncated.apvol", 42, other)) {
+        throw std::runtime_error("A truncated entry must not load.");
+    }
+    if (!VolumeCache::load(path, 42, other) || other.data != vol.data) {
+        throw std::runtime_error("The intact entry should still load.");
+    }
+}
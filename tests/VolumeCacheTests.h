@@ -0,0 +1,15 @@
+#ifndef VOLUME_CACHE_TESTS_H
+#define VOLUME_CACHE_TESTS_H
+
+#include "../src/VolumeCache.h"
+#include <iostream>
+#include <cassert>
+
+class VolumeCacheTests {
+public:
+    void testRoundTrip();
+    void testKeyTracksInputs();
+    void testRejectsMismatches();
+};
+
+#endif // VOLUME_CACHE_TESTS_H
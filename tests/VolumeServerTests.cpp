@@ -0,0 +1,196 @@
+#include "VolumeServerTests.h"
+#include "../src/Image.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const std::string kFolder = "volumeServerTest";
+const std::string kOut = "volumeServerOut";  // outputs kept apart so they are not read as slices
+
+// A 12 x 10 x 6 volume with a bright voxel at (3, 4, 2)
+void writeSlices() {
+    mkdir(kFolder.c_str(), 0755);
+    mkdir(kOut.c_str(), 0755);
+    std::vector<unsigned char> plane(12 * 10);
+    for (int z = 0; z < 6; ++z) {
+        for (size_t i = 0; i < plane.size(); ++i) {
+            plane[i] = static_cast<unsigned char>(10 + z);
+        }
+        if (z == 2) {
+            plane[4 * 12 + 3] = 250;
+        }
+        writeVoxelPlane(plane.data(), 12, 10, 1, kFolder + "/slice" + std::to_string(1 + z) + ".png",
+                        ImageWriteOptions{});
+    }
+}
+
+bool fileExists(const std::string& path) {
+    struct stat sb;
+    return stat(path.c_str(), &sb) == 0 && sb.st_size > 0;
+}
+
+void expectReply(const std::string& reply, const std::string& prefix, const std::string& what) {
+    if (reply.compare(0, prefix.size(), prefix) != 0) {
+        throw std::runtime_error(what + ": expected '" + prefix + "...', got '" + reply + "'");
+    }
+}
+
+} // namespace
+
+void VolumeServerTests::testRequests() {
+    writeSlices();
+    VolumeServer server(2);
+
+    expectReply(server.handle("PING"), "OK pong", "PING");
+    expectReply(server.handle("LOAD v " + kFolder), "OK v 12 10 6 1 uint8", "LOAD");
+    expectReply(server.handle("LOAD w " + kFolder + " float 2 4"), "OK w 12 10 3 1 float", "LOAD with options");
+    expectReply(server.handle("LIST"), "OK v:12x10x6x1:uint8 w:12x10x3x1:float", "LIST");
+    expectReply(server.handle("INFO w"), "OK 12 10 3 1 float", "INFO");
+
+    std::remove((kOut + "/slice.png").c_str());
+    expectReply(server.handle("SLICE v XZ 4 " + kOut + "/slice.png"), "OK", "SLICE");
+    expectReply(server.handle("PROJECT v MIP " + kOut + "/mip.png"), "OK", "PROJECT");
+    expectReply(server.handle("PROJECT v AIP " + kOut + "/aipX.png x"), "OK", "PROJECT along x");
+    expectReply(server.handle("PROJECT w MinIP " + kOut + "/minSlab.png 0 1"), "OK", "PROJECT slab");
+    expectReply(server.handle("RENDER v MIP 30 10 " + kOut + "/render.png 24 20"), "OK", "RENDER");
+    for (const char* out : { "/slice.png", "/mip.png", "/aipX.png", "/minSlab.png", "/render.png" }) {
+        if (!fileExists(kOut + out)) {
+            throw std::runtime_error(std::string("No output written for ") + out);
+        }
+    }
+
+    // A slab along y: rows 0-3 miss the bright voxel at y = 4, rows 4-5 include it
+    expectReply(server.handle("PROJECT v MIP " + kOut + "/mipY.png y 0 3"), "OK", "PROJECT slab along y");
+    const int without = Image((kOut + "/mipY.png").c_str()).getData()[2 * 12 + 3];
+    expectReply(server.handle("PROJECT v MIP " + kOut + "/mipY.png y 4 5"), "OK", "PROJECT slab along y");
+    const int with = Image((kOut + "/mipY.png").c_str()).getData()[2 * 12 + 3];
+    if (without != 12 || with != 250) {
+        throw std::runtime_error("PROJECT along y should project only the requested rows.");
+    }
+    expectReply(server.handle("BLUR v Gaussian 3 1.0"), "OK v", "BLUR");
+
+    // Bad requests are answered, never fatal
+    expectReply(server.handle("SLICE v XY 6 " + kOut + "/bad.png"), "ERR slice index", "slice out of range");
+    expectReply(server.handle("SLICE nope XY 0 " + kOut + "/bad.png"), "ERR no volume named", "unknown volume");
+    expectReply(server.handle("PROJECT v Sum " + kOut + "/bad.png"), "ERR unknown projection", "bad projection");
+    expectReply(server.handle("RENDER v MIP left 0 " + kOut + "/bad.png"), "ERR expected a number", "bad yaw");
+    expectReply(server.handle("LOAD z " + kFolder + "/missing"), "ERR failed to load", "missing folder");
+    // Write failures come back as ERR, not as OK for a file that was never written
+    const std::string unwritable = kOut + "/no/such/dir";
+    expectReply(server.handle("SLICE v XY 3 " + unwritable + "/slice.png"), "ERR", "SLICE to a missing folder");
+    expectReply(server.handle("PROJECT v MIP " + unwritable + "/mip.png"), "ERR", "PROJECT to a missing folder");
+    expectReply(server.handle("RENDER v MIP 0 0 " + unwritable + "/render.png"), "ERR", "RENDER to a missing folder");
+    expectReply(server.handle("FROBNICATE"), "ERR unknown request", "unknown request");
+    expectReply(server.handle("UNLOAD w"), "OK w", "UNLOAD");
+    expectReply(server.handle("INFO w"), "ERR no volume named", "INFO after UNLOAD");
+
+    if (server.stopping()) {
+        throw std::runtime_error("The server should only stop when asked.");
+    }
+    expectReply(server.handle("shutdown"), "OK bye", "SHUTDOWN");
+    if (!server.stopping()) {
+        throw std::runtime_error("SHUTDOWN should stop the server.");
+    }
+}
+
+void VolumeServerTests::testConcurrentReaders() {
+    writeSlices();
+    VolumeServer server(4);
+    expectReply(server.handle("LOAD v " + kFolder), "OK", "LOAD");
+
+    // Readers and a writer on the same volume at once: every request must succeed
+    std::vector<std::string> replies(8);
+    std::vector<std::thread> clients;
+    for (int i = 0; i < 8; ++i) {
+        clients.emplace_back([&, i]() {
+            const std::string out = kOut + "/concurrent" + std::to_string(i) + ".png";
+            replies[i] = (i == 3) ? server.handle("BLUR v Median 3")
+                                  : server.handle("SLICE v XY " + std::to_string(i % 6) + " " + out);
+        });
+    }
+    for (auto& t : clients) {
+        t.join();
+    }
+    for (const auto& reply : replies) {
+        expectReply(reply, "OK", "concurrent request");
+    }
+}
+
+void VolumeServerTests::testSocketSession() {
+    writeSlices();
+    const std::string socketPath = kOut + "/server.sock";
+    VolumeServer server(2);
+    std::thread serving([&]() { server.serve(socketPath); });
+
+    // Wait for the socket to appear, then talk to it like a client would
+    int fd = -1;
+    for (int attempt = 0; attempt < 100 && fd < 0; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    if (fd < 0) {
+        server.handle("SHUTDOWN");
+        serving.join();
+        throw std::runtime_error("Could not connect to the server socket.");
+    }
+
+    const std::string requests = "PING\nLOAD v " + kFolder + "\r\n\nSLICE v YZ 3 " + kOut +
+                                 "/socketSlice.png\nBOGUS\nSHUTDOWN\n";
+    ::send(fd, requests.data(), requests.size(), 0);
+    std::string received;
+    char buffer[512];
+    ssize_t n;
+    while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        received.append(buffer, static_cast<size_t>(n));
+    }
+    ::close(fd);
+    serving.join();
+
+    const std::string expected = "OK pong\nOK v 12 10 6 1 uint8\nOK " + kOut +
+                                 "/socketSlice.png\nERR unknown request 'BOGUS'\nOK bye\n";
+    if (received != expected) {
+        throw std::runtime_error("Unexpected replies over the socket:\n" + received);
+    }
+    struct stat sb;
+    if (stat(socketPath.c_str(), &sb) == 0) {
+        throw std::runtime_error("The socket file should be removed on shutdown.");
+    }
+
+    // A regular file in the way is an error, not something to delete
+    const std::string notSocket = kOut + "/notASocket.txt";
+    {
+        std::ofstream f(notSocket);
+        f << "keep me\n";
+    }
+    bool threw = false;
+    try {
+        server.serve(notSocket);
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    if (!threw || !fileExists(notSocket)) {
+        throw std::runtime_error("serve() should refuse, and keep, a path that is not a socket.");
+    }
+    std::remove(notSocket.c_str());
+}
@@ -0,0 +1,15 @@
+#ifndef VOLUME_SERVER_TESTS_H
+#define VOLUME_SERVER_TESTS_H
+
+#include "../src/VolumeServer.h"
+#include <iostream>
+#include <cassert>
+
+class VolumeServerTests {
+public:
+    void testRequests();
+    void testConcurrentReaders();
+    void testSocketSession();
+};
+
+#endif // VOLUME_SERVER_TESTS_H
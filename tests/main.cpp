@@ -5,6 +5,16 @@
 #include <iostream>
 #include "Filters3DTests.h"
 #include "Slicing3DTests.h"
+#include "ResamplerTests.h"
+#include "PyramidTests.h"
+#include "RayCasterTests.h"
+#include "BrickGridTests.h"
+#include "SlabProjectorTests.h"
+#include "VolumeCacheTests.h"
+#include "VolumeServerTests.h"
+#include "APImageCTests.h"
+#include "TraceTests.h"
+#include "BenchCompareTests.h"
 #include "stb_image.h"
 
 int main() {
@@ -19,6 +29,9 @@ int main() {
     TestRunner::runTest("IMAGE - Get Channels", [&]() { image_tests.testGetChannels(); });
     TestRunner::runTest("IMAGE - Set Data", [&]() { image_tests.testSetData(); });
     TestRunner::runTest("IMAGE - Set Channels", [&]() { image_tests.testSetChannels(); });
+    TestRunner::runTest("IMAGE - Write PNG Round Trip", [&]() { image_tests.testWritePngRoundTrip(); });
+    TestRunner::runTest("IMAGE - Write Formats by Extension", [&]() { image_tests.testWriteFormats(); });
+    TestRunner::runTest("IMAGE - Memory Round Trip", [&]() { image_tests.testMemoryRoundTrip(); });
 
     // Filters2D Tests
     std::cout << "\n========== Filters2D Tests ==========" << std::endl;
@@ -28,11 +41,16 @@ int main() {
     TestRunner::runTest("FILTERS2D - Apply Histogram Equalisation", [&]() { filters2d_tests.testApplyHistogramEqualization(); });
     TestRunner::runTest("FILTERS2D - Apply Threshold", [&]() { filters2d_tests.testThreshold(); });
     TestRunner::runTest("FILTERS2D - Apply Salt and Pepper Noise", [&]() { filters2d_tests.testApplySaltandPepperNoise(); });
+    TestRunner::runTest("FILTERS2D - Seeded Salt and Pepper Noise", [&]() { filters2d_tests.testSaltandPepperNoiseSeeded(); });
     TestRunner::runTest("FILTERS2D - Apply Box Blur", [&]() { filters2d_tests.testBoxBlur(); });
     TestRunner::runTest("FILTERS2D - Apply Gaussian Blur", [&]() { filters2d_tests.testGaussianBlur(); });
     TestRunner::runTest("FILTERS2D - Apply Median Blur", [&]() { filters2d_tests.testMedianBlur(); });
     TestRunner::runTest("FILTERS2D - Apply Sharpen", [&]() { filters2d_tests.testSharpen(); });
+    TestRunner::runTest("FILTERS2D - Sharpen Strength", [&]() { filters2d_tests.testSharpenStrength(); });
+    TestRunner::runTest("FILTERS2D - Unsharp Mask", [&]() { filters2d_tests.testUnsharpMask(); });
     TestRunner::runTest("FILTERS2D - Apply Edge Detection", [&]() { filters2d_tests.testEdgeDetection(); });
+    TestRunner::runTest("FILTERS2D - Edge Detection Magnitude/Orientation", [&]() { filters2d_tests.testEdgeDetectionOptions(); });
+    TestRunner::runTest("FILTERS2D - Canny Edge Detection", [&]() { filters2d_tests.testCannyEdges(); });
 
     // Projections3D Tests
     std::cout << "\n========== Projections3D Tests ==========" << std::endl;
@@ -44,6 +62,12 @@ int main() {
     TestRunner::runTest("PROJECTIONS - MinIP Slab", [&]() { projTests.testMinIPSlab(); });
     TestRunner::runTest("PROJECTIONS - AIP Slab", [&]() { projTests.testAIPSlab(); });
     TestRunner::runTest("PROJECTIONS - AIPMedian", [&]() { projTests.testAIPMedian(); });
+    TestRunner::runTest("PROJECTIONS - AIP 16-bit", [&]() { projTests.testAIP16(); });
+    TestRunner::runTest("PROJECTIONS - 16-bit Slices", [&]() { projTests.test16BitSlices(); });
+    TestRunner::runTest("PROJECTIONS - RGB Volume", [&]() { projTests.testRGBVolume(); });
+    TestRunner::runTest("PROJECTIONS - Along X and Y", [&]() { projTests.testProjectionAxes(); });
+    TestRunner::runTest("PROJECTIONS - Sliding Slab", [&]() { projTests.testSlidingSlab(); });
+    TestRunner::runTest("PROJECTIONS - Brick Skipping", [&]() { projTests.testBrickSkipping(); });
 
     // Filters3D Tests
     std::cout << "\n========== Filters3D Tests ==========" << std::endl;
@@ -52,6 +76,7 @@ int main() {
     TestRunner::runTest("FILTERS3D - Median Blur - Size Preserved", [&]() { filters3d_tests.testMedianBlurSizePreserved(); });
     TestRunner::runTest("FILTERS3D - Apply 3D Gaussian Blur", [&]() { filters3d_tests.testApplyBlur3DGaussian(); });
     TestRunner::runTest("FILTERS3D - Apply 3D Median Blur", [&]() { filters3d_tests.testApplyBlur3DMedian(); });
+    TestRunner::runTest("FILTERS3D - Multi-Channel Median Blur", [&]() { filters3d_tests.testMedianBlurMultiChannel(); });
 
     // Slicing3D Tests
     std::cout << "\n========== Slicing3D Tests ==========" << std::endl;
@@ -61,6 +86,84 @@ int main() {
     TestRunner::runTest("SLICING3D - YZ Plane", [&]() { slicing_tests.testSliceYZ(); });
     TestRunner::runTest("SLICING3D - Expected Error - Invalid Plane", [&]() { slicing_tests.testInvalidPlane(); });
     TestRunner::runTest("SLICING3D - Expected Error - Out of Range Coordinate", [&]() { slicing_tests.testOutOfRangeCoordinate(); });
+    TestRunner::runTest("SLICING3D - Oblique Axis-Aligned", [&]() { slicing_tests.testObliqueAxisAligned(); });
+    TestRunner::runTest("SLICING3D - Oblique Trilinear", [&]() { slicing_tests.testObliqueTrilinear(); });
+    TestRunner::runTest("SLICING3D - Batch Export", [&]() { slicing_tests.testExportSlices(); });
+    TestRunner::runTest("SLICING3D - Permute Axes", [&]() { slicing_tests.testPermuteAxes(); });
+    TestRunner::runTest("SLICING3D - Curved Reformation", [&]() { slicing_tests.testCurvedReformation(); });
+
+    // Resampler Tests
+    std::cout << "\n========== Resampler Tests ==========" << std::endl;
+    ResamplerTests resampler_tests;
+    TestRunner::runTest("RESAMPLER - Uniform Image", [&]() { resampler_tests.testUniformImage(); });
+    TestRunner::runTest("RESAMPLER - Box Downscale", [&]() { resampler_tests.testBoxDownscale(); });
+    TestRunner::runTest("RESAMPLER - Dimensions", [&]() { resampler_tests.testDimensions(); });
+    TestRunner::runTest("RESAMPLER - Volume Planes", [&]() { resampler_tests.testVolumePlanes(); });
+    TestRunner::runTest("RESAMPLER - 16-bit and Float Volumes", [&]() { resampler_tests.testWideVolumes(); });
+    TestRunner::runTest("RESAMPLER - Expected Error - Invalid Arguments", [&]() { resampler_tests.testInvalidArguments(); });
+
+    // Pyramid Tests
+    std::cout << "\n========== Pyramid Tests ==========" << std::endl;
+    PyramidTests pyramid_tests;
+    TestRunner::runTest("PYRAMID - Level Sizes", [&]() { pyramid_tests.testLevelSizes(); });
+    TestRunner::runTest("PYRAMID - Arena Layout", [&]() { pyramid_tests.testArenaLayout(); });
+    TestRunner::runTest("PYRAMID - Uniform Image", [&]() { pyramid_tests.testUniformImage(); });
+    TestRunner::runTest("PYRAMID - Laplacian Collapse", [&]() { pyramid_tests.testLaplacianCollapse(); });
+    TestRunner::runTest("PYRAMID - Copy Level", [&]() { pyramid_tests.testCopyLevel(); });
+
+    // BrickGrid Tests
+    std::cout << "\n========== BrickGrid Tests ==========" << std::endl;
+    BrickGridTests brickgrid_tests;
+    TestRunner::runTest("BRICKGRID - Min/Max with Apron", [&]() { brickgrid_tests.testMinMax(); });
+    TestRunner::runTest("BRICKGRID - Means and Range Queries", [&]() { brickgrid_tests.testMeansAndRange(); });
+    TestRunner::runTest("BRICKGRID - Disk Cache", [&]() { brickgrid_tests.testDiskCache(); });
+
+    std::cout << "\n========== SlabProjector Tests ==========" << std::endl;
+    SlabProjectorTests slab_tests;
+    TestRunner::runTest("SLABPROJECTOR - Scrolling Matches Slabs", [&]() { slab_tests.testScrollingMatchesSlabs(); });
+    TestRunner::runTest("SLABPROJECTOR - Scroll Cost", [&]() { slab_tests.testScrollCost(); });
+    TestRunner::runTest("SLABPROJECTOR - Axes and Voxel Types", [&]() { slab_tests.testAxesAndVoxelTypes(); });
+    TestRunner::runTest("SLABPROJECTOR - Write Matches AIPSlab", [&]() { slab_tests.testWriteMatchesAIPSlab(); });
+    TestRunner::runTest("SLABPROJECTOR - Expected Error - Invalid Projection", [&]() { slab_tests.testInvalidProjection(); });
+
+    std::cout << "\n========== VolumeCache Tests ==========" << std::endl;
+    VolumeCacheTests cache_tests;
+    TestRunner::runTest("VOLUMECACHE - Round Trip", [&]() { cache_tests.testRoundTrip(); });
+    TestRunner::runTest("VOLUMECACHE - Key Tracks Inputs", [&]() { cache_tests.testKeyTracksInputs(); });
+    TestRunner::runTest("VOLUMECACHE - Rejects Mismatches", [&]() { cache_tests.testRejectsMismatches(); });
+
+    std::cout << "\n========== VolumeServer Tests ==========" << std::endl;
+    VolumeServerTests server_tests;
+    TestRunner::runTest("VOLUMESERVER - Requests", [&]() { server_tests.testRequests(); });
+    TestRunner::runTest("VOLUMESERVER - Concurrent Readers", [&]() { server_tests.testConcurrentReaders(); });
+    TestRunner::runTest("VOLUMESERVER - Socket Session", [&]() { server_tests.testSocketSession(); });
+
+    std::cout << "\n========== C API Tests ==========" << std::endl;
+    APImageCTests c_api_tests;
+    TestRunner::runTest("CAPI - Image Filters", [&]() { c_api_tests.testImageFilters(); });
+    TestRunner::runTest("CAPI - Volume Buffers", [&]() { c_api_tests.testVolumeBuffers(); });
+    TestRunner::runTest("CAPI - Errors", [&]() { c_api_tests.testErrors(); });
+    TestRunner::runTest("CAPI - Quiet Volume Load", [&]() { c_api_tests.testQuietLoad(); });
+
+    std::cout << "\n========== Trace Tests ==========" << std::endl;
+    TraceTests trace_tests;
+    TestRunner::runTest("TRACE - Disabled Records Nothing", [&]() { trace_tests.testDisabledRecordsNothing(); });
+    TestRunner::runTest("TRACE - Nested Scopes", [&]() { trace_tests.testNestedScopes(); });
+    TestRunner::runTest("TRACE - Summary and Chrome Trace", [&]() { trace_tests.testOutputs(); });
+
+    std::cout << "\n========== BenchCompare Tests ==========" << std::endl;
+    BenchCompareTests bench_compare_tests;
+    TestRunner::runTest("BENCHCOMPARE - Mann-Whitney U", [&]() { bench_compare_tests.testMannWhitney(); });
+    TestRunner::runTest("BENCHCOMPARE - Verdicts", [&]() { bench_compare_tests.testVerdicts(); });
+    TestRunner::runTest("BENCHCOMPARE - JSON Round Trip", [&]() { bench_compare_tests.testJsonRoundTrip(); });
+
+    // RayCaster Tests
+    std::cout << "\n========== RayCaster Tests ==========" << std::endl;
+    RayCasterTests raycaster_tests;
+    TestRunner::runTest("RAYCASTER - Axis-Aligned MIP/MinIP/AIP", [&]() { raycaster_tests.testAxisAlignedMatchesProjection(); });
+    TestRunner::runTest("RAYCASTER - Empty-Space Skipping Is Exact", [&]() { raycaster_tests.testSkippingIsExact(); });
+    TestRunner::runTest("RAYCASTER - Composite", [&]() { raycaster_tests.testComposite(); });
+    TestRunner::runTest("RAYCASTER - Expected Error - Invalid Volume", [&]() { raycaster_tests.testInvalidVolume(); });
 
     std::cout << "\n========== All Tests Completed ==========" << std::endl;
 